@@ -0,0 +1,362 @@
+// Sample code to train/test the MNIST dataset:
+//   http://yann.lecun.com/exdb/mnist/
+//
+// The model consists of a full-connected 2-layer (input/hidden/output)
+// perceptron with the softmax cross entropy loss.
+// In addition, this example trains the model using synchronous data
+// parallelism on multiple CPU devices:
+//
+// - Each worker thread has its own device and a replica of all parameters.
+// - Each minibatch is split into NUM_WORKERS local minibatches.
+// - Gradients are averaged over all replicas by the ring all-reduce algorithm
+//   before updating parameters. The all-reduce runs on a communication thread
+//   of each worker, and it starts for each bucket of parameters as soon as
+//   their gradients are finished, so that it overlaps with the remaining
+//   backpropagation.
+//
+// Usage:
+//   (set include/lib path correctly to use primitiv)
+//   $ ./download_data.sh
+//   $ g++ -std=c++11 ./mnist_data_parallel.cc -lprimitiv -pthread
+//   $ ./a.out
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <primitiv/primitiv.h>
+
+#include "utils.h"
+
+using namespace primitiv;
+using namespace std;
+namespace F = primitiv::functions;
+namespace I = primitiv::initializers;
+namespace O = primitiv::optimizers;
+
+const unsigned NUM_TRAIN_SAMPLES = 60000;
+const unsigned NUM_TEST_SAMPLES = 10000;
+const unsigned NUM_INPUT_UNITS = 28 * 28;
+const unsigned NUM_HIDDEN_UNITS = 800;
+const unsigned NUM_OUTPUT_UNITS = 10;
+const unsigned NUM_WORKERS = 4;
+const unsigned BATCH_SIZE = 200;
+const unsigned LOCAL_BATCH_SIZE = BATCH_SIZE / NUM_WORKERS;
+const unsigned NUM_TRAIN_BATCHES = NUM_TRAIN_SAMPLES / BATCH_SIZE;
+const unsigned NUM_TEST_BATCHES = NUM_TEST_SAMPLES / BATCH_SIZE;
+const unsigned MAX_EPOCH = 100;
+
+// Minimum number of values in each bucket of gradients. Smaller buckets start
+// the all-reduce earlier, and larger buckets reduce the synchronization cost.
+const unsigned BUCKET_SIZE = 4096;
+
+// Reusable barrier to synchronize all workers.
+class Barrier {
+  mutex mtx_;
+  condition_variable cv_;
+  const unsigned size_;
+  unsigned count_;
+  unsigned generation_;
+
+public:
+  explicit Barrier(unsigned size)
+    : size_(size), count_(0), generation_(0) {}
+
+  void wait() {
+    unique_lock<mutex> lock(mtx_);
+    const unsigned gen = generation_;
+    if (++count_ == size_) {
+      count_ = 0;
+      ++generation_;
+      cv_.notify_all();
+    } else {
+      cv_.wait(lock, [&] { return gen != generation_; });
+    }
+  }
+};
+
+// Device and parameters owned by each worker.
+struct Replica {
+  devices::Naive dev;  // devices::Eigen dev;
+  Parameter pw1, pb1, pw2, pb2;
+  O::SGD optimizer;
+
+  // Chunks of the flattened bucket, exchanged with neighbor replicas during
+  // the ring all-reduce.
+  vector<Tensor> chunks;
+
+  Replica() : optimizer(.1), chunks(NUM_WORKERS) {}
+};
+
+// Performs the ring all-reduce (reduce-scatter + all-gather) of gradients in a
+// bucket. This function should be called by all workers with the
+// corresponding buckets.
+void all_reduce(
+    unsigned rank, const vector<Parameter *> &bucket,
+    vector<unique_ptr<Replica>> &replicas, Barrier &barrier) {
+  Replica &self = *replicas[rank];
+  const Replica &prev = *replicas[(rank + NUM_WORKERS - 1) % NUM_WORKERS];
+
+  // Splits the flattened gradients into NUM_WORKERS chunks.
+  vector<Tensor> grads;
+  for (Parameter *param : bucket) {
+    grads.emplace_back(F::flatten(param->gradient()));
+  }
+  const Tensor flat = F::concat(grads, 0);
+  const unsigned size = flat.shape()[0];
+  for (unsigned c = 0; c < NUM_WORKERS; ++c) {
+    self.chunks[c] = F::slice(
+        flat, 0, size * c / NUM_WORKERS, size * (c + 1) / NUM_WORKERS);
+  }
+  barrier.wait();
+
+  // Reduce-scatter: after this loop, each worker has the sum of the chunk
+  // (rank + 1) over all workers.
+  for (unsigned step = 0; step < NUM_WORKERS - 1; ++step) {
+    const unsigned c = (rank + 2 * NUM_WORKERS - 1 - step) % NUM_WORKERS;
+    self.chunks[c] += F::copy(prev.chunks[c], self.dev);
+    barrier.wait();
+  }
+
+  // All-gather: propagates the reduced chunks along the ring.
+  for (unsigned step = 0; step < NUM_WORKERS - 1; ++step) {
+    const unsigned c = (rank + NUM_WORKERS - step) % NUM_WORKERS;
+    self.chunks[c] = F::copy(prev.chunks[c], self.dev);
+    barrier.wait();
+  }
+
+  // Writes back the averaged gradients.
+  const Tensor reduced = F::concat(self.chunks, 0) * (1.f / NUM_WORKERS);
+  unsigned offset = 0;
+  for (Parameter *param : bucket) {
+    const unsigned n = param->shape().size();
+    param->gradient() = F::reshape(
+        F::slice(reduced, 0, offset, offset + n), param->shape());
+    offset += n;
+  }
+}
+
+// Communication thread of each worker, which processes buckets in the order
+// they were pushed.
+class Communicator {
+  const function<void(const vector<Parameter *> &)> process_;
+  mutex mtx_;
+  condition_variable cv_;
+  deque<vector<Parameter *>> queue_;
+  unsigned num_pending_;
+  bool finished_;
+  thread thread_;
+
+  void run() {
+    while (true) {
+      vector<Parameter *> bucket;
+      {
+        unique_lock<mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return finished_ || !queue_.empty(); });
+        if (queue_.empty()) return;
+        bucket = move(queue_.front());
+        queue_.pop_front();
+      }
+      process_(bucket);
+      {
+        lock_guard<mutex> lock(mtx_);
+        --num_pending_;
+      }
+      cv_.notify_all();
+    }
+  }
+
+public:
+  explicit Communicator(function<void(const vector<Parameter *> &)> process)
+    : process_(process), num_pending_(0), finished_(false)
+    , thread_(&Communicator::run, this) {}
+
+  ~Communicator() {
+    {
+      lock_guard<mutex> lock(mtx_);
+      finished_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  // Enqueues a new bucket.
+  void push(vector<Parameter *> bucket) {
+    {
+      lock_guard<mutex> lock(mtx_);
+      queue_.emplace_back(move(bucket));
+      ++num_pending_;
+    }
+    cv_.notify_all();
+  }
+
+  // Waits until all buckets are processed.
+  void wait() {
+    unique_lock<mutex> lock(mtx_);
+    cv_.wait(lock, [&] { return num_pending_ == 0; });
+  }
+};
+
+// Constructs the predictor network.
+Node make_graph(Replica &r, const vector<float> &inputs, unsigned batch_size) {
+  Node x = F::input<Node>(
+      Shape({NUM_INPUT_UNITS}, batch_size), inputs, r.dev);
+  // NOTE: Parameter nodes are created just before they are used. The
+  // backpropagation visits nodes in the inverse order of their creation, so
+  // the gradients of the output layer are finished (and start to be
+  // all-reduced) before the backpropagation of the hidden layer.
+  Node h = F::relu(
+      F::matmul(F::parameter<Node>(r.pw1), x) + F::parameter<Node>(r.pb1));
+  return F::matmul(F::parameter<Node>(r.pw2), h) + F::parameter<Node>(r.pb2);
+}
+
+int main() {
+  // Loads data
+  vector<float> train_inputs = utils::load_mnist_images(
+      "data/train-images-idx3-ubyte", NUM_TRAIN_SAMPLES);
+  vector<char> train_labels = utils::load_mnist_labels(
+      "data/train-labels-idx1-ubyte", NUM_TRAIN_SAMPLES);
+  vector<float> test_inputs = utils::load_mnist_images(
+      "data/t10k-images-idx3-ubyte", NUM_TEST_SAMPLES);
+  vector<char> test_labels = utils::load_mnist_labels(
+      "data/t10k-labels-idx1-ubyte", NUM_TEST_SAMPLES);
+
+  // Initializes replicas. All replicas start from the same values.
+  vector<unique_ptr<Replica>> replicas;
+  for (unsigned w = 0; w < NUM_WORKERS; ++w) {
+    replicas.emplace_back(new Replica());
+    Replica &r = *replicas.back();
+    if (w == 0) {
+      r.pw1.init({NUM_HIDDEN_UNITS, NUM_INPUT_UNITS}, I::XavierUniform(), r.dev);
+      r.pb1.init({NUM_HIDDEN_UNITS}, I::Constant(0), r.dev);
+      r.pw2.init({NUM_OUTPUT_UNITS, NUM_HIDDEN_UNITS}, I::XavierUniform(), r.dev);
+      r.pb2.init({NUM_OUTPUT_UNITS}, I::Constant(0), r.dev);
+    } else {
+      const Replica &r0 = *replicas[0];
+      r.pw1.init(r0.pw1.shape(), r0.pw1.value().to_vector(), r.dev);
+      r.pb1.init(r0.pb1.shape(), r0.pb1.value().to_vector(), r.dev);
+      r.pw2.init(r0.pw2.shape(), r0.pw2.value().to_vector(), r.dev);
+      r.pb2.init(r0.pb2.shape(), r0.pb2.value().to_vector(), r.dev);
+    }
+    r.optimizer.add(r.pw1, r.pb1, r.pw2, r.pb2);
+  }
+
+  // Communication threads.
+  Barrier barrier(NUM_WORKERS);
+  vector<unique_ptr<Communicator>> comms;
+  for (unsigned w = 0; w < NUM_WORKERS; ++w) {
+    comms.emplace_back(new Communicator(
+          [&, w](const vector<Parameter *> &bucket) {
+            all_reduce(w, bucket, replicas, barrier);
+          }));
+  }
+
+  // Batch randomizer
+  mt19937 rng;
+  vector<unsigned> ids(NUM_TRAIN_SAMPLES);
+  iota(begin(ids), end(ids), 0);
+
+  for (unsigned epoch = 0; epoch < MAX_EPOCH; ++epoch) {
+    // Shuffles sample IDs.
+    shuffle(begin(ids), end(ids), rng);
+
+    // Training loop on each worker.
+    auto train = [&](unsigned w) {
+      Replica &r = *replicas[w];
+      Communicator &comm = *comms[w];
+      Device::set_default(r.dev);
+      Graph g;
+      Graph::set_default(g);
+
+      for (unsigned batch = 0; batch < NUM_TRAIN_BATCHES; ++batch) {
+        // Makes a local minibatch for training.
+        vector<float> inputs(LOCAL_BATCH_SIZE * NUM_INPUT_UNITS);
+        vector<unsigned> labels(LOCAL_BATCH_SIZE);
+        for (unsigned i = 0; i < LOCAL_BATCH_SIZE; ++i) {
+          const unsigned id =
+            ids[i + w * LOCAL_BATCH_SIZE + batch * BATCH_SIZE];
+          copy(&train_inputs[id * NUM_INPUT_UNITS],
+               &train_inputs[(id + 1) * NUM_INPUT_UNITS],
+               &inputs[i * NUM_INPUT_UNITS]);
+          labels[i] = train_labels[id];
+        }
+
+        // Constructs the graph.
+        g.clear();
+        Node y = make_graph(r, inputs, LOCAL_BATCH_SIZE);
+        Node loss = F::softmax_cross_entropy(y, labels, 0);
+        Node avg_loss = F::batch::mean(loss);
+
+        // Backpropagation and bucketed all-reduce of gradients.
+        r.optimizer.reset_gradients();
+        vector<Parameter *> bucket;
+        unsigned bucket_size = 0;
+        g.backward(avg_loss, [&](Parameter &param) {
+            bucket.emplace_back(&param);
+            bucket_size += param.shape().size();
+            if (bucket_size >= BUCKET_SIZE) {
+              comm.push(move(bucket));
+              bucket.clear();
+              bucket_size = 0;
+            }
+        });
+        if (!bucket.empty()) comm.push(move(bucket));
+        comm.wait();
+
+        // All replicas apply the same update.
+        r.optimizer.update();
+      }
+    };
+
+    vector<thread> workers;
+    for (unsigned w = 0; w < NUM_WORKERS; ++w) {
+      workers.emplace_back(train, w);
+    }
+    for (thread &th : workers) th.join();
+
+    unsigned match = 0;
+
+    // Test loop on the first replica.
+    Replica &r0 = *replicas[0];
+    Graph g;
+    Graph::set_default(g);
+    for (unsigned batch = 0; batch < NUM_TEST_BATCHES; ++batch) {
+      // Makes a test minibatch.
+      vector<float> inputs(BATCH_SIZE * NUM_INPUT_UNITS);
+      copy(&test_inputs[batch * BATCH_SIZE * NUM_INPUT_UNITS],
+           &test_inputs[(batch + 1) * BATCH_SIZE * NUM_INPUT_UNITS],
+           &inputs[0]);
+
+      // Constructs the graph.
+      g.clear();
+      Node y = make_graph(r0, inputs, BATCH_SIZE);
+
+      // Gets outputs, argmax, and compares them with the label.
+      vector<float> y_val = y.to_vector();
+      for (unsigned i = 0; i < BATCH_SIZE; ++i) {
+        float maxval = -1e10;
+        int argmax = -1;
+        for (unsigned j = 0; j < NUM_OUTPUT_UNITS; ++j) {
+          float v = y_val[j + i * NUM_OUTPUT_UNITS];
+          if (v > maxval) maxval = v, argmax = static_cast<int>(j);
+        }
+        if (argmax == test_labels[i + batch * BATCH_SIZE]) ++match;
+      }
+    }
+
+    const float accuracy = 100.0 * match / NUM_TEST_SAMPLES;
+    printf("epoch %d: accuracy: %.2f%%\n", epoch, accuracy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+// Sample code to train/test the MNIST dataset:
+//   http://yann.lecun.com/exdb/mnist/
+//
+// The model consists of a full-connected 2-layer (input/hidden/output)
+// perceptron with the softmax cross entropy loss.
+// In addition, this example trains the model using asynchronous SGD without
+// locking (Hogwild!):
+//
+// - All worker threads share the same parameters on the same device.
+// - Each worker thread has its own Graph, Optimizer and LocalGradients, and
+//   updates the shared parameters independently using its own minibatches.
+//
+// Usage:
+//   (set include/lib path correctly to use primitiv)
+//   $ ./download_data.sh
+//   $ g++ -std=c++11 ./mnist_hogwild.cc -lprimitiv -pthread
+//   $ ./a.out
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <primitiv/primitiv.h>
+
+#include "utils.h"
+
+using namespace primitiv;
+using namespace std;
+namespace F = primitiv::functions;
+namespace I = primitiv::initializers;
+namespace O = primitiv::optimizers;
+
+const unsigned NUM_TRAIN_SAMPLES = 60000;
+const unsigned NUM_TEST_SAMPLES = 10000;
+const unsigned NUM_INPUT_UNITS = 28 * 28;
+const unsigned NUM_HIDDEN_UNITS = 800;
+const unsigned NUM_OUTPUT_UNITS = 10;
+const unsigned NUM_WORKERS = 4;
+const unsigned BATCH_SIZE = 50;
+const unsigned NUM_TRAIN_BATCHES = NUM_TRAIN_SAMPLES / BATCH_SIZE;
+const unsigned NUM_TEST_BATCHES = NUM_TEST_SAMPLES / BATCH_SIZE;
+const unsigned MAX_EPOCH = 100;
+
+int main() {
+  // Loads data
+  vector<float> train_inputs = utils::load_mnist_images(
+      "data/train-images-idx3-ubyte", NUM_TRAIN_SAMPLES);
+  vector<char> train_labels = utils::load_mnist_labels(
+      "data/train-labels-idx1-ubyte", NUM_TRAIN_SAMPLES);
+  vector<float> test_inputs = utils::load_mnist_images(
+      "data/t10k-images-idx3-ubyte", NUM_TEST_SAMPLES);
+  vector<char> test_labels = utils::load_mnist_labels(
+      "data/t10k-labels-idx1-ubyte", NUM_TEST_SAMPLES);
+
+  // The device is shared by all threads.
+  devices::Naive dev;  //devices::Eigen dev;
+
+  // Parameters shared by all threads.
+  Parameter pw1({NUM_HIDDEN_UNITS, NUM_INPUT_UNITS}, I::XavierUniform(), dev);
+  Parameter pb1({NUM_HIDDEN_UNITS}, I::Constant(0), dev);
+  Parameter pw2({NUM_OUTPUT_UNITS, NUM_HIDDEN_UNITS}, I::XavierUniform(), dev);
+  Parameter pb2({NUM_OUTPUT_UNITS}, I::Constant(0), dev);
+
+  // Optimizers of each thread.
+  // NOTE: Optimizer::add() may modify parameters to add statistics, and
+  //       should be called before launching threads.
+  vector<unique_ptr<O::SGD>> optimizers;
+  for (unsigned w = 0; w < NUM_WORKERS; ++w) {
+    optimizers.emplace_back(new O::SGD(.1));
+    optimizers.back()->add(pw1, pb1, pw2, pb2);
+  }
+
+  // Helper lambda to construct the predictor network.
+  auto make_graph = [&](const vector<float> &inputs, unsigned batch_size) {
+    Node x = F::input<Node>(Shape({NUM_INPUT_UNITS}, batch_size), inputs);
+    Node w1 = F::parameter<Node>(pw1);
+    Node b1 = F::parameter<Node>(pb1);
+    Node h = F::relu(F::matmul(w1, x) + b1);
+    Node w2 = F::parameter<Node>(pw2);
+    Node b2 = F::parameter<Node>(pb2);
+    return F::matmul(w2, h) + b2;
+  };
+
+  // Batch randomizer
+  mt19937 rng;
+  vector<unsigned> ids(NUM_TRAIN_SAMPLES);
+  iota(begin(ids), end(ids), 0);
+
+  for (unsigned epoch = 0; epoch < MAX_EPOCH; ++epoch) {
+    // Shuffles sample IDs.
+    shuffle(begin(ids), end(ids), rng);
+
+    // Training loop on each worker. Minibatches are assigned to workers in
+    // the round-robin manner.
+    auto train = [&](unsigned w) {
+      Device::set_default(dev);
+      Graph g;
+      Graph::set_default(g);
+
+      // Gradients calculated in this thread are stored in `lg` instead of the
+      // shared Parameter objects.
+      LocalGradients lg;
+      lg.add(pw1);
+      lg.add(pb1);
+      lg.add(pw2);
+      lg.add(pb2);
+
+      O::SGD &optimizer = *optimizers[w];
+
+      for (unsigned batch = w; batch < NUM_TRAIN_BATCHES;
+           batch += NUM_WORKERS) {
+        // Makes a minibatch for training.
+        vector<float> inputs(BATCH_SIZE * NUM_INPUT_UNITS);
+        vector<unsigned> labels(BATCH_SIZE);
+        for (unsigned i = 0; i < BATCH_SIZE; ++i) {
+          const unsigned id = ids[i + batch * BATCH_SIZE];
+          copy(&train_inputs[id * NUM_INPUT_UNITS],
+               &train_inputs[(id + 1) * NUM_INPUT_UNITS],
+               &inputs[i * NUM_INPUT_UNITS]);
+          labels[i] = train_labels[id];
+        }
+
+        // Constructs the graph.
+        g.clear();
+        Node y = make_graph(inputs, BATCH_SIZE);
+        Node loss = F::softmax_cross_entropy(y, labels, 0);
+        Node avg_loss = F::batch::mean(loss);
+
+        // Implicit forward, backward, and updates the shared parameters
+        // without locking.
+        optimizer.reset_gradients();
+        avg_loss.backward();
+        optimizer.update();
+      }
+    };
+
+    vector<thread> workers;
+    for (unsigned w = 0; w < NUM_WORKERS; ++w) {
+      workers.emplace_back(train, w);
+    }
+    for (thread &th : workers) th.join();
+
+    unsigned match = 0;
+
+    // Test loop
+    Device::set_default(dev);
+    Graph g;
+    Graph::set_default(g);
+    for (unsigned batch = 0; batch < NUM_TEST_BATCHES; ++batch) {
+      // Makes a test minibatch.
+      vector<float> inputs(BATCH_SIZE * NUM_INPUT_UNITS);
+      copy(&test_inputs[batch * BATCH_SIZE * NUM_INPUT_UNITS],
+           &test_inputs[(batch + 1) * BATCH_SIZE * NUM_INPUT_UNITS],
+           &inputs[0]);
+
+      // Constructs the graph.
+      g.clear();
+      Node y = make_graph(inputs, BATCH_SIZE);
+
+      // Gets outputs, argmax, and compares them with the label.
+      vector<float> y_val = y.to_vector();
+      for (unsigned i = 0; i < BATCH_SIZE; ++i) {
+        float maxval = -1e10;
+        int argmax = -1;
+        for (unsigned j = 0; j < NUM_OUTPUT_UNITS; ++j) {
+          float v = y_val[j + i * NUM_OUTPUT_UNITS];
+          if (v > maxval) maxval = v, argmax = static_cast<int>(j);
+        }
+        if (argmax == test_labels[i + batch * BATCH_SIZE]) ++match;
+      }
+    }
+
+    const float accuracy = 100.0 * match / NUM_TEST_SAMPLES;
+    printf("epoch %d: accuracy: %.2f%%\n", epoch, accuracy);
+  }
+
+  return 0;
+}
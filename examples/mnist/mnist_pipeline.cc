@@ -0,0 +1,300 @@
+// Sample code to train/test the MNIST dataset:
+//   http://yann.lecun.com/exdb/mnist/
+//
+// The model consists of a full-connected 2-layer (input/hidden/output)
+// perceptron with the softmax cross entropy loss.
+// In addition, this example trains the model using pipeline parallelism on
+// multiple CPU devices:
+//
+// - The model is split into NUM_STAGES stages, and each stage is placed on its
+//   own device and worker thread. On Linux, each worker is bound to a disjoint
+//   set of CPU cores.
+// - Each minibatch is split into NUM_MICRO_BATCHES micro-batches. Activations
+//   are sent to the next stage and gradients are sent back to the previous
+//   stage through channels, so that stage k of a micro-batch overlaps with
+//   other stages of the neighboring micro-batches.
+// - Each stage runs the one-forward-one-backward (1F1B) schedule: after a few
+//   warm-up forward steps, forward and backward steps are interleaved so that
+//   only a small number of micro-batches keep their activations at once.
+// - Gradients are accumulated over all micro-batches, and each stage updates
+//   its own parameters at the end of the minibatch.
+//
+// Usage:
+//   (set include/lib path correctly to use primitiv)
+//   $ ./download_data.sh
+//   $ g++ -std=c++11 ./mnist_pipeline.cc -lprimitiv -pthread
+//   $ ./a.out
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+
+#include <primitiv/primitiv.h>
+
+#include "utils.h"
+
+using namespace primitiv;
+using namespace std;
+namespace F = primitiv::functions;
+namespace I = primitiv::initializers;
+namespace O = primitiv::optimizers;
+
+const unsigned NUM_TRAIN_SAMPLES = 60000;
+const unsigned NUM_TEST_SAMPLES = 10000;
+const unsigned NUM_INPUT_UNITS = 28 * 28;
+const unsigned NUM_HIDDEN_UNITS = 800;
+const unsigned NUM_OUTPUT_UNITS = 10;
+const unsigned NUM_STAGES = 2;
+const unsigned NUM_MICRO_BATCHES = 4;
+const unsigned BATCH_SIZE = 200;
+const unsigned MICRO_BATCH_SIZE = BATCH_SIZE / NUM_MICRO_BATCHES;
+const unsigned NUM_TRAIN_BATCHES = NUM_TRAIN_SAMPLES / BATCH_SIZE;
+const unsigned NUM_TEST_BATCHES = NUM_TEST_SAMPLES / BATCH_SIZE;
+const unsigned MAX_EPOCH = 100;
+
+// Blocking FIFO queue to pass tensors between stages.
+class Channel {
+  mutex mtx_;
+  condition_variable cv_;
+  deque<Tensor> queue_;
+
+public:
+  void send(const Tensor &x) {
+    {
+      lock_guard<mutex> lock(mtx_);
+      queue_.emplace_back(x);
+    }
+    cv_.notify_one();
+  }
+
+  Tensor receive() {
+    unique_lock<mutex> lock(mtx_);
+    cv_.wait(lock, [&] { return !queue_.empty(); });
+    Tensor x = std::move(queue_.front());
+    queue_.pop_front();
+    return x;
+  }
+};
+
+// Binds the calling thread to the stage-th subset of the CPU cores.
+void bind_cores(unsigned stage) {
+#ifdef __linux__
+  const unsigned num_cores = thread::hardware_concurrency();
+  if (num_cores < NUM_STAGES) return;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (unsigned c = stage * num_cores / NUM_STAGES;
+       c < (stage + 1) * num_cores / NUM_STAGES; ++c) {
+    CPU_SET(c, &cpus);
+  }
+  ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus);
+#else
+  static_cast<void>(stage);
+#endif  // __linux__
+}
+
+int main() {
+  static_assert(NUM_STAGES == 2, "This example splits the model into 2 stages.");
+
+  // Loads data
+  vector<float> train_inputs = utils::load_mnist_images(
+      "data/train-images-idx3-ubyte", NUM_TRAIN_SAMPLES);
+  vector<char> train_labels = utils::load_mnist_labels(
+      "data/train-labels-idx1-ubyte", NUM_TRAIN_SAMPLES);
+  vector<float> test_inputs = utils::load_mnist_images(
+      "data/t10k-images-idx3-ubyte", NUM_TEST_SAMPLES);
+  vector<char> test_labels = utils::load_mnist_labels(
+      "data/t10k-labels-idx1-ubyte", NUM_TEST_SAMPLES);
+
+  // Devices of each stage.
+  devices::Naive dev0;  //devices::Eigen dev0;
+  devices::Naive dev1;  //devices::Eigen dev1;
+  Device *devs[NUM_STAGES] {&dev0, &dev1};
+
+  // Parameters of the 1st stage (hidden layer).
+  Parameter pw1({NUM_HIDDEN_UNITS, NUM_INPUT_UNITS}, I::XavierUniform(), dev0);
+  Parameter pb1({NUM_HIDDEN_UNITS}, I::Constant(0), dev0);
+
+  // Parameters of the 2nd stage (output layer).
+  Parameter pw2({NUM_OUTPUT_UNITS, NUM_HIDDEN_UNITS}, I::XavierUniform(), dev1);
+  Parameter pb2({NUM_OUTPUT_UNITS}, I::Constant(0), dev1);
+
+  // Optimizers of each stage.
+  O::SGD optimizer0(.5), optimizer1(.5);
+  optimizer0.add(pw1, pb1);
+  optimizer1.add(pw2, pb2);
+  Optimizer *optimizers[NUM_STAGES] {&optimizer0, &optimizer1};
+
+  // Computation of each stage.
+  auto stage0 = [&](const Node &x) {
+    Node w1 = F::parameter<Node>(pw1);
+    Node b1 = F::parameter<Node>(pb1);
+    return F::relu(F::matmul(w1, x) + b1);
+  };
+  auto stage1 = [&](const Node &h) {
+    Node w2 = F::parameter<Node>(pw2);
+    Node b2 = F::parameter<Node>(pb2);
+    return F::matmul(w2, h) + b2;
+  };
+
+  // Batch randomizer
+  mt19937 rng;
+  vector<unsigned> ids(NUM_TRAIN_SAMPLES);
+  iota(begin(ids), end(ids), 0);
+
+  for (unsigned epoch = 0; epoch < MAX_EPOCH; ++epoch) {
+    // Shuffles sample IDs.
+    shuffle(begin(ids), end(ids), rng);
+
+    // activations[k]: stage k -> stage k + 1
+    // gradients[k]: stage k + 1 -> stage k
+    Channel activations[NUM_STAGES - 1];
+    Channel gradients[NUM_STAGES - 1];
+
+    // Training loop on each stage.
+    auto train = [&](unsigned k) {
+      bind_cores(k);
+      Device::set_default(*devs[k]);
+      Optimizer &optimizer = *optimizers[k];
+
+      // Each micro-batch has its own graph, which holds the activations
+      // between the forward and backward steps.
+      vector<unique_ptr<Graph>> graphs;
+      for (unsigned m = 0; m < NUM_MICRO_BATCHES; ++m) {
+        graphs.emplace_back(new Graph());
+      }
+      vector<Node> inputs(NUM_MICRO_BATCHES), outputs(NUM_MICRO_BATCHES);
+
+      // Number of the warm-up forward steps.
+      const unsigned num_warmups = min(NUM_STAGES - k - 1, NUM_MICRO_BATCHES);
+
+      for (unsigned batch = 0; batch < NUM_TRAIN_BATCHES; ++batch) {
+        auto forward = [&](unsigned m) {
+          Graph &g = *graphs[m];
+          Graph::set_default(g);
+          g.clear();
+          const unsigned offset = batch * BATCH_SIZE + m * MICRO_BATCH_SIZE;
+
+          if (k == 0) {
+            // Makes a micro-batch for training.
+            vector<float> x(MICRO_BATCH_SIZE * NUM_INPUT_UNITS);
+            for (unsigned i = 0; i < MICRO_BATCH_SIZE; ++i) {
+              const unsigned id = ids[offset + i];
+              copy(&train_inputs[id * NUM_INPUT_UNITS],
+                   &train_inputs[(id + 1) * NUM_INPUT_UNITS],
+                   &x[i * NUM_INPUT_UNITS]);
+            }
+            inputs[m] = F::input<Node>(
+                Shape({NUM_INPUT_UNITS}, MICRO_BATCH_SIZE), x);
+            outputs[m] = stage0(inputs[m]);
+
+            // Sends activations to the next stage.
+            activations[k].send(g.forward(outputs[m]));
+          } else {
+            // Receives activations from the previous stage.
+            const Tensor h = activations[k - 1].receive();
+            inputs[m] = F::input<Node>(h.shape(), h.to_vector());
+            g.retain_gradient(inputs[m]);
+
+            vector<unsigned> labels(MICRO_BATCH_SIZE);
+            for (unsigned i = 0; i < MICRO_BATCH_SIZE; ++i) {
+              labels[i] = train_labels[ids[offset + i]];
+            }
+            Node y = stage1(inputs[m]);
+            Node loss = F::softmax_cross_entropy(y, labels, 0);
+
+            // Average over the whole minibatch.
+            outputs[m] = F::batch::sum(loss) / BATCH_SIZE;
+            g.forward(outputs[m]);
+          }
+        };
+
+        auto backward = [&](unsigned m) {
+          Graph &g = *graphs[m];
+          if (k == NUM_STAGES - 1) {
+            g.backward(outputs[m]);
+          } else {
+            // Receives gradients from the next stage.
+            const Tensor gy = gradients[k].receive();
+            g.backward(outputs[m], F::copy(gy, *devs[k]));
+          }
+          if (k > 0) {
+            // Sends gradients to the previous stage.
+            gradients[k - 1].send(g.get_gradient(inputs[m]));
+          }
+        };
+
+        // 1F1B schedule.
+        optimizer.reset_gradients();
+        for (unsigned m = 0; m < num_warmups; ++m) {
+          forward(m);
+        }
+        for (unsigned m = num_warmups; m < NUM_MICRO_BATCHES; ++m) {
+          forward(m);
+          backward(m - num_warmups);
+        }
+        for (unsigned m = NUM_MICRO_BATCHES - num_warmups;
+             m < NUM_MICRO_BATCHES; ++m) {
+          backward(m);
+        }
+        optimizer.update();
+      }
+    };
+
+    vector<thread> workers;
+    for (unsigned k = 0; k < NUM_STAGES; ++k) {
+      workers.emplace_back(train, k);
+    }
+    for (thread &th : workers) th.join();
+
+    unsigned match = 0;
+
+    // Test loop
+    Device::set_default(dev0);
+    Graph g;
+    Graph::set_default(g);
+    for (unsigned batch = 0; batch < NUM_TEST_BATCHES; ++batch) {
+      // Makes a test minibatch.
+      vector<float> inputs(BATCH_SIZE * NUM_INPUT_UNITS);
+      copy(&test_inputs[batch * BATCH_SIZE * NUM_INPUT_UNITS],
+           &test_inputs[(batch + 1) * BATCH_SIZE * NUM_INPUT_UNITS],
+           &inputs[0]);
+
+      // Constructs the graph across all stages.
+      g.clear();
+      Node x = F::input<Node>(Shape({NUM_INPUT_UNITS}, BATCH_SIZE), inputs);
+      Node y = stage1(F::copy(stage0(x), dev1));
+
+      // Gets outputs, argmax, and compares them with the label.
+      vector<float> y_val = y.to_vector();
+      for (unsigned i = 0; i < BATCH_SIZE; ++i) {
+        float maxval = -1e10;
+        int argmax = -1;
+        for (unsigned j = 0; j < NUM_OUTPUT_UNITS; ++j) {
+          float v = y_val[j + i * NUM_OUTPUT_UNITS];
+          if (v > maxval) maxval = v, argmax = static_cast<int>(j);
+        }
+        if (argmax == test_labels[i + batch * BATCH_SIZE]) ++match;
+      }
+    }
+
+    const float accuracy = 100.0 * match / NUM_TEST_SAMPLES;
+    printf("epoch %d: accuracy: %.2f%%\n", epoch, accuracy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,29 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <primitiv/arena.h>
+
+namespace primitiv {
+
+std::size_t Arena::capacity() const {
+  std::size_t total = 0;
+  for (const Block &block : blocks_) total += block.size;
+  return total;
+}
+
+void *Arena::allocate_new_block(std::size_t size, std::size_t align) {
+  // Blocks skipped here are reused after the next `reset()`.
+  const std::size_t required = size + align - 1;
+  while (next_ < blocks_.size() && blocks_[next_].size < required) ++next_;
+  if (next_ == blocks_.size()) {
+    const std::size_t block_size = std::max(block_size_, required);
+    blocks_.emplace_back(
+        Block { std::unique_ptr<char[]>(new char[block_size]), block_size });
+  }
+  Block &block = blocks_[next_++];
+  ptr_ = block.data.get();
+  end_ = ptr_ + block.size;
+  return allocate(size, align);
+}
+
+}  // namespace primitiv
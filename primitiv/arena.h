@@ -0,0 +1,99 @@
+#ifndef PRIMITIV_ARENA_H_
+#define PRIMITIV_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <primitiv/mixins.h>
+
+namespace primitiv {
+
+/**
+ * Bump-pointer allocator which releases all allocated memories at once.
+ * @remarks The arena never calls destructors of objects constructed in its
+ *          memory. Owners of such objects should destroy them before calling
+ *          `reset()` or destroying the arena.
+ */
+class Arena : mixins::Nonmovable<Arena> {
+  /**
+   * Memory block owned by the arena.
+   */
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+public:
+  /**
+   * Creates a new Arena object.
+   * @param block_size Default size of each memory block in bytes. Larger
+   *                   blocks are allocated for larger requests.
+   */
+  explicit Arena(std::size_t block_size = 1 << 16)
+    : block_size_(block_size), blocks_(), next_(0)
+    , ptr_(nullptr), end_(nullptr) {}
+
+  /**
+   * Allocates a memory.
+   * @param size Size of the memory in bytes.
+   * @param align Alignment of the memory in bytes, which should be a power of
+   *              2.
+   * @return Pointer to the new memory, which is available until `reset()`.
+   */
+  void *allocate(std::size_t size, std::size_t align) {
+    const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(ptr_);
+    const std::uintptr_t e = reinterpret_cast<std::uintptr_t>(end_);
+    const std::uintptr_t aligned = (p + align - 1) & ~(align - 1);
+    if (ptr_ && aligned <= e && size <= e - aligned) {
+      ptr_ = reinterpret_cast<char *>(aligned + size);
+      return reinterpret_cast<void *>(aligned);
+    }
+    return allocate_new_block(size, align);
+  }
+
+  /**
+   * Allocates an uninitialized array.
+   * @param n Number of elements.
+   * @return Pointer to the first element.
+   */
+  template<typename T>
+  T *allocate_array(std::size_t n) {
+    return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * Releases all allocated memories at once.
+   * @remarks Memory blocks are kept and reused by following allocations.
+   */
+  void reset() {
+    next_ = 0;
+    ptr_ = end_ = nullptr;
+  }
+
+  /**
+   * Returns the total size of memory blocks held by the arena.
+   * @return Number of bytes.
+   */
+  std::size_t capacity() const;
+
+private:
+  /**
+   * Moves to the next memory block which has enough space, and allocates a
+   * memory in it.
+   * @param size Size of the memory in bytes.
+   * @param align Alignment of the memory in bytes.
+   * @return Pointer to the new memory.
+   */
+  void *allocate_new_block(std::size_t size, std::size_t align);
+
+  std::size_t block_size_;
+  std::vector<Block> blocks_;
+  std::size_t next_;
+  char *ptr_;
+  char *end_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_ARENA_H_
@@ -272,6 +272,201 @@ inline type_traits::Identity<Var> input(
   return input<Var>(shape, data, nullptr);
 }
 
+/**
+ * Creates a new Tensor from specific shape and data.
+ * @param shape Shape of the new Tensor.
+ * @param data Inner data of the new Tensor. `data.size()` should be equal to
+ *        `shape.size()` and each data is ordered by the column-major order.
+ *        The content of this object is moved to the new Tensor.
+ * @param dev Device to manage inner data of the Tensor, or `nullptr` to use the
+ *            default device.
+ * @return A new Tensor.
+ * @remarks CPU devices use the memory of `data` without copying.
+ */
+Tensor input_tensor(
+    const Shape &shape, std::vector<float> &&data, Device *dev);
+
+/**
+ * Creates a new Node from specific shape and data.
+ * @param shape Shape of the new Node.
+ * @param data Inner data of the new Node. `data.size()` should be equal to
+ *             `shape.size()` and each data is ordered by the column-major
+ *             order. The content of this object is moved to the new Node.
+ * @param dev Device to manage inner data of the Node, or `nullptr` to use the
+ *            default device.
+ * @param g Graph to manage the instance of the Node, or `nullptr` to use the
+ *          default graph.
+ * @return A new Node.
+ * @remarks CPU devices use the memory of `data` without copying.
+ */
+Node input_node(
+    const Shape &shape, std::vector<float> &&data, Device *dev, Graph *g);
+
+/**
+ * Creates a new variable from specific shape and data.
+ * @param shape Shape of the new variable.
+ * @param data Inner data of the new variable. `data.size()` should be equal to
+ *             `shape.size()` and each data is ordered by the column-major
+ *             order. The content of this object is moved to the new variable.
+ * @param dev Device to manage inner data of the variable, or `nullptr` to use
+ *            the default device.
+ * @return A new variable.
+ * @remarks CPU devices use the memory of `data` without copying.
+ *          This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+type_traits::Identity<Var> input(
+    const Shape &shape, std::vector<float> &&data, Device *dev);
+
+/// @cond
+
+template<>
+inline Tensor input<Tensor>(
+    const Shape &shape, std::vector<float> &&data, Device *dev) {
+  return input_tensor(shape, std::move(data), dev);
+}
+
+template<>
+inline Node input<Node>(
+    const Shape &shape, std::vector<float> &&data, Device *dev) {
+  return input_node(shape, std::move(data), dev, nullptr);
+}
+
+/// @endcond
+
+/**
+ * Creates a new variable from specific shape and data.
+ * @param shape Shape of the new variable.
+ * @param data Inner data of the new variable. `data.size()` should be equal to
+ *        `shape.size()` and each data is ordered by the column-major order.
+ *        The content of this object is moved to the new variable.
+ * @param dev Device to manage inner data of the variable.
+ * @return A new variable.
+ * @remarks This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> input(
+    const Shape &shape, std::vector<float> &&data, Device &dev) {
+  return input<Var>(shape, std::move(data), &dev);
+}
+
+/**
+ * Creates a new variable from specific shape and data.
+ * @param shape Shape of the new variable.
+ * @param data Inner data of the new variable. `data.size()` should be equal to
+ *        `shape.size()` and each data is ordered by the column-major order.
+ *        The content of this object is moved to the new variable.
+ * @return A new variable.
+ * @remarks This function always uses the default device, and also uses the
+ *          default graph when specifying Node as the template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> input(
+    const Shape &shape, std::vector<float> &&data) {
+  return input<Var>(shape, std::move(data), nullptr);
+}
+
+/**
+ * Creates a new Tensor which refers to an external array.
+ * @param shape Shape of the new Tensor.
+ * @param data Pointer to the array of `shape.size()` values ordered by the
+ *             column-major order.
+ * @param dev Device to manage inner data of the Tensor, or `nullptr` to use the
+ *            default device.
+ * @return A new Tensor.
+ * @remarks CPU devices use `data` as the inner memory without copying, and the
+ *          array should be kept alive and unchanged while the new Tensor and
+ *          any other Tensors sharing its memory exist. The array itself is
+ *          never modified. See `Device::new_tensor_by_borrowed_array()`.
+ */
+Tensor borrowed_input_tensor(
+    const Shape &shape, const float *data, Device *dev);
+
+/**
+ * Creates a new Node which refers to an external array.
+ * @param shape Shape of the new Node.
+ * @param data Pointer to the array of `shape.size()` values ordered by the
+ *             column-major order.
+ * @param dev Device to manage inner data of the Node, or `nullptr` to use the
+ *            default device.
+ * @param g Graph to manage the instance of the Node, or `nullptr` to use the
+ *          default graph.
+ * @return A new Node.
+ * @remarks CPU devices use `data` as the inner memory without copying, and the
+ *          array should be kept alive and unchanged while the graph `g` and
+ *          any Tensors obtained from the new Node exist. The array itself is
+ *          never modified. See `Device::new_tensor_by_borrowed_array()`.
+ */
+Node borrowed_input_node(
+    const Shape &shape, const float *data, Device *dev, Graph *g);
+
+/**
+ * Creates a new variable which refers to an external array.
+ * @param shape Shape of the new variable.
+ * @param data Pointer to the array of `shape.size()` values ordered by the
+ *             column-major order.
+ * @param dev Device to manage inner data of the variable, or `nullptr` to use
+ *            the default device.
+ * @return A new variable.
+ * @remarks CPU devices use `data` as the inner memory without copying. See
+ *          `borrowed_input_tensor()` and `borrowed_input_node()` for the
+ *          lifetime of the array.
+ *          This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+type_traits::Identity<Var> borrowed_input(
+    const Shape &shape, const float *data, Device *dev);
+
+/// @cond
+
+template<>
+inline Tensor borrowed_input<Tensor>(
+    const Shape &shape, const float *data, Device *dev) {
+  return borrowed_input_tensor(shape, data, dev);
+}
+
+template<>
+inline Node borrowed_input<Node>(
+    const Shape &shape, const float *data, Device *dev) {
+  return borrowed_input_node(shape, data, dev, nullptr);
+}
+
+/// @endcond
+
+/**
+ * Creates a new variable which refers to an external array.
+ * @param shape Shape of the new variable.
+ * @param data Pointer to the array of `shape.size()` values ordered by the
+ *             column-major order.
+ * @param dev Device to manage inner data of the variable.
+ * @return A new variable.
+ * @remarks This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> borrowed_input(
+    const Shape &shape, const float *data, Device &dev) {
+  return borrowed_input<Var>(shape, data, &dev);
+}
+
+/**
+ * Creates a new variable which refers to an external array.
+ * @param shape Shape of the new variable.
+ * @param data Pointer to the array of `shape.size()` values ordered by the
+ *             column-major order.
+ * @return A new variable.
+ * @remarks This function always uses the default device, and also uses the
+ *          default graph when specifying Node as the template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> borrowed_input(
+    const Shape &shape, const float *data) {
+  return borrowed_input<Var>(shape, data, nullptr);
+}
+
 /**
  * Creates a new Tensor from a specific Parameter.
  * @param param Parameter to be associated with the Tensor.
@@ -318,6 +513,9 @@ inline Node parameter<Node>(Parameter &param) {
  * @param dev Device to manage the new variable, or `nullptr` to use the default
  *            device.
  * @return A new variable managed on `dev`.
+ * @remarks Copying between devices on the host memory (e.g., Naive and Eigen)
+ *          shares the memory without copying values. See
+ *          `Device::share_tensor()`.
  */
 template<typename Var>
 type_traits::Identity<Var> copy(const Var &x, Device *dev);
@@ -696,6 +894,27 @@ type_traits::Identity<Var> prelu(const Var &x, float a);
 template<typename Var>
 type_traits::Identity<Var> elu(const Var &x, float a);
 
+/**
+ * Applies the dropout:
+ * @f[
+ *  \begin{array}{rcl}
+ *    w & \sim & \mathrm{Bernoulli}(w; 1 - r), \\
+ *    \mathrm{dropout}(x) & := & \frac{1}{1 - r} \times w \times x.
+ *  \end{array}
+ * @f]
+ * @param x A variable representing original values.
+ * @param rate The dropout probability \f$ r \f$.
+ *             `0` maintains all values and `1` discards all values.
+ * @param enabled If `true`, this function applies the operation.
+ *                Otherwise, this function performs nothing.
+ * @return A new variable.
+ * @remarks The mask \f$ w \f$ is generated together with the result, and is
+ *          kept in the device-specific format (bits on CPU devices) for the
+ *          backward operation.
+ */
+template<typename Var>
+type_traits::Identity<Var> dropout(const Var &x, float rate, bool enabled);
+
 /**
  * Retrieves maximum values along an axis.
  * Following examples show how this function work:
@@ -93,8 +93,11 @@ PRIMITIV_C_STATUS primitivEvaluateNodeAsArray(
     const primitivNode_t *node, float *retval, size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(node);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(node)->to_vector(), retval, size);
+  const Node &x = *to_cpp_ptr(node);
+  if (primitiv::c::internal::check_array_size(
+        retval, x.shape().size(), size)) {
+    x.to_array(retval);
+  }
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -103,8 +106,12 @@ PRIMITIV_C_STATUS primitivGetNodeArgmax(
     size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(node);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(node)->argmax(dim), retval, size);
+  const Node &x = *to_cpp_ptr(node);
+  const primitiv::Shape s = x.shape();
+  if (primitiv::c::internal::check_array_size(
+        retval, s.size() / s[dim], size)) {
+    x.argmax(dim, retval);
+  }
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -113,8 +120,12 @@ PRIMITIV_C_STATUS primitivGetNodeArgmin(
     size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(node);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(node)->argmin(dim), retval, size);
+  const Node &x = *to_cpp_ptr(node);
+  const primitiv::Shape s = x.shape();
+  if (primitiv::c::internal::check_array_size(
+        retval, s.size() / s[dim], size)) {
+    x.argmin(dim, retval);
+  }
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -154,6 +154,20 @@ inline void copy_vector_to_array(
   }
 }
 
+// Returns true if `array` can receive `required` elements, or stores the
+// required size into `size` and returns false if `array` is nullptr.
+inline bool check_array_size(
+    const void *array, std::size_t required, std::size_t *size) {
+  if (!array) {
+    *size = required;
+    return false;
+  }
+  if (*size < required) {
+    PRIMITIV_THROW_ERROR("Size is not enough to copy an array.");
+  }
+  return true;
+}
+
 inline void copy_string_to_array(
     const std::string &str, char *buffer, std::size_t *size) {
   if (buffer) {
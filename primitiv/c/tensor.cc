@@ -67,8 +67,19 @@ PRIMITIV_C_STATUS primitivEvaluateTensorAsArray(
     const primitivTensor_t *tensor, float *retval, size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(tensor);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(tensor)->to_vector(), retval, size);
+  const Tensor &x = *to_cpp_ptr(tensor);
+  if (primitiv::c::internal::check_array_size(
+        retval, x.shape().size(), size)) {
+    x.to_array(retval);
+  }
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivGetTensorHostData(
+    const primitivTensor_t *tensor, const float **retval) try {
+  PRIMITIV_C_CHECK_NOT_NULL(tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  *retval = to_cpp_ptr(tensor)->host_data();
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -77,8 +88,12 @@ PRIMITIV_C_STATUS primitivGetTensorArgmax(
     size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(tensor);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(tensor)->argmax(dim), retval, size);
+  const Tensor &x = *to_cpp_ptr(tensor);
+  const primitiv::Shape s = x.shape();
+  if (primitiv::c::internal::check_array_size(
+        retval, s.size() / s[dim], size)) {
+    x.argmax(dim, retval);
+  }
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -87,8 +102,12 @@ PRIMITIV_C_STATUS primitivGetTensorArgmin(
     size_t *size) try {
   PRIMITIV_C_CHECK_NOT_NULL(tensor);
   PRIMITIV_C_CHECK_NOT_NULL(size);
-  primitiv::c::internal::copy_vector_to_array(
-      to_cpp_ptr(tensor)->argmin(dim), retval, size);
+  const Tensor &x = *to_cpp_ptr(tensor);
+  const primitiv::Shape s = x.shape();
+  if (primitiv::c::internal::check_array_size(
+        retval, s.size() / s[dim], size)) {
+    x.argmin(dim, retval);
+  }
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
@@ -88,6 +88,21 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateTensorAsFloat(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateTensorAsArray(
     const primitivTensor_t *tensor, float *retval, size_t *size);
 
+/**
+ * Retrieves the pointer to internal values in the tensor without copying.
+ * @param tensor Pointer of a handler.
+ * @param retval Pointer to receive the const-pointer to the array of internal
+ *               values.
+ * @return Status code.
+ * @remarks This function can be used only when the device of the tensor
+ *          stores values in the host memory (Naive and Eigen). The pointer is
+ *          available until the tensor is deleted or updated by any operations.
+ *          Length and order of the array are same as
+ *          `primitivEvaluateTensorAsArray()`.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetTensorHostData(
+    const primitivTensor_t *tensor, const float **retval);
+
 /**
  * Retrieves argmax indices along an axis.
  * @param tensor Pointer of a handler.
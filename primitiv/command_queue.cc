@@ -0,0 +1,72 @@
+#include <primitiv/config.h>
+
+#include <utility>
+#include <primitiv/command_queue.h>
+
+namespace primitiv {
+
+CommandQueue::CommandQueue()
+: num_pushed_(0)
+, num_finished_(0)
+, stopping_(false)
+, error_()
+, worker_(&CommandQueue::run, this) {}
+
+CommandQueue::~CommandQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  pushed_.notify_one();
+  worker_.join();
+}
+
+void CommandQueue::push(std::function<void()> command) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.emplace_back(std::move(command));
+    ++num_pushed_;
+  }
+  pushed_.notify_one();
+}
+
+void CommandQueue::wait() {
+  if (is_worker_thread()) return;
+  std::unique_lock<std::mutex> lock(mutex_);
+  const std::uint64_t target = num_pushed_;
+  finished_.wait(lock, [&] { return num_finished_ >= target; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void CommandQueue::run() {
+  for (;;) {
+    std::function<void()> command;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      pushed_.wait(lock, [&] { return stopping_ || !commands_.empty(); });
+      if (commands_.empty()) return;
+      command = std::move(commands_.front());
+      commands_.pop_front();
+    }
+    try {
+      command();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+    // Objects captured by the command are destroyed before reporting the
+    // completion, so that waiting threads can observe their side effects.
+    command = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++num_finished_;
+    }
+    finished_.notify_all();
+  }
+}
+
+}  // namespace primitiv
@@ -0,0 +1,79 @@
+#ifndef PRIMITIV_COMMAND_QUEUE_H_
+#define PRIMITIV_COMMAND_QUEUE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <primitiv/mixins.h>
+
+namespace primitiv {
+
+/**
+ * FIFO queue of commands executed by its own worker thread.
+ * @remarks `push()` and `wait()` could be called from multiple threads
+ *          concurrently. Commands are executed one by one in the order of
+ *          `push()`.
+ */
+class CommandQueue : mixins::Nonmovable<CommandQueue> {
+public:
+  /**
+   * Creates a new CommandQueue object and launches the worker thread.
+   */
+  CommandQueue();
+
+  /**
+   * Executes all remaining commands and stops the worker thread.
+   * @remarks Errors of remaining commands are discarded.
+   */
+  ~CommandQueue();
+
+  /**
+   * Appends a new command to the queue.
+   * @param command Function object to be executed by the worker thread.
+   */
+  void push(std::function<void()> command);
+
+  /**
+   * Waits until all commands pushed before this call finish.
+   * @throw Any exception thrown by commands since the last call of `wait()`.
+   *        Only the first exception is reported, and subsequent commands are
+   *        still executed.
+   * @remarks This function returns immediately if it is called from the
+   *          worker thread.
+   */
+  void wait();
+
+  /**
+   * Checks whether the calling thread is the worker thread or not.
+   * @return `true` if the caller is the worker thread, `false` otherwise.
+   */
+  bool is_worker_thread() const {
+    return std::this_thread::get_id() == worker_.get_id();
+  }
+
+private:
+  /**
+   * Main loop of the worker thread.
+   */
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable pushed_;
+  std::condition_variable finished_;
+  std::deque<std::function<void()>> commands_;
+  std::uint64_t num_pushed_;
+  std::uint64_t num_finished_;
+  bool stopping_;
+  std::exception_ptr error_;
+
+  // This member should be initialized after all other members.
+  std::thread worker_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_COMMAND_QUEUE_H_
@@ -69,9 +69,9 @@ public:
 private:
   std::shared_ptr<void> new_handle(const Shape &shape) override;
 
-  std::vector<float> tensor_to_vector_impl(const Tensor &x) override;
-  std::vector<std::uint32_t> argmax_impl(const Tensor &x, std::uint32_t dim) override;
-  std::vector<std::uint32_t> argmin_impl(const Tensor &x, std::uint32_t dim) override;
+  void tensor_to_array_impl(const Tensor &x, float values[]) override;
+  void argmax_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) override;
+  void argmin_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) override;
 
   void reset_tensor_impl(float k, Tensor &x) override;
   void reset_tensor_by_array_impl(const float values[], Tensor &x) override;
@@ -1,5 +1,9 @@
 #include <primitiv/config.h>
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <primitiv/command_queue.h>
 #include <primitiv/device.h>
 #include <primitiv/error.h>
 #include <primitiv/shape_ops.h>
@@ -15,56 +19,319 @@ using std::vector;
         << " != this: " << this); \
   }
 
+// An invalid gradient is treated as 0, and is replaced with a new tensor.
+#define CHECK_OR_INIT_GRADIENT(gx, shape) \
+  if ((gx).valid()) { CHECK_DEVICE(gx); } \
+  else (gx) = new_tensor_by_constant((shape), 0)
+
+namespace {
+
+// Sequence of indices to expand elements of a tuple.
+template<std::size_t... I>
+struct Indices {};
+
+template<std::size_t N, std::size_t... I>
+struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+
+template<std::size_t... I>
+struct MakeIndices<0, I...> { using type = Indices<I...>; };
+
+// Calls a kernel with arguments stored in a tuple.
+template<typename Kernel, typename Arguments, std::size_t... I>
+void call_kernel(
+    primitiv::Device &device, Kernel kernel, Arguments &args, Indices<I...>) {
+  (device.*kernel)(std::get<I>(args).get()...);
+}
+
+}  // namespace
+
 namespace primitiv {
 
+// Memories allocated in the asynchronous mode are released by the worker
+// thread after all kernels enqueued before, so that enqueued kernels can use
+// them without holding their ownership.
+struct Device::AsyncDeleter {
+  Device *device;
+  std::shared_ptr<void> handle;
+
+  void operator()(void *) {
+    if (device->enqueues()) {
+      std::shared_ptr<void> h = std::move(handle);
+      device->queue_->push([h] { static_cast<void>(h); });
+    } else {
+      handle.reset();
+    }
+  }
+};
+
+// Arguments other than tensors are copied.
+template<typename T>
+struct Device::AsyncArgument {
+  static_assert(
+      !std::is_pointer<typename std::decay<T>::type>::value,
+      "Pointers could not be passed to asynchronous kernels.");
+
+  typename std::decay<T>::type value;
+
+  template<typename U>
+  AsyncArgument(Device &, U &&v) : value(std::forward<U>(v)) {}
+
+  T get() { return value; }
+};
+
+// Tensors are passed as new objects referring the same memory without the
+// ownership. This keeps the use count of the memory so that `is_unique()` and
+// the copy-on-write behave as same as the synchronous mode. Memories which
+// were not allocated in the asynchronous mode are additionally held until the
+// kernel finishes.
+template<>
+struct Device::AsyncArgument<const Tensor &> {
+  Tensor view;
+  std::shared_ptr<void> owner;
+
+  AsyncArgument(Device &, const Tensor &x)
+    : view(
+        x.shape_, *x.device_,
+        std::shared_ptr<void>(std::shared_ptr<void>(), x.handle_.get()))
+    , owner(
+        std::get_deleter<AsyncDeleter>(x.handle_)
+        ? std::shared_ptr<void>() : x.handle_) {}
+
+  const Tensor &get() { return view; }
+};
+
+template<>
+struct Device::AsyncArgument<Tensor &> {
+  AsyncArgument<const Tensor &> arg;
+
+  // Views never duplicate the memory in `Tensor::mutable_handle()`, and the
+  // shared memory is duplicated here instead.
+  static Tensor &unshare(Tensor &x) {
+    if (x.handle_.use_count() > 1 || is_borrowed(x)) {
+      x = x.device_->copy_tensor(x);
+    }
+    return x;
+  }
+
+  AsyncArgument(Device &device, Tensor &x) : arg(device, unshare(x)) {}
+
+  Tensor &get() { return arg.view; }
+};
+
+template<>
+struct Device::AsyncArgument<const vector<const Tensor *> &> {
+  vector<AsyncArgument<const Tensor &>> args;
+  vector<const Tensor *> ptrs;
+
+  AsyncArgument(Device &device, const vector<const Tensor *> &xs) {
+    args.reserve(xs.size());
+    for (const Tensor *x : xs) args.emplace_back(device, *x);
+  }
+
+  const vector<const Tensor *> &get() {
+    ptrs.clear();
+    for (const auto &arg : args) ptrs.emplace_back(&arg.view);
+    return ptrs;
+  }
+};
+
+Device::Device() : queue_() {}
+
+Device::~Device() {
+  finalize_async();
+}
+
+void Device::set_async(bool enabled) {
+  if (enabled == is_async()) return;
+  if (enabled) {
+    if (!supports_async()) {
+      PRIMITIV_THROW_ERROR(
+          "The device does not support the asynchronous mode.");
+    }
+    queue_.reset(new CommandQueue());
+  } else {
+    try {
+      queue_->wait();
+    } catch (...) {
+      queue_.reset();
+      throw;
+    }
+    queue_.reset();
+  }
+}
+
+void Device::synchronize() {
+  if (queue_) queue_->wait();
+}
+
+void Device::finalize_async() {
+  if (!queue_) return;
+  try {
+    queue_->wait();
+  } catch (...) {
+    // Errors of remaining kernels are discarded.
+  }
+  queue_.reset();
+}
+
+bool Device::enqueues() const {
+  return queue_ && !queue_->is_worker_thread();
+}
+
+template<typename... Params, typename... Args>
+void Device::run(void (Device::*kernel)(Params...), Args &&... args) {
+  if (!enqueues()) {
+    (this->*kernel)(std::forward<Args>(args)...);
+    return;
+  }
+  using Arguments = std::tuple<AsyncArgument<Params>...>;
+  std::shared_ptr<Arguments> captured(
+      new Arguments {AsyncArgument<Params>(*this, args)...});
+  queue_->push([this, kernel, captured] {
+    call_kernel(
+        *this, kernel, *captured,
+        typename MakeIndices<sizeof...(Params)>::type());
+  });
+}
+
 Tensor Device::new_raw_tensor(const Shape &shape) {
-  return Tensor(shape, *this, new_handle(shape));
+  std::shared_ptr<void> handle = new_handle(shape);
+  if (queue_) {
+    void *ptr = handle.get();
+    handle = std::shared_ptr<void>(ptr, AsyncDeleter {this, std::move(handle)});
+  }
+  return Tensor(shape, *this, std::move(handle));
 }
 
 Tensor Device::new_tensor_by_constant(const Shape &shape, float k) {
-  Tensor ret(shape, *this, new_handle(shape));
+  Tensor ret = new_raw_tensor(shape);
   reset_tensor(k, ret);
   return ret;
 }
 
 Tensor Device::new_tensor_by_array(const Shape &shape, const float values[]) {
-  Tensor ret(shape, *this, new_handle(shape));
+  Tensor ret = new_raw_tensor(shape);
   reset_tensor_by_array(values, ret);
   return ret;
 }
 
 Tensor Device::new_tensor_by_vector(
     const Shape &shape, const vector<float> &values) {
-  Tensor ret(shape, *this, new_handle(shape));
+  Tensor ret = new_raw_tensor(shape);
   reset_tensor_by_vector(values, ret);
   return ret;
 }
 
+Tensor Device::new_tensor_by_vector(
+    const Shape &shape, vector<float> &&values) {
+  if (!uses_host_memory()) {
+    const vector<float> &copied = values;
+    return new_tensor_by_vector(shape, copied);
+  }
+  if (values.size() != shape.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Data sizes mismatched. required: " << shape.size()
+        << " (shape: " << shape.to_string() << ") != actual: "
+        << values.size());
+  }
+  std::shared_ptr<vector<float>> owner(new vector<float>(std::move(values)));
+  float *data = owner->data();
+  return Tensor(shape, *this, std::shared_ptr<void>(std::move(owner), data));
+}
+
+Tensor Device::new_tensor_by_borrowed_array(
+    const Shape &shape, const float values[]) {
+  // Kernels enqueued in the asynchronous mode may run after the array is
+  // released, and the values are copied in this case.
+  if (!uses_host_memory() || enqueues()) {
+    return new_tensor_by_array(shape, values);
+  }
+  return Tensor(
+      shape, *this,
+      std::shared_ptr<void>(const_cast<float *>(values), BorrowedDeleter()));
+}
+
 vector<float> Device::tensor_to_vector(const Tensor &x) {
   CHECK_DEVICE(x);
-  return tensor_to_vector_impl(x);
+  synchronize();
+  vector<float> ret(x.shape().size());
+  tensor_to_array_impl(x, ret.data());
+  return ret;
+}
+
+void Device::tensor_to_array(const Tensor &x, float values[]) {
+  CHECK_DEVICE(x);
+  synchronize();
+  tensor_to_array_impl(x, values);
+}
+
+const float *Device::tensor_host_data(const Tensor &x) {
+  CHECK_DEVICE(x);
+  if (!uses_host_memory()) {
+    PRIMITIV_THROW_ERROR(
+        "The device does not store values in the host memory.");
+  }
+  synchronize();
+  return static_cast<const float *>(x.handle());
 }
 
 vector<std::uint32_t> Device::argmax(const Tensor &x, std::uint32_t dim) {
+  vector<std::uint32_t> ret(x.shape().size() / x.shape()[dim]);
+  argmax(x, dim, ret.data());
+  return ret;
+}
+
+void Device::argmax(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   CHECK_DEVICE(x);
-  return argmax_impl(x, dim);
+  synchronize();
+  argmax_impl(x, dim, ids);
 }
 
 vector<std::uint32_t> Device::argmin(const Tensor &x, std::uint32_t dim) {
+  vector<std::uint32_t> ret(x.shape().size() / x.shape()[dim]);
+  argmin(x, dim, ret.data());
+  return ret;
+}
+
+void Device::argmin(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   CHECK_DEVICE(x);
-  return argmin_impl(x, dim);
+  synchronize();
+  argmin_impl(x, dim, ids);
+}
+
+Tensor Device::broadcast_dims(const Tensor &x, const Shape &shape) {
+  Tensor y = x;
+  for (std::uint32_t d = 0; d < shape.depth(); ++d) {
+    if (y.shape()[d] != shape[d]) y = broadcast_fw(y, d, shape[d]);
+  }
+  return y;
+}
+
+Tensor Device::sum_dims(const Tensor &x, const Shape &shape) {
+  Tensor y = x;
+  for (std::uint32_t d = 0; d < x.shape().depth(); ++d) {
+    if (shape[d] != y.shape()[d]) y = sum_fw(y, d);
+  }
+  return y;
 }
 
 void Device::reset_tensor(float k, Tensor &x) {
   CHECK_DEVICE(x);
-  reset_tensor_impl(k, x);
+  run(&Device::reset_tensor_impl, k, x);
 }
 
 void Device::reset_tensor_by_array(const float values[], Tensor &x) {
   // NOTE(odashi):
   // There is no method to guarantee the size of the array for now.
   CHECK_DEVICE(x);
-  reset_tensor_by_array_impl(values, x);
+  if (enqueues()) {
+    // The array may be released before the kernel runs, and is copied here.
+    run(
+        &Device::reset_tensor_by_vector_impl,
+        vector<float>(values, values + x.shape().size()), x);
+  } else {
+    reset_tensor_by_array_impl(values, x);
+  }
 }
 
 void Device::reset_tensor_by_vector(const vector<float> &values, Tensor &x) {
@@ -75,7 +342,7 @@ void Device::reset_tensor_by_vector(const vector<float> &values, Tensor &x) {
         << " (shape: " << x.shape().to_string() << ") != actual: "
         << values.size());
   }
-  reset_tensor_by_array_impl(values.data(), x);
+  run(&Device::reset_tensor_by_vector_impl, values, x);
 }
 
 Tensor Device::copy_tensor(const Tensor &x) {
@@ -83,16 +350,38 @@ Tensor Device::copy_tensor(const Tensor &x) {
   // This function should return always different memory with x.
   if (!x.valid()) PRIMITIV_THROW_ERROR("Attempted to copy an invalid tensor.");
   Tensor y = new_raw_tensor(x.shape());
-  copy_tensor_impl(x, y);
+  if (&x.device() == this) {
+    run(&Device::copy_tensor_impl, x, y);
+  } else {
+    // Kernels may read the memory of other devices directly. The kernel is
+    // called immediately after pending kernels of the source device, so that
+    // subsequent operations on the source device never overwrite the memory
+    // during copying.
+    x.device().synchronize();
+    copy_tensor_impl(x, y);
+  }
   return y;
 }
 
+Tensor Device::share_tensor(const Tensor &x) {
+  if (!x.valid()) PRIMITIV_THROW_ERROR("Attempted to share an invalid tensor.");
+  Device &src = x.device();
+  // Memories allocated in the asynchronous mode are released through the
+  // source device, and are copied instead to avoid depending on its lifetime.
+  if (&src == this || !uses_host_memory() || !src.uses_host_memory()
+      || std::get_deleter<AsyncDeleter>(x.handle_)) {
+    return copy_tensor(x);
+  }
+  src.synchronize();
+  return Tensor(x.shape_, *this, x.handle_);
+}
+
 Tensor Device::identity(std::uint32_t size) {
   if (size == 0) {
     PRIMITIV_THROW_ERROR("Invalid size of the identity matrix: " << size);
   }
   Tensor y = new_raw_tensor({size, size});
-  identity_impl(y);
+  run(&Device::identity_impl, y);
   return y;
 }
 
@@ -101,30 +390,20 @@ Tensor Device::random_bernoulli(const Shape &shape, float p) {
     PRIMITIV_THROW_ERROR("Invalid Bernoulli probability: " << p);
   }
   Tensor y = new_raw_tensor(shape);
-  random_bernoulli_impl(p, y);
+  run(&Device::random_bernoulli_impl, p, y);
   return y;
 }
 
 Tensor Device::random_uniform(
     const Shape &shape, float lower, float upper) {
-  if (upper < lower) {
-    PRIMITIV_THROW_ERROR(
-        "Invalid parameter of the uniform distribution. lower: " << lower
-        << ", upper: " << upper);
-  }
   Tensor y = new_raw_tensor(shape);
-  random_uniform_impl(lower, upper, y);
+  inplace_random_uniform(lower, upper, y);
   return y;
 }
 
 Tensor Device::random_normal(const Shape &shape, float mean, float sd) {
-  if (sd <= 0) {
-    PRIMITIV_THROW_ERROR(
-        "Invalid parameter of the normal distribution. mean: " << mean
-        << ", SD: " << sd);
-  }
   Tensor y = new_raw_tensor(shape);
-  random_normal_impl(mean, sd, y);
+  inplace_random_normal(mean, sd, y);
   return y;
 }
 
@@ -135,7 +414,7 @@ Tensor Device::random_log_normal(const Shape &shape, float mean, float sd) {
         << ", SD: " << sd);
   }
   Tensor y = new_raw_tensor(shape);
-  random_log_normal_impl(mean, sd, y);
+  run(&Device::random_log_normal_impl, mean, sd, y);
   return y;
 }
 
@@ -143,7 +422,7 @@ Tensor Device::pick_fw(
     const Tensor &x, const vector<std::uint32_t> &ids, std::uint32_t dim) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(shape_ops::pick(x.shape(), ids, dim));
-  pick_fw_impl(x, ids, dim, y);
+  run(&Device::pick_fw_impl, x, ids, dim, y);
   return y;
 }
 
@@ -151,8 +430,17 @@ Tensor Device::slice_fw(
     const Tensor &x, std::uint32_t dim,
     std::uint32_t lower, std::uint32_t upper) {
   CHECK_DEVICE(x);
-  Tensor y = new_raw_tensor(shape_ops::slice(x.shape(), dim, lower, upper));
-  slice_fw_impl(x, dim, lower, y);
+  const Shape sx = x.shape();
+  Shape sy = shape_ops::slice(sx, dim, lower, upper);
+  // The result is a contiguous part of `x` if there are no higher axes, and
+  // can be represented as a view.
+  if (sx.batch() == 1 && dim + 1 >= sx.depth()) {
+    std::shared_ptr<void> handle = new_view_handle(
+        x, static_cast<std::size_t>(lower) * sx.lower_volume(dim));
+    if (handle) return Tensor(std::move(sy), *this, std::move(handle));
+  }
+  Tensor y = new_raw_tensor(sy);
+  run(&Device::slice_fw_impl, x, dim, lower, y);
   return y;
 }
 
@@ -167,7 +455,7 @@ Tensor Device::concat_fw(const vector<const Tensor *> &xs, std::uint32_t dim) {
   }
 
   Tensor y = new_raw_tensor(shape_ops::concat(shapes, dim));
-  concat_fw_impl(xs, dim, y);
+  run(&Device::concat_fw_impl, xs, dim, y);
   return y;
 }
 
@@ -182,7 +470,7 @@ void Device::pick_bw(
         "Shape mismatched. gy.shape(): " << gy.shape().to_string()
         << " != expected shape: " << sy.to_string());
   }
-  pick_bw_impl(gy, ids, dim, gx);
+  run(&Device::pick_bw_impl, gy, ids, dim, gx);
 }
 
 void Device::slice_bw(
@@ -198,25 +486,59 @@ void Device::slice_bw(
         << sy.to_string() << ", dim " << dim << ", offset " << offset
         << " to shape" << sx.to_string() << '.');
   }
-  if (dim >= sx.depth()) inplace_add_impl(gy, gx);
-  else slice_bw_impl(gy, dim, offset, gx);
+  if (dim >= sx.depth()) run(&Device::inplace_add_impl, gy, gx);
+  else run(&Device::slice_bw_impl, gy, dim, offset, gx);
 }
 
 #define DEV_FW_X(name, sop) \
 Tensor Device::name##_fw(const Tensor &x) { \
   CHECK_DEVICE(x); \
   Tensor y = new_raw_tensor(sop(x.shape())); \
-  name##_fw_impl(x, y); \
+  run(&Device::name##_fw_impl, x, y); \
   return y; \
 }
 
+#define DEV_FW_X_INPLACE(name) \
+Tensor Device::name##_fw(Tensor &&x) { \
+  if (!is_unique(x)) return name##_fw(static_cast<const Tensor &>(x)); \
+  CHECK_DEVICE(x); \
+  run(&Device::name##_fw_impl, x, x); \
+  return std::move(x); \
+}
+
+#define DEV_FW_X_CONST_INPLACE(name) \
+Tensor Device::name##_fw(Tensor &&x, float k) { \
+  if (!is_unique(x)) return name##_fw(static_cast<const Tensor &>(x), k); \
+  CHECK_DEVICE(x); \
+  run(&Device::name##_fw_impl, x, k, x); \
+  return std::move(x); \
+}
+
+#define DEV_FW_AB_ELEMENTWISE_INPLACE(name) \
+Tensor Device::name##_fw(Tensor &&a, const Tensor &b) { \
+  CHECK_DEVICE(a); \
+  CHECK_DEVICE(b); \
+  const Shape sy = shape_ops::elementwise(a.shape(), b.shape()); \
+  if (a.shape() != sy || !is_unique(a)) { \
+    return name##_fw(static_cast<const Tensor &>(a), b); \
+  } \
+  if (b.shape().has_same_dims(sy) || supports_dims_broadcast()) { \
+    run(&Device::name##_fw_impl, a, b, a); \
+  } else { \
+    run(&Device::name##_fw_impl, a, broadcast_dims(b, sy), a); \
+  } \
+  return std::move(a); \
+}
+
 #define DEV_BW_X(name, sop) \
 void Device::name##_bw( \
     const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) { \
   CHECK_DEVICE(x); \
   CHECK_DEVICE(y); \
   CHECK_DEVICE(gy); \
-  CHECK_DEVICE(gx); \
+  const bool overwrite = !gx.valid(); \
+  if (overwrite) gx = new_raw_tensor(x.shape()); \
+  else CHECK_DEVICE(gx); \
   if (x.shape() != gx.shape() || \
       y.shape() != gy.shape() || \
       y.shape() != sop(x.shape())) { \
@@ -227,6 +549,14 @@ void Device::name##_bw( \
         << ", gy.shape: " << gy.shape().to_string() \
         << ", gx.shape: " << gx.shape().to_string()); \
   } \
+  if (overwrite) run(&Device::name##_bw_overwrite_impl, x, y, gy, gx); \
+  else run(&Device::name##_bw_impl, x, y, gy, gx); \
+}
+
+#define DEV_BW_X_OVERWRITE(name) \
+void Device::name##_bw_overwrite_impl( \
+    const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) { \
+  reset_tensor_impl(0, gx); \
   name##_bw_impl(x, y, gy, gx); \
 }
 
@@ -234,7 +564,7 @@ void Device::name##_bw( \
 Tensor Device::name##_fw(const Tensor &x, float k) { \
   CHECK_DEVICE(x); \
   Tensor y = new_raw_tensor(x.shape()); \
-  name##_fw_impl(x, k, y); \
+  run(&Device::name##_fw_impl, x, k, y); \
   return y; \
 }
 
@@ -244,7 +574,9 @@ void Device::name##_bw( \
   CHECK_DEVICE(x); \
   CHECK_DEVICE(y); \
   CHECK_DEVICE(gy); \
-  CHECK_DEVICE(gx); \
+  const bool overwrite = !gx.valid(); \
+  if (overwrite) gx = new_raw_tensor(x.shape()); \
+  else CHECK_DEVICE(gx); \
   const Shape &s = x.shape(); \
   if (y.shape() != s || gy.shape() != s || gx.shape() != s) { \
     PRIMITIV_THROW_ERROR( \
@@ -254,6 +586,14 @@ void Device::name##_bw( \
         << ", gy.shape: " << gy.shape().to_string() \
         << ", gx.shape: " << gx.shape().to_string()); \
   } \
+  if (overwrite) run(&Device::name##_bw_overwrite_impl, x, y, gy, k, gx); \
+  else run(&Device::name##_bw_impl, x, y, gy, k, gx); \
+}
+
+#define DEV_BW_X_CONST_OVERWRITE(name) \
+void Device::name##_bw_overwrite_impl( \
+    const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) { \
+  reset_tensor_impl(0, gx); \
   name##_bw_impl(x, y, gy, k, gx); \
 }
 
@@ -262,7 +602,7 @@ Tensor Device::name##_fw(const Tensor &a, const Tensor &b) { \
   CHECK_DEVICE(a); \
   CHECK_DEVICE(b); \
   Tensor y = new_raw_tensor(sop(a.shape(), b.shape())); \
-  name##_fw_impl(a, b, y); \
+  run(&Device::name##_fw_impl, a, b, y); \
   return y; \
 }
 
@@ -274,8 +614,8 @@ void Device::name##_bw( \
   CHECK_DEVICE(b); \
   CHECK_DEVICE(y); \
   CHECK_DEVICE(gy); \
-  CHECK_DEVICE(ga); \
-  CHECK_DEVICE(gb); \
+  CHECK_OR_INIT_GRADIENT(ga, a.shape()); \
+  CHECK_OR_INIT_GRADIENT(gb, b.shape()); \
   if (a.shape() != ga.shape() || \
       b.shape() != gb.shape() || \
       y.shape() != gy.shape() || \
@@ -289,7 +629,76 @@ void Device::name##_bw( \
         << ", ga.shape: " << ga.shape().to_string() \
         << ", gb.shape: " << gb.shape().to_string()); \
   } \
-  name##_bw_impl(a, b, y, gy, ga, gb); \
+  run(&Device::name##_bw_impl, a, b, y, gy, ga, gb); \
+}
+
+// Operands with different dimensions are broadcasted by the kernels if the
+// device supports it, or are materialized by broadcast_dims() otherwise.
+#define DEV_FW_AB_ELEMENTWISE(name) \
+Tensor Device::name##_fw(const Tensor &a, const Tensor &b) { \
+  CHECK_DEVICE(a); \
+  CHECK_DEVICE(b); \
+  const Shape sy = shape_ops::elementwise(a.shape(), b.shape()); \
+  Tensor y = new_raw_tensor(sy); \
+  if (a.shape().has_same_dims(b.shape()) || supports_dims_broadcast()) { \
+    run(&Device::name##_fw_impl, a, b, y); \
+  } else { \
+    run( \
+        &Device::name##_fw_impl, \
+        broadcast_dims(a, sy), broadcast_dims(b, sy), y); \
+  } \
+  return y; \
+}
+
+// On the fallback path, gradients of broadcasted operands are calculated on
+// temporary tensors with the expanded dimensions, and then summed up into
+// `ga` and `gb`.
+#define DEV_BW_AB_ELEMENTWISE(name) \
+void Device::name##_bw( \
+    const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy, \
+    Tensor &ga, Tensor &gb) { \
+  CHECK_DEVICE(a); \
+  CHECK_DEVICE(b); \
+  CHECK_DEVICE(y); \
+  CHECK_DEVICE(gy); \
+  CHECK_OR_INIT_GRADIENT(ga, a.shape()); \
+  CHECK_OR_INIT_GRADIENT(gb, b.shape()); \
+  const Shape &sy = y.shape(); \
+  if (a.shape() != ga.shape() || \
+      b.shape() != gb.shape() || \
+      sy != gy.shape() || \
+      sy != shape_ops::elementwise(a.shape(), b.shape())) { \
+    PRIMITIV_THROW_ERROR( \
+        "Shape mismatched at " #name "_bw" \
+        << ". a.shape: " << a.shape().to_string() \
+        << ", b.shape: " << b.shape().to_string() \
+        << ", y.shape: " << sy.to_string() \
+        << ", gy.shape: " << gy.shape().to_string() \
+        << ", ga.shape: " << ga.shape().to_string() \
+        << ", gb.shape: " << gb.shape().to_string()); \
+  } \
+  if (a.shape().has_same_dims(b.shape()) || supports_dims_broadcast()) { \
+    run(&Device::name##_bw_impl, a, b, y, gy, ga, gb); \
+    return; \
+  } \
+  const bool expand_a = !a.shape().has_same_dims(sy); \
+  const bool expand_b = !b.shape().has_same_dims(sy); \
+  Tensor ega = expand_a \
+    ? new_tensor_by_constant(sy.resize_batch(a.shape().batch()), 0) \
+    : Tensor(); \
+  Tensor egb = expand_b \
+    ? new_tensor_by_constant(sy.resize_batch(b.shape().batch()), 0) \
+    : Tensor(); \
+  run( \
+      &Device::name##_bw_impl, \
+      broadcast_dims(a, sy), broadcast_dims(b, sy), y, gy, \
+      expand_a ? ega : ga, expand_b ? egb : gb); \
+  if (expand_a) { \
+    run(&Device::inplace_add_impl, sum_dims(ega, a.shape()), ga); \
+  } \
+  if (expand_b) { \
+    run(&Device::inplace_add_impl, sum_dims(egb, b.shape()), gb); \
+  } \
 }
 
 DEV_FW_X(negate, static_cast<const Shape &>);
@@ -315,6 +724,17 @@ DEV_BW_X(cos, static_cast<const Shape &>);
 DEV_BW_X(tan, static_cast<const Shape &>);
 DEV_BW_X(transpose, shape_ops::transpose);
 
+DEV_BW_X_OVERWRITE(sqrt);
+DEV_BW_X_OVERWRITE(exp);
+DEV_BW_X_OVERWRITE(log);
+DEV_BW_X_OVERWRITE(tanh);
+DEV_BW_X_OVERWRITE(sigmoid);
+DEV_BW_X_OVERWRITE(softplus);
+DEV_BW_X_OVERWRITE(sin);
+DEV_BW_X_OVERWRITE(cos);
+DEV_BW_X_OVERWRITE(tan);
+DEV_BW_X_OVERWRITE(transpose);
+
 DEV_FW_X_CONST(add_const);
 DEV_FW_X_CONST(subtract_const_r);
 DEV_FW_X_CONST(subtract_const_l);
@@ -329,7 +749,7 @@ DEV_FW_X_CONST(elu);
 Tensor Device::pown_fw(const Tensor &x, std::int32_t k) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape());
-  pown_fw_impl(x, k, y);
+  run(&Device::pown_fw_impl, x, k, y);
   return y;
 }
 
@@ -344,13 +764,24 @@ DEV_BW_X_CONST(pow_const_l);
 DEV_BW_X_CONST(prelu);
 DEV_BW_X_CONST(elu);
 
+DEV_BW_X_CONST_OVERWRITE(add_const);
+DEV_BW_X_CONST_OVERWRITE(subtract_const_r);
+DEV_BW_X_CONST_OVERWRITE(subtract_const_l);
+DEV_BW_X_CONST_OVERWRITE(multiply_const);
+DEV_BW_X_CONST_OVERWRITE(divide_const_r);
+DEV_BW_X_CONST_OVERWRITE(divide_const_l);
+DEV_BW_X_CONST_OVERWRITE(pow_const_r);
+DEV_BW_X_CONST_OVERWRITE(pow_const_l);
+DEV_BW_X_CONST_OVERWRITE(prelu);
+DEV_BW_X_CONST_OVERWRITE(elu);
+
 void Device::pown_bw(
     const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k,
     Tensor &gx) {
   CHECK_DEVICE(x);
   CHECK_DEVICE(y);
   CHECK_DEVICE(gy);
-  CHECK_DEVICE(gx);
+  CHECK_OR_INIT_GRADIENT(gx, x.shape());
   const Shape &s = x.shape();
   if (y.shape() != s || gy.shape() != s || gx.shape() != s) {
     PRIMITIV_THROW_ERROR(
@@ -360,7 +791,7 @@ void Device::pown_bw(
         << ", gy.shape: " << gy.shape().to_string()
         << ", gx.shape: " << gx.shape().to_string());
   }
-  pown_bw_impl(x, y, gy, k, gx);
+  run(&Device::pown_bw_impl, x, y, gy, k, gx);
 }
 
 DEV_FW_AB(add_scalar, shape_ops::scalar_op);
@@ -372,13 +803,41 @@ DEV_FW_AB(divide_scalar_l, shape_ops::scalar_op);
 DEV_FW_AB(pow_scalar_r, shape_ops::scalar_op);
 DEV_FW_AB(pow_scalar_l, shape_ops::scalar_op);
 
-DEV_FW_AB(add, shape_ops::elementwise);
-DEV_FW_AB(subtract, shape_ops::elementwise);
-DEV_FW_AB(multiply, shape_ops::elementwise);
-DEV_FW_AB(divide, shape_ops::elementwise);
-DEV_FW_AB(pow, shape_ops::elementwise);
+DEV_FW_AB_ELEMENTWISE(add);
+DEV_FW_AB_ELEMENTWISE(subtract);
+DEV_FW_AB_ELEMENTWISE(multiply);
+DEV_FW_AB_ELEMENTWISE(divide);
+DEV_FW_AB_ELEMENTWISE(pow);
 DEV_FW_AB(matmul, shape_ops::matmul);
 
+DEV_FW_X_INPLACE(negate);
+DEV_FW_X_INPLACE(sqrt);
+DEV_FW_X_INPLACE(exp);
+DEV_FW_X_INPLACE(log);
+DEV_FW_X_INPLACE(tanh);
+DEV_FW_X_INPLACE(sigmoid);
+DEV_FW_X_INPLACE(softplus);
+DEV_FW_X_INPLACE(sin);
+DEV_FW_X_INPLACE(cos);
+DEV_FW_X_INPLACE(tan);
+
+DEV_FW_X_CONST_INPLACE(add_const);
+DEV_FW_X_CONST_INPLACE(subtract_const_r);
+DEV_FW_X_CONST_INPLACE(subtract_const_l);
+DEV_FW_X_CONST_INPLACE(multiply_const);
+DEV_FW_X_CONST_INPLACE(divide_const_r);
+DEV_FW_X_CONST_INPLACE(divide_const_l);
+DEV_FW_X_CONST_INPLACE(pow_const_r);
+DEV_FW_X_CONST_INPLACE(pow_const_l);
+DEV_FW_X_CONST_INPLACE(prelu);
+DEV_FW_X_CONST_INPLACE(elu);
+
+DEV_FW_AB_ELEMENTWISE_INPLACE(add);
+DEV_FW_AB_ELEMENTWISE_INPLACE(subtract);
+DEV_FW_AB_ELEMENTWISE_INPLACE(multiply);
+DEV_FW_AB_ELEMENTWISE_INPLACE(divide);
+DEV_FW_AB_ELEMENTWISE_INPLACE(pow);
+
 Tensor Device::conv2d_fw(
     const Tensor &x, const Tensor &w,
     std::uint32_t padding0, std::uint32_t padding1,
@@ -389,7 +848,8 @@ Tensor Device::conv2d_fw(
   Tensor y = new_raw_tensor(shape_ops::conv2d(
         x.shape(), w.shape(),
         padding0, padding1, stride0, stride1, dilation0, dilation1));
-  conv2d_fw_impl(
+  run(
+      &Device::conv2d_fw_impl,
       x, w, padding0, padding1, stride0, stride1, dilation0, dilation1, y);
   return y;
 }
@@ -402,18 +862,92 @@ Tensor Device::max_pool2d_fw(
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(shape_ops::pool2d(
         x.shape(), window0, window1, padding0, padding1, stride0, stride1));
-  max_pool2d_fw_impl(
+  run(
+      &Device::max_pool2d_fw_impl,
       x, window0, window1, padding0, padding1, stride0, stride1, y);
   return y;
 }
 
-DEV_BW_AB(add, shape_ops::elementwise);
-DEV_BW_AB(subtract, shape_ops::elementwise);
-DEV_BW_AB(multiply, shape_ops::elementwise);
-DEV_BW_AB(divide, shape_ops::elementwise);
-DEV_BW_AB(pow, shape_ops::elementwise);
+DEV_BW_AB_ELEMENTWISE(add);
+DEV_BW_AB_ELEMENTWISE(subtract);
+DEV_BW_AB_ELEMENTWISE(multiply);
+DEV_BW_AB_ELEMENTWISE(divide);
+DEV_BW_AB_ELEMENTWISE(pow);
 DEV_BW_AB(matmul, shape_ops::matmul);
 
+Tensor Device::matmul_fw(
+    const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b) {
+  CHECK_DEVICE(a);
+  CHECK_DEVICE(b);
+  Tensor y = new_raw_tensor(
+      shape_ops::matmul(a.shape(), b.shape(), transpose_a, transpose_b));
+  if (!transpose_a && !transpose_b) {
+    run(&Device::matmul_fw_impl, a, b, y);
+  } else {
+    run(
+        &Device::matmul_transposed_fw_impl,
+        a, b, transpose_a, transpose_b, y);
+  }
+  return y;
+}
+
+void Device::matmul_bw(
+    const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
+    bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb) {
+  CHECK_DEVICE(a);
+  CHECK_DEVICE(b);
+  CHECK_DEVICE(y);
+  CHECK_DEVICE(gy);
+  CHECK_OR_INIT_GRADIENT(ga, a.shape());
+  CHECK_OR_INIT_GRADIENT(gb, b.shape());
+  if (a.shape() != ga.shape() ||
+      b.shape() != gb.shape() ||
+      y.shape() != gy.shape() ||
+      y.shape() != shape_ops::matmul(
+        a.shape(), b.shape(), transpose_a, transpose_b)) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched at matmul_bw"
+        << ". a.shape: " << a.shape().to_string()
+        << ", b.shape: " << b.shape().to_string()
+        << ", y.shape: " << y.shape().to_string()
+        << ", gy.shape: " << gy.shape().to_string()
+        << ", ga.shape: " << ga.shape().to_string()
+        << ", gb.shape: " << gb.shape().to_string()
+        << ", transpose_a: " << transpose_a
+        << ", transpose_b: " << transpose_b);
+  }
+  if (!transpose_a && !transpose_b) {
+    run(&Device::matmul_bw_impl, a, b, y, gy, ga, gb);
+  } else {
+    run(
+        &Device::matmul_transposed_bw_impl,
+        a, b, y, gy, transpose_a, transpose_b, ga, gb);
+  }
+}
+
+void Device::matmul_transposed_fw_impl(
+    const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b,
+    Tensor &y) {
+  matmul_fw_impl(
+      transpose_a ? transpose_fw(a) : a,
+      transpose_b ? transpose_fw(b) : b,
+      y);
+}
+
+void Device::matmul_transposed_bw_impl(
+    const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
+    bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb) {
+  const Tensor at = transpose_a ? transpose_fw(a) : a;
+  const Tensor bt = transpose_b ? transpose_fw(b) : b;
+  Tensor gat, gbt;
+  if (transpose_a) gat = new_tensor_by_constant(at.shape(), 0);
+  if (transpose_b) gbt = new_tensor_by_constant(bt.shape(), 0);
+  matmul_bw_impl(
+      at, bt, y, gy, transpose_a ? gat : ga, transpose_b ? gbt : gb);
+  if (transpose_a) transpose_bw_impl(a, at, gat, ga);
+  if (transpose_b) transpose_bw_impl(b, bt, gbt, gb);
+}
+
 void Device::conv2d_bw(
     const Tensor &x, const Tensor &w, const Tensor &y, const Tensor &gy,
     std::uint32_t padding0, std::uint32_t padding1,
@@ -424,8 +958,8 @@ void Device::conv2d_bw(
   CHECK_DEVICE(w);
   CHECK_DEVICE(y);
   CHECK_DEVICE(gy);
-  CHECK_DEVICE(gx);
-  CHECK_DEVICE(gw);
+  CHECK_OR_INIT_GRADIENT(gx, x.shape());
+  CHECK_OR_INIT_GRADIENT(gw, w.shape());
   if (x.shape() != gx.shape() ||
       w.shape() != gw.shape() ||
       y.shape() != gy.shape() ||
@@ -447,7 +981,8 @@ void Device::conv2d_bw(
         << ", dilation0: " << dilation0
         << ", dilation1: " << dilation1);
   }
-  conv2d_bw_impl(
+  run(
+      &Device::conv2d_bw_impl,
       x, w, y, gy, padding0, padding1, stride0, stride1, dilation0, dilation1,
       gx, gw);
 }
@@ -461,7 +996,7 @@ void Device::max_pool2d_bw(
   CHECK_DEVICE(x);
   CHECK_DEVICE(y);
   CHECK_DEVICE(gy);
-  CHECK_DEVICE(gx);
+  CHECK_OR_INIT_GRADIENT(gx, x.shape());
   if (x.shape() != gx.shape() ||
       y.shape() != gy.shape() ||
       y.shape() != shape_ops::pool2d(
@@ -479,28 +1014,99 @@ void Device::max_pool2d_bw(
         << ", stride0: " << stride0
         << ", stride1: " << stride1);
   }
-  max_pool2d_bw_impl(
+  run(
+      &Device::max_pool2d_bw_impl,
       x, y, gy, window0, window1, padding0, padding1, stride0, stride1, gx);
 }
 
+Tensor Device::dropout_fw(const Tensor &x, float rate, Tensor &mask) {
+  CHECK_DEVICE(x);
+  if (rate < 0 || rate > 1) {
+    PRIMITIV_THROW_ERROR("Invalid dropout rate: " << rate);
+  }
+  const Shape mask_shape = dropout_mask_shape(x.shape());
+  Tensor y = new_raw_tensor(x.shape());
+  if (!mask.valid()) {
+    mask = new_raw_tensor(mask_shape);
+    run(&Device::dropout_fw_impl, x, rate, mask, y);
+    return y;
+  }
+  CHECK_DEVICE(mask);
+  if (mask.shape() != mask_shape) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched at dropout_fw"
+        << ". x.shape: " << x.shape().to_string()
+        << ", mask.shape: " << mask.shape().to_string()
+        << ", expected mask.shape: " << mask_shape.to_string());
+  }
+  // Applying the mask is the same calculation as the overwriting backward.
+  run(&Device::dropout_bw_overwrite_impl, x, mask, rate, y);
+  return y;
+}
+
+void Device::dropout_bw(
+    const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) {
+  CHECK_DEVICE(gy);
+  CHECK_DEVICE(mask);
+  const bool overwrite = !gx.valid();
+  if (overwrite) gx = new_raw_tensor(gy.shape());
+  else CHECK_DEVICE(gx);
+  if (gx.shape() != gy.shape() ||
+      mask.shape() != dropout_mask_shape(gy.shape())) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched at dropout_bw"
+        << ". gy.shape: " << gy.shape().to_string()
+        << ", mask.shape: " << mask.shape().to_string()
+        << ", gx.shape: " << gx.shape().to_string());
+  }
+  if (overwrite) run(&Device::dropout_bw_overwrite_impl, gy, mask, rate, gx);
+  else run(&Device::dropout_bw_impl, gy, mask, rate, gx);
+}
+
+void Device::dropout_fw_impl(
+    const Tensor &x, float rate, Tensor &mask, Tensor &y) {
+  random_bernoulli_impl(1 - rate, mask);
+  dropout_bw_overwrite_impl(x, mask, rate, y);
+}
+
+void Device::dropout_bw_impl(
+    const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) {
+  Tensor temp = new_raw_tensor(gy.shape());
+  dropout_bw_overwrite_impl(gy, mask, rate, temp);
+  inplace_add_impl(temp, gx);
+}
+
+void Device::dropout_bw_overwrite_impl(
+    const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) {
+  multiply_fw_impl(gy, mask, gx);
+  inplace_multiply_const_impl(rate < 1 ? 1 / (1 - rate) : 0, gx);
+}
+
 #undef DEV_FW_X
 #undef DEV_BW_X
+#undef DEV_BW_X_OVERWRITE
 #undef DEV_FW_X_CONST
 #undef DEV_BW_X_CONST
+#undef DEV_BW_X_CONST_OVERWRITE
 #undef DEV_FW_AB
 #undef DEV_BW_AB
+#undef DEV_FW_AB_ELEMENTWISE
+#undef DEV_BW_AB_ELEMENTWISE
+#undef DEV_FW_X_INPLACE
+#undef DEV_FW_X_CONST_INPLACE
+#undef DEV_FW_AB_ELEMENTWISE_INPLACE
 
 Tensor Device::max_fw(const Tensor &x, std::uint32_t dim) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape().resize_dim(dim, 1));
-  max_fw_impl(x, dim, y);
+  run(&Device::max_fw_impl, x, dim, y);
   return y;
 }
 
 Tensor Device::min_fw(const Tensor &x, std::uint32_t dim) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape().resize_dim(dim, 1));
-  min_fw_impl(x, dim, y);
+  run(&Device::min_fw_impl, x, dim, y);
   return y;
 }
 
@@ -508,7 +1114,7 @@ void Device::max_bw(const Tensor &x, const Tensor &y, const Tensor &gy, std::uin
   CHECK_DEVICE(x);
   CHECK_DEVICE(y);
   CHECK_DEVICE(gy);
-  CHECK_DEVICE(gx);
+  CHECK_OR_INIT_GRADIENT(gx, x.shape());
   const Shape &r = x.shape();
   const Shape s = r.resize_dim(dim, 1);
   if (gx.shape() != r || y.shape() != s || gy.shape() != s) {
@@ -519,14 +1125,14 @@ void Device::max_bw(const Tensor &x, const Tensor &y, const Tensor &gy, std::uin
         << ", gy.shape: " << gy.shape().to_string()
         << ", gx.shape: " << gx.shape().to_string());
   }
-  max_bw_impl(x, y, gy, dim, gx);
+  run(&Device::max_bw_impl, x, y, gy, dim, gx);
 }
 
 void Device::min_bw(const Tensor &x, const Tensor &y, const Tensor &gy, std::uint32_t dim, Tensor &gx) {
   CHECK_DEVICE(x);
   CHECK_DEVICE(y);
   CHECK_DEVICE(gy);
-  CHECK_DEVICE(gx);
+  CHECK_OR_INIT_GRADIENT(gx, x.shape());
   const Shape &r = x.shape();
   const Shape s = r.resize_dim(dim, 1);
   if (gx.shape() != r || y.shape() != s || gy.shape() != s) {
@@ -537,20 +1143,20 @@ void Device::min_bw(const Tensor &x, const Tensor &y, const Tensor &gy, std::uin
         << ", gy.shape: " << gy.shape().to_string()
         << ", gx.shape: " << gx.shape().to_string());
   }
-  min_bw_impl(x, y, gy, dim, gx);
+  run(&Device::min_bw_impl, x, y, gy, dim, gx);
 }
 
 Tensor Device::sum_fw(const Tensor &x, std::uint32_t dim) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape().resize_dim(dim, 1));
-  sum_fw_impl(x, dim, y);
+  run(&Device::sum_fw_impl, x, dim, y);
   return y;
 }
 
 Tensor Device::logsumexp_fw(const Tensor &x, std::uint32_t dim) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape().resize_dim(dim, 1));
-  logsumexp_fw_impl(x, dim, y);
+  run(&Device::logsumexp_fw_impl, x, dim, y);
   return y;
 }
 
@@ -558,7 +1164,7 @@ Tensor Device::broadcast_fw(
     const Tensor &x, std::uint32_t dim, std::uint32_t size) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(shape_ops::broadcast(x.shape(), dim, size));
-  broadcast_fw_impl(x, dim, size, y);
+  run(&Device::broadcast_fw_impl, x, dim, size, y);
   return y;
 }
 
@@ -566,15 +1172,21 @@ Tensor Device::batch_pick_fw(
     const Tensor &x, const vector<std::uint32_t> &ids) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(shape_ops::batch_pick(x.shape(), ids));
-  batch_pick_fw_impl(x, ids, y);
+  run(&Device::batch_pick_fw_impl, x, ids, y);
   return y;
 }
 
 Tensor Device::batch_slice_fw(
     const Tensor &x, std::uint32_t lower, std::uint32_t upper) {
   CHECK_DEVICE(x);
-  Tensor y = new_raw_tensor(shape_ops::batch_slice(x.shape(), lower, upper));
-  batch_slice_fw_impl(x, lower, y);
+  const Shape sx = x.shape();
+  Shape sy = shape_ops::batch_slice(sx, lower, upper);
+  // Each minibatch is always stored contiguously.
+  std::shared_ptr<void> handle = new_view_handle(
+      x, static_cast<std::size_t>(lower) * sx.volume());
+  if (handle) return Tensor(std::move(sy), *this, std::move(handle));
+  Tensor y = new_raw_tensor(sy);
+  run(&Device::batch_slice_fw_impl, x, lower, y);
   return y;
 }
 
@@ -589,14 +1201,14 @@ Tensor Device::batch_concat_fw(const std::vector<const Tensor *> &xs) {
   }
 
   Tensor y = new_raw_tensor(shape_ops::batch_concat(shapes));
-  batch_concat_fw_impl(xs, y);
+  run(&Device::batch_concat_fw_impl, xs, y);
   return y;
 }
 
 Tensor Device::batch_sum_fw(const Tensor &x) {
   CHECK_DEVICE(x);
   Tensor y = new_raw_tensor(x.shape().resize_batch(1));
-  batch_sum_fw_impl(x, y);
+  run(&Device::batch_sum_fw_impl, x, y);
   return y;
 }
 
@@ -610,7 +1222,7 @@ void Device::batch_pick_bw(
         "Shape mismatched. gy.shape(): " << gy.shape().to_string()
         << " != expected shape: " << sy.to_string());
   }
-  batch_pick_bw_impl(gy, ids, gx);
+  run(&Device::batch_pick_bw_impl, gy, ids, gx);
 }
 
 void Device::batch_slice_bw(
@@ -625,12 +1237,35 @@ void Device::batch_slice_bw(
         << sy.to_string() << ", batch offset " << offset
         << " to shape" << sx.to_string() << '.');
   }
-  batch_slice_bw_impl(gy, offset, gx);
+  run(&Device::batch_slice_bw_impl, gy, offset, gx);
 }
 
 void Device::inplace_multiply_const(float k, Tensor &x) {
   CHECK_DEVICE(x);
-  inplace_multiply_const_impl(k, x);
+  run(&Device::inplace_multiply_const_impl, k, x);
+}
+
+void Device::inplace_random_uniform(float lower, float upper, Tensor &x) {
+  CHECK_DEVICE(x);
+  if (upper < lower) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid parameter of the uniform distribution. lower: " << lower
+        << ", upper: " << upper);
+  }
+  // Shared memory is not copied because all values are overwritten.
+  if (!is_unique(x)) x = new_raw_tensor(x.shape());
+  run(&Device::random_uniform_impl, lower, upper, x);
+}
+
+void Device::inplace_random_normal(float mean, float sd, Tensor &x) {
+  CHECK_DEVICE(x);
+  if (sd <= 0) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid parameter of the normal distribution. mean: " << mean
+        << ", SD: " << sd);
+  }
+  if (!is_unique(x)) x = new_raw_tensor(x.shape());
+  run(&Device::random_normal_impl, mean, sd, x);
 }
 
 void Device::inplace_add(const Tensor &x, Tensor &y) {
@@ -643,7 +1278,7 @@ void Device::inplace_add(const Tensor &x, Tensor &y) {
         "Attempted to add values of shape "
         << sx.to_string() << " to " << sy.to_string() << '.');
   }
-  inplace_add_impl(x, y);
+  run(&Device::inplace_add_impl, x, y);
 }
 
 void Device::inplace_subtract(const Tensor &x, Tensor &y) {
@@ -656,7 +1291,7 @@ void Device::inplace_subtract(const Tensor &x, Tensor &y) {
         "Attempted to subtract values of shape "
         << sx.to_string() << " from " << sy.to_string() << '.');
   }
-  inplace_subtract_impl(x, y);
+  run(&Device::inplace_subtract_impl, x, y);
 }
 
 }  // namespace primitiv
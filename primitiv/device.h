@@ -1,6 +1,7 @@
 #ifndef PRIMITIV_DEVICE_H_
 #define PRIMITIV_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <primitiv/mixins.h>
@@ -9,6 +10,8 @@
 
 namespace primitiv {
 
+class CommandQueue;
+
 /**
  * Interface of the Tensor provider.
  */
@@ -41,8 +44,8 @@ public:
     OPENCL = 0x00020000,
   };
 
-  Device() = default;
-  virtual ~Device() = default;
+  Device();
+  virtual ~Device();
 
   /**
    * Prints device description to stderr.
@@ -55,6 +58,35 @@ public:
    */
   virtual DeviceType type() const = 0;
 
+  /**
+   * Enables or disables the asynchronous mode.
+   * @param enabled `true` to enable the asynchronous mode, `false` otherwise.
+   * @throw primitiv::Error The device does not support the asynchronous mode,
+   *                        or pending kernels failed when disabling the mode.
+   * @remarks In the asynchronous mode, kernels are enqueued to the worker
+   *          thread of the device and are executed in order, and the caller
+   *          continues without waiting for their results. Only functions
+   *          which return internal values to the host (e.g.,
+   *          `Tensor::to_vector()`, `Tensor::to_float()` and
+   *          `Tensor::argmax()`) wait for pending kernels.
+   *          This function should not be called concurrently with any other
+   *          operations on the device.
+   */
+  void set_async(bool enabled);
+
+  /**
+   * Checks whether the asynchronous mode is enabled or not.
+   * @return `true` if the asynchronous mode is enabled, `false` otherwise.
+   */
+  bool is_async() const { return !!queue_; }
+
+  /**
+   * Waits until all pending kernels finish.
+   * @throw primitiv::Error or any other exceptions thrown by pending kernels.
+   * @remarks This function does nothing if the asynchronous mode is disabled.
+   */
+  void synchronize();
+
 private:
   /**
    * Provides a new Tensor object on the device.
@@ -89,6 +121,35 @@ public:
   Tensor new_tensor_by_vector(
       const Shape &shape, const std::vector<float> &values);
 
+  /**
+   * Provides a new Tensor object which takes the ownership of specific values.
+   * @param shape Shape of the tensor.
+   * @param values List of internal values. The content of this object is moved
+   *               to the resulting tensor.
+   * @return A new Tensor object.
+   * @remarks If the device stores values in the host memory, the memory of
+   *          `values` is directly used as the internal memory of the resulting
+   *          tensor. Otherwise, values are copied.
+   */
+  Tensor new_tensor_by_vector(const Shape &shape, std::vector<float> &&values);
+
+  /**
+   * Provides a new Tensor object which refers to an external array.
+   * @param shape Shape of the tensor.
+   * @param values Pointer to array of `shape.size()` internal values.
+   * @return A new Tensor object.
+   * @remarks If the device stores values in the host memory and the
+   *          asynchronous mode is disabled, `values` is directly used as the
+   *          internal memory of the resulting tensor without copying. In this
+   *          case, the array should be kept alive and unchanged while the
+   *          resulting tensor and any other tensors sharing its memory exist.
+   *          The array is never modified by the device: operations which
+   *          update the tensor duplicate the memory beforehand.
+   *          Otherwise, values are copied.
+   */
+  Tensor new_tensor_by_borrowed_array(
+      const Shape &shape, const float values[]);
+
   /**
    * Copies the tensor to this device with allocating a new memory.
    * @param x A tensor to be copied.
@@ -99,6 +160,21 @@ public:
    */
   Tensor copy_tensor(const Tensor &x);
 
+  /**
+   * Provides a tensor on this device which has the same values as the given
+   * tensor.
+   * @param x A tensor on any device.
+   * @return A tensor on this device.
+   * @remarks If both this device and `x.device()` store values in the host
+   *          memory (e.g., Naive and Eigen), the resulting tensor refers to
+   *          the memory of `x` without copying. The shared memory is
+   *          duplicated when either tensor is updated, as same as other
+   *          shared tensors. The shared memory is owned by the resulting
+   *          tensor and remains available after `x.device()` is destroyed.
+   *          Otherwise, this function behaves as same as `copy_tensor()`.
+   */
+  Tensor share_tensor(const Tensor &x);
+
   // Provides an identity matrix.
   Tensor identity(std::uint32_t size);
 
@@ -108,6 +184,12 @@ public:
   Tensor random_normal(const Shape &shape, float mean, float sd);
   Tensor random_log_normal(const Shape &shape, float mean, float sd);
 
+  // Backward functions (*_bw) add the gradients of arguments to `gx`, `ga`,
+  // `gb` or `gw`. If the given gradient is an invalid Tensor, it is treated
+  // as 0 and a new tensor with the shape of the corresponding argument is
+  // stored instead. Functions which do not receive argument values (pick_bw,
+  // slice_bw, batch_pick_bw and batch_slice_bw) always require valid `gx`.
+
   // Tensor manipulations.
   Tensor pick_fw(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim);
   Tensor slice_fw(const Tensor &x, std::uint32_t dim, std::uint32_t lower, std::uint32_t upper);
@@ -204,6 +286,46 @@ public:
       const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
       Tensor &ga, Tensor &gb);
 
+  // Matrix multiplication with transposed operands, i.e.,
+  // y = op(a) . op(b), where op(x) = x^T if transpose_x is true, or x.
+  Tensor matmul_fw(
+      const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b);
+  void matmul_bw(
+      const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
+      bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb);
+
+  // In-place variants of element-wise operations.
+  // These functions store the result into the memory of `x` (or `a`) if it is
+  // not shared with any other Tensor objects and has the same shape as the
+  // result. Otherwise, they fall back to the functions above.
+  Tensor negate_fw(Tensor &&x);
+  Tensor sqrt_fw(Tensor &&x);
+  Tensor exp_fw(Tensor &&x);
+  Tensor log_fw(Tensor &&x);
+  Tensor tanh_fw(Tensor &&x);
+  Tensor sigmoid_fw(Tensor &&x);
+  Tensor softplus_fw(Tensor &&x);
+  Tensor sin_fw(Tensor &&x);
+  Tensor cos_fw(Tensor &&x);
+  Tensor tan_fw(Tensor &&x);
+
+  Tensor add_const_fw(Tensor &&x, float k);
+  Tensor subtract_const_r_fw(Tensor &&x, float k);
+  Tensor subtract_const_l_fw(Tensor &&x, float k);
+  Tensor multiply_const_fw(Tensor &&x, float k);
+  Tensor divide_const_r_fw(Tensor &&x, float k);
+  Tensor divide_const_l_fw(Tensor &&x, float k);
+  Tensor pow_const_r_fw(Tensor &&x, float k);
+  Tensor pow_const_l_fw(Tensor &&x, float k);
+  Tensor prelu_fw(Tensor &&x, float k);
+  Tensor elu_fw(Tensor &&x, float k);
+
+  Tensor add_fw(Tensor &&a, const Tensor &b);
+  Tensor subtract_fw(Tensor &&a, const Tensor &b);
+  Tensor multiply_fw(Tensor &&a, const Tensor &b);
+  Tensor divide_fw(Tensor &&a, const Tensor &b);
+  Tensor pow_fw(Tensor &&a, const Tensor &b);
+
   // Dimension operations.
   Tensor max_fw(const Tensor &x, std::uint32_t dim);
   Tensor min_fw(const Tensor &x, std::uint32_t dim);
@@ -251,6 +373,13 @@ public:
       std::uint32_t stride0, std::uint32_t stride1,
       Tensor &gx);
 
+  // Dropout.
+  // `mask` holds the dropout mask in the device-specific format. If `mask` is
+  // an invalid Tensor, dropout_fw() generates a new mask and stores it.
+  // Otherwise, the given mask is applied again.
+  Tensor dropout_fw(const Tensor &x, float rate, Tensor &mask);
+  void dropout_bw(const Tensor &gy, const Tensor &mask, float rate, Tensor &gx);
+
   /**
    * Directly multiplies all elements by a constant.
    * @param k A constant to multiply.
@@ -280,6 +409,29 @@ public:
    */
   void inplace_subtract(const Tensor &x, Tensor &y);
 
+  /**
+   * Directly overwrites all elements by random values of a uniform
+   * distribution.
+   * @param lower Lower bound of the distribution.
+   * @param upper Upper bound of the distribution.
+   * @param x A tensor to be updated.
+   * @remarks Range of resulting values is (lower, upper]. The memory of `x` is
+   *          overwritten without allocating new one if it is not shared with
+   *          other objects.
+   */
+  void inplace_random_uniform(float lower, float upper, Tensor &x);
+
+  /**
+   * Directly overwrites all elements by random values of a normal
+   * distribution.
+   * @param mean Mean of the distribution.
+   * @param sd Standard deviation of the distribution.
+   * @param x A tensor to be updated.
+   * @remarks The memory of `x` is overwritten without allocating new one if it
+   *          is not shared with other objects.
+   */
+  void inplace_random_normal(float mean, float sd, Tensor &x);
+
 private:
   /**
    * Retrieves internal values of the tensor as a vector.
@@ -290,6 +442,22 @@ private:
    */
   std::vector<float> tensor_to_vector(const Tensor &x);
 
+  /**
+   * Copies internal values of the tensor into an array.
+   * @param x A tensor.
+   * @param values Pointer to array of `x.shape().size()` elements in which
+   *               results are stored.
+   */
+  void tensor_to_array(const Tensor &x, float values[]);
+
+  /**
+   * Retrieves the pointer to internal values of the tensor on the host memory.
+   * @param x A tensor.
+   * @return Const-pointer to the array of `x.shape().size()` internal values.
+   * @throw primitiv::Error The device does not store values in the host memory.
+   */
+  const float *tensor_host_data(const Tensor &x);
+
   /**
    * Retrieves argmax indices along an axis.
    * @param x A tensor.
@@ -298,6 +466,15 @@ private:
    */
   std::vector<std::uint32_t> argmax(const Tensor &x, std::uint32_t dim);
 
+  /**
+   * Retrieves argmax indices along an axis into an array.
+   * @param x A tensor.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `x.shape().size() / x.shape()[dim]`
+   *            elements in which results are stored.
+   */
+  void argmax(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]);
+
   /**
    * Retrieves argmin indices along an axis.
    * @param x A tensor.
@@ -306,6 +483,33 @@ private:
    */
   std::vector<std::uint32_t> argmin(const Tensor &x, std::uint32_t dim);
 
+  /**
+   * Retrieves argmin indices along an axis into an array.
+   * @param x A tensor.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `x.shape().size() / x.shape()[dim]`
+   *            elements in which results are stored.
+   */
+  void argmin(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]);
+
+  /**
+   * Expands dimensions of the tensor to those of the given shape.
+   * @param x A tensor.
+   * @param shape Target shape. The minibatch size is not used.
+   * @return A tensor in which each dimension of size 1 is broadcasted to the
+   *         corresponding dimension of `shape`.
+   */
+  Tensor broadcast_dims(const Tensor &x, const Shape &shape);
+
+  /**
+   * Reduces dimensions of the tensor to those of the given shape.
+   * @param x A tensor.
+   * @param shape Target shape. The minibatch size is not used.
+   * @return A tensor in which each dimension with size 1 in `shape` is
+   *         summed up.
+   */
+  Tensor sum_dims(const Tensor &x, const Shape &shape);
+
 protected:
   /**
    * Obtains an inner handle from a Tensor.
@@ -325,6 +529,41 @@ protected:
     return x.mutable_handle();
   }
 
+  /**
+   * Checks whether the memory of a Tensor is owned only by itself.
+   * @param x Target Tensor object.
+   * @return `true` if `x` is valid and no other objects share its memory,
+   *         `false` otherwise.
+   */
+  static bool is_unique(const Tensor &x) {
+    return x.handle_.use_count() == 1 && !is_borrowed(x);
+  }
+
+  /**
+   * Checks whether the memory of a Tensor is borrowed from an external array.
+   * @param x Target Tensor object.
+   * @return `true` if `x` refers to an external array, `false` otherwise.
+   * @remarks Borrowed memories are never overwritten.
+   */
+  static bool is_borrowed(const Tensor &x) {
+    return !!std::get_deleter<BorrowedDeleter>(x.handle_);
+  }
+
+  /**
+   * Makes a new handle which points a part of the memory of a Tensor.
+   * @param x Target Tensor object.
+   * @param offset Number of elements from the beginning of `x`.
+   * @return New handle sharing the ownership of the memory with `x`.
+   * @remarks This function is available only for devices that represent
+   *          handles as raw pointers to the array of `T`.
+   */
+  template<typename T>
+  static std::shared_ptr<void> get_view_handle(
+      const Tensor &x, std::size_t offset) {
+    return std::shared_ptr<void>(
+        x.handle_, static_cast<T *>(x.handle_.get()) + offset);
+  }
+
   /**
    * Reset internal values of the tensor using a constant.
    * @param k A value used to initialize each element.
@@ -352,14 +591,88 @@ protected:
    */
   void reset_tensor_by_vector(const std::vector<float> &values, Tensor &x);
 
+  /**
+   * Waits for all pending kernels and disables the asynchronous mode without
+   * reporting errors.
+   * @remarks Devices supporting the asynchronous mode should call this
+   *          function in their destructors, because pending kernels may use
+   *          members of the derived classes.
+   */
+  void finalize_async();
+
 private:
+  /**
+   * Deleter of handles allocated in the asynchronous mode.
+   */
+  struct AsyncDeleter;
+
+  /**
+   * Deleter of handles referring to external arrays, which does nothing.
+   */
+  struct BorrowedDeleter {
+    void operator()(void *) const {}
+  };
+
+  /**
+   * Holder of an argument of kernels executed asynchronously.
+   */
+  template<typename T>
+  struct AsyncArgument;
+
+  /**
+   * Checks whether kernels called now should be enqueued or not.
+   * @return `true` if the asynchronous mode is enabled and the caller is not
+   *         the worker thread, `false` otherwise.
+   */
+  bool enqueues() const;
+
+  /**
+   * Calls a kernel, or enqueues it in the asynchronous mode.
+   * @param kernel Pointer to the kernel function.
+   * @param args Arguments of the kernel. Tensors are passed to the enqueued
+   *             kernel as references to the same memory, and other arguments
+   *             are copied.
+   */
+  template<typename... Params, typename... Args>
+  void run(void (Device::*kernel)(Params...), Args &&... args);
+
+  // Helper kernel to enqueue `reset_tensor_by_array_impl()` with the copy of
+  // the values.
+  void reset_tensor_by_vector_impl(
+      const std::vector<float> &values, Tensor &x) {
+    reset_tensor_by_array_impl(values.data(), x);
+  }
+
+  // Returns true if the device can be used in the asynchronous mode, i.e.,
+  // all kernels are executed on the host memory and can be called from any
+  // thread.
+  virtual bool supports_async() const { return false; }
+
+  // Returns true if handles of the device are raw pointers to the array of
+  // float on the host memory, so that any external arrays can be used as
+  // handles directly. Handles of such devices are shared with other devices
+  // by `share_tensor()`, and they should be released without the device
+  // (e.g., not allocated from a MemoryPool owned by the device).
+  virtual bool uses_host_memory() const { return false; }
+
   // device-specific implementations.
 
   virtual std::shared_ptr<void> new_handle(const Shape &shape) = 0;
 
-  virtual std::vector<float> tensor_to_vector_impl(const Tensor &x) = 0;
-  virtual std::vector<std::uint32_t> argmax_impl(const Tensor &x, std::uint32_t dim) = 0;
-  virtual std::vector<std::uint32_t> argmin_impl(const Tensor &x, std::uint32_t dim) = 0;
+  // Returns an empty handle if the device does not support views. In this
+  // case, operations fall back to allocating and copying new memory.
+  virtual std::shared_ptr<void> new_view_handle(
+      const Tensor &, std::size_t) { return std::shared_ptr<void>(); }
+
+  // Returns true if the binary element-wise kernels (add, subtract, multiply,
+  // divide and pow) broadcast operands along any dimensions. Otherwise, the
+  // kernels only receive operands with the same dimensions, and broadcasted
+  // operands are materialized before calling them.
+  virtual bool supports_dims_broadcast() const { return false; }
+
+  virtual void tensor_to_array_impl(const Tensor &x, float values[]) = 0;
+  virtual void argmax_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) = 0;
+  virtual void argmin_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) = 0;
 
   virtual void reset_tensor_impl(float k, Tensor &x) = 0;
   virtual void reset_tensor_by_array_impl(const float values[], Tensor &x) = 0;
@@ -429,6 +742,30 @@ private:
 
   virtual void pown_bw_impl(const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k, Tensor &gx) = 0;
 
+  // Overwriting variants of the backward kernels above, which store the
+  // gradient into `gx` with uninitialized memory instead of accumulating it.
+  // Default implementations fill `gx` by 0 and call accumulating kernels.
+  virtual void sqrt_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void exp_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void log_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void tanh_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void sigmoid_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void softplus_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void sin_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void cos_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void tan_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void transpose_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx);
+  virtual void add_const_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void subtract_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void subtract_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void multiply_const_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void divide_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void divide_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void pow_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void pow_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void prelu_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+  virtual void elu_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx);
+
   virtual void add_scalar_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
   virtual void subtract_scalar_r_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
   virtual void subtract_scalar_l_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
@@ -464,6 +801,16 @@ private:
       const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
       Tensor &ga, Tensor &gb) = 0;
 
+  // Default implementations explicitly transpose the operands and call
+  // matmul_{fw,bw}_impl(). Devices can override them to use transposed
+  // operands directly in the matrix multiplication.
+  virtual void matmul_transposed_fw_impl(
+      const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b,
+      Tensor &y);
+  virtual void matmul_transposed_bw_impl(
+      const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
+      bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb);
+
   virtual void max_fw_impl(const Tensor &x, std::uint32_t dim, Tensor &y) = 0;
   virtual void min_fw_impl(const Tensor &x, std::uint32_t dim, Tensor &y) = 0;
   virtual void max_bw_impl(const Tensor &x, const Tensor &y, const Tensor &gy, std::uint32_t dim, Tensor &gx) = 0;
@@ -510,10 +857,24 @@ private:
       std::uint32_t stride0, std::uint32_t stride1,
       Tensor &gx) = 0;
 
+  // Dropout kernels. `mask` has the shape returned by dropout_mask_shape(),
+  // and dropout_bw_overwrite_impl() is also used to apply an existing mask in
+  // the forward operation. Default implementations store the mask as a
+  // Bernoulli tensor with the same shape as `x`, and compose other kernels.
+  virtual Shape dropout_mask_shape(const Shape &shape) const { return shape; }
+  virtual void dropout_fw_impl(
+      const Tensor &x, float rate, Tensor &mask, Tensor &y);
+  virtual void dropout_bw_impl(
+      const Tensor &gy, const Tensor &mask, float rate, Tensor &gx);
+  virtual void dropout_bw_overwrite_impl(
+      const Tensor &gy, const Tensor &mask, float rate, Tensor &gx);
+
   virtual void inplace_multiply_const_impl(float k, Tensor &x) = 0;
 
   virtual void inplace_add_impl(const Tensor &x, Tensor &y) = 0;
   virtual void inplace_subtract_impl(const Tensor &x, Tensor &y) = 0;
+
+  std::unique_ptr<CommandQueue> queue_;
 };
 
 }  // namespace primitiv
@@ -0,0 +1,88 @@
+#ifndef PRIMITIV_DEVICE_OPS_BROADCAST_H_
+#define PRIMITIV_DEVICE_OPS_BROADCAST_H_
+
+#include <cstdint>
+#include <primitiv/shape.h>
+
+namespace primitiv {
+namespace devices {
+
+/**
+ * Enumerates contiguous runs of elements in the result of a broadcasted
+ * binary operation.
+ * @param a Shape of the left hand side.
+ * @param b Shape of the right hand side.
+ * @param y Shape of the result.
+ * @param func Function called for each run as
+ *             `func(offset_y, offset_a, step_a, offset_b, step_b, size)`.
+ *             The `i`-th element (`0 <= i < size`) of the run is located at
+ *             `offset_y + i` in the result, and at `offset_x + i * step_x` in
+ *             each operand `x`, where `step_x` is 0 if `x` is broadcasted
+ *             along the run, or 1 otherwise.
+ * @remarks Axes with the same broadcasting pattern are collapsed before the
+ *          enumeration, so that operands with the same shape are processed by
+ *          only one run.
+ */
+template<typename Func>
+void broadcast_runs(const Shape &a, const Shape &b, const Shape &y, Func func) {
+  static const std::uint32_t MAX_AXES = Shape::MAX_DEPTH + 1;
+  std::uint32_t sizes[MAX_AXES];
+  bool full_a[MAX_AXES], full_b[MAX_AXES];
+  std::uint32_t n = 0;
+
+  // Collapses axes. The minibatch is treated as the last axis.
+  const std::uint32_t depth = y.depth();
+  for (std::uint32_t d = 0; d <= depth; ++d) {
+    const std::uint32_t sy = d < depth ? y[d] : y.batch();
+    if (sy == 1) continue;
+    const bool fa = (d < depth ? a[d] : a.batch()) == sy;
+    const bool fb = (d < depth ? b[d] : b.batch()) == sy;
+    if (n > 0 && full_a[n - 1] == fa && full_b[n - 1] == fb) {
+      sizes[n - 1] *= sy;
+    } else {
+      sizes[n] = sy;
+      full_a[n] = fa;
+      full_b[n] = fb;
+      ++n;
+    }
+  }
+  if (n == 0) {
+    // All operands have only one element.
+    func(0, 0, 1, 0, 1, 1);
+    return;
+  }
+
+  // Strides of each operand for each collapsed axis.
+  std::uint32_t stride_a[MAX_AXES], stride_b[MAX_AXES];
+  std::uint32_t volume_a = 1, volume_b = 1;
+  for (std::uint32_t k = 0; k < n; ++k) {
+    stride_a[k] = full_a[k] * volume_a;
+    stride_b[k] = full_b[k] * volume_b;
+    if (full_a[k]) volume_a *= sizes[k];
+    if (full_b[k]) volume_b *= sizes[k];
+  }
+
+  // The first collapsed axis is used as the run, and others are enumerated.
+  const std::uint32_t total = y.size();
+  const std::uint32_t run = sizes[0];
+  std::uint32_t index[MAX_AXES] {};
+  std::uint32_t oy = 0, oa = 0, ob = 0;
+  for (;;) {
+    func(oy, oa, stride_a[0], ob, stride_b[0], run);
+    oy += run;
+    if (oy >= total) break;
+    for (std::uint32_t k = 1; k < n; ++k) {
+      oa += stride_a[k];
+      ob += stride_b[k];
+      if (++index[k] < sizes[k]) break;
+      oa -= stride_a[k] * sizes[k];
+      ob -= stride_b[k] * sizes[k];
+      index[k] = 0;
+    }
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
+
+#endif  // PRIMITIV_DEVICE_OPS_BROADCAST_H_
@@ -11,5 +11,10 @@ std::shared_ptr<void> CUDA::new_handle(const Shape &shape) {
   return state_->pool.allocate(sizeof(float) * shape.size());
 }
 
+std::shared_ptr<void> CUDA::new_view_handle(
+    const Tensor &x, std::size_t offset) {
+  return get_view_handle<float>(x, offset);
+}
+
 }  // namespace devices
 }  // namespace primitiv
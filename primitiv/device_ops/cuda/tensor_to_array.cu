@@ -7,13 +7,11 @@
 namespace primitiv {
 namespace devices {
 
-std::vector<float> CUDA::tensor_to_vector_impl(const Tensor &x) {
+void CUDA::tensor_to_array_impl(const Tensor &x, float values[]) {
   const std::uint32_t size = x.shape().size();
-  std::vector<float> ret(size);
   CUDA_CALL(::cudaSetDevice(dev_id_));
   CUDA_CALL(::cudaMemcpy(
-        ret.data(), CDATA(x), sizeof(float) * size, cudaMemcpyDeviceToHost));
-  return ret;
+        values, CDATA(x), sizeof(float) * size, cudaMemcpyDeviceToHost));
 }
 
 }  // namespace devices
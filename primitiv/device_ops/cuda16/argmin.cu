@@ -54,8 +54,8 @@ __global__ void argmin_dev(
 namespace primitiv {
 namespace devices {
 
-std::vector<std::uint32_t> CUDA16::argmin_impl(
-    const Tensor &x, std::uint32_t dim) {
+void CUDA16::argmin_impl(
+    const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   const Shape &shape = x.shape();
   const std::uint32_t n = shape[dim];
   const std::uint32_t r = shape.size() / n;
@@ -81,10 +81,8 @@ std::vector<std::uint32_t> CUDA16::argmin_impl(
     CASE(1);
 #undef CASE
   }
-  std::vector<std::uint32_t> ret(r);
   CUDA_CALL(::cudaMemcpy(
-        &ret[0], py.get(), sizeof(std::uint32_t) * r, cudaMemcpyDeviceToHost));
-  return ret;
+        ids, py.get(), sizeof(std::uint32_t) * r, cudaMemcpyDeviceToHost));
 }
 
 }  // namespace devices
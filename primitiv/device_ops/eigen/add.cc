@@ -16,21 +16,17 @@ EIGEN_DEV_FW_AB(add, a + b);
 void Eigen::add_bw_impl(
     const Tensor &, const Tensor &, const Tensor &, const Tensor &gy_,
     Tensor &ga_, Tensor &gb_) {
-  const std::uint32_t size = gy_.shape().volume();
-  const std::uint32_t bs = gy_.shape().batch();
-  const std::uint32_t skip_a = ga_.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb_.shape().has_batch() * size;
   const float *pgy = CDATA(gy_);
   float *pga = MDATA(ga_);
   float *pgb = MDATA(gb_);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
-    EMap<const EArrayXf> gy(pgy, size);
-    EMap<EArrayXf>(pga, size) += gy;
-    EMap<EArrayXf>(pgb, size) += gy;
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  broadcast_runs(
+      ga_.shape(), gb_.shape(), gy_.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
+    EMap<const EArrayXf> gy(pgy + oy, size);
+    EIGEN_BROADCAST_ACCUMULATE(sa, pga + oa, gy);
+    EIGEN_BROADCAST_ACCUMULATE(sb, pgb + ob, gy);
+  });
 }
 
 }  // namespace devices
@@ -6,8 +6,8 @@
 namespace primitiv {
 namespace devices {
 
-std::vector<std::uint32_t> Eigen::argmin_impl(
-    const Tensor &x, std::uint32_t dim) {
+void Eigen::argmin_impl(
+    const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   // TODO(odashi): Optimize this functions using Eigen operations.
 
   const Shape &s = x.shape();
@@ -16,8 +16,6 @@ std::vector<std::uint32_t> Eigen::argmin_impl(
   const std::uint32_t skip1 = s.lower_volume(dim);
   const std::uint32_t skip2 = skip1 * n;
   const float *src = CDATA(x);
-  std::vector<std::uint32_t> ret;
-  ret.reserve(repeat);
   for (std::uint32_t i = 0; i < repeat; ++i) {
     std::uint32_t offset = i % skip1 + (i / skip1) * skip2;
     float max_val = src[offset];
@@ -29,9 +27,8 @@ std::vector<std::uint32_t> Eigen::argmin_impl(
         argmax_val = j;
       }
     }
-    ret.emplace_back(argmax_val);
+    ids[i] = argmax_val;
   }
-  return ret;
 }
 
 }  // namespace devices
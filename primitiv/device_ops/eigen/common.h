@@ -12,6 +12,8 @@
 #define EIGEN_MPL2_ONLY
 #include <Eigen/Eigen>
 
+#include <primitiv/device_ops/broadcast.h>
+
 template<typename T>
 using EMap = ::Eigen::Map<T>;
 
@@ -33,16 +35,22 @@ void Eigen::name##_fw_impl(const Tensor &x_, Tensor &y_) { \
   EMap<EArrayXf>(MDATA(y_), size) = (op); \
 }
 
-#define EIGEN_DEV_BW_X(name, op) \
-void Eigen::name##_bw_impl( \
+// Backward kernels of element-wise operations are defined in both the
+// accumulating (`+=`) and the overwriting (`=`) variants.
+#define EIGEN_DEV_BW_X_KERNEL(fname, update, op) \
+void Eigen::fname( \
     const Tensor &x_, const Tensor &y_, const Tensor &gy_, Tensor &gx_) { \
   const std::size_t size = x_.shape().size(); \
   EMap<const EArrayXf> x(CDATA(x_), size); MAYBE_USED(x); \
   EMap<const EArrayXf> y(CDATA(y_), size); MAYBE_USED(y); \
   EMap<const EArrayXf> gy(CDATA(gy_), size); \
-  EMap<EArrayXf>(MDATA(gx_), size) += (op); \
+  EMap<EArrayXf>(MDATA(gx_), size) update (op); \
 }
 
+#define EIGEN_DEV_BW_X(name, op) \
+  EIGEN_DEV_BW_X_KERNEL(name##_bw_impl, +=, op) \
+  EIGEN_DEV_BW_X_KERNEL(name##_bw_overwrite_impl, =, op)
+
 #define EIGEN_DEV_FW_X_CONST(name, op) \
 void Eigen::name##_fw_impl(const Tensor &x_, float k, Tensor &y_) { \
   const std::size_t size = x_.shape().size(); \
@@ -50,8 +58,8 @@ void Eigen::name##_fw_impl(const Tensor &x_, float k, Tensor &y_) { \
   EMap<EArrayXf>(MDATA(y_), size) = (op); \
 }
 
-#define EIGEN_DEV_BW_X_CONST(name, op) \
-void Eigen::name##_bw_impl( \
+#define EIGEN_DEV_BW_X_CONST_KERNEL(fname, update, op) \
+void Eigen::fname( \
     const Tensor &x_, const Tensor &y_, const Tensor &gy_, float k, \
     Tensor &gx_) { \
   MAYBE_USED(k); \
@@ -59,9 +67,13 @@ void Eigen::name##_bw_impl( \
   EMap<const EArrayXf> x(CDATA(x_), size); MAYBE_USED(x); \
   EMap<const EArrayXf> y(CDATA(y_), size); MAYBE_USED(y); \
   EMap<const EArrayXf> gy(CDATA(gy_), size); \
-  EMap<EArrayXf>(MDATA(gx_), size) += (op); \
+  EMap<EArrayXf>(MDATA(gx_), size) update (op); \
 }
 
+#define EIGEN_DEV_BW_X_CONST(name, op) \
+  EIGEN_DEV_BW_X_CONST_KERNEL(name##_bw_impl, +=, op) \
+  EIGEN_DEV_BW_X_CONST_KERNEL(name##_bw_overwrite_impl, =, op)
+
 #define EIGEN_DEV_FW_X_SCALAR(name, op) \
 void Eigen::name##_fw_impl(const Tensor &x_, const Tensor &k_, Tensor &y_) { \
   const std::uint32_t size = y_.shape().volume(); \
@@ -81,23 +93,42 @@ void Eigen::name##_fw_impl(const Tensor &x_, const Tensor &k_, Tensor &y_) { \
   } \
 }
 
+// Evaluates `body` for a run enumerated by broadcast_runs(), where `a` and `b`
+// are arrays of both operands. Broadcasted operands are represented by
+// constant arrays to avoid materializing them.
+#define EIGEN_BROADCAST_RUN(pa, pb, body) \
+  if (sa && sb) { \
+    EMap<const EArrayXf> a((pa) + oa, size); \
+    EMap<const EArrayXf> b((pb) + ob, size); \
+    body; \
+  } else if (sa) { \
+    EMap<const EArrayXf> a((pa) + oa, size); \
+    const auto b = EArrayXf::Constant(size, (pb)[ob]); \
+    body; \
+  } else { \
+    const auto a = EArrayXf::Constant(size, (pa)[oa]); \
+    EMap<const EArrayXf> b((pb) + ob, size); \
+    body; \
+  }
+
+// Accumulates `op` into the gradient `pg` of an operand with the step `step`.
+// Gradients of broadcasted operands are reduced to the sum over the run.
+#define EIGEN_BROADCAST_ACCUMULATE(step, pg, op) \
+  if (step) EMap<EArrayXf>((pg), size) += (op); \
+  else *(pg) += (op).sum();
+
 #define EIGEN_DEV_FW_AB(name, op) \
 void Eigen::name##_fw_impl(const Tensor &a_, const Tensor &b_, Tensor &y_) { \
-  const std::uint32_t size = y_.shape().volume(); \
-  const std::uint32_t bs = y_.shape().batch(); \
-  const std::uint32_t skip_a = a_.shape().has_batch() * size; \
-  const std::uint32_t skip_b = b_.shape().has_batch() * size; \
   const float *src_a = CDATA(a_); \
   const float *src_b = CDATA(b_); \
   float *dest = MDATA(y_); \
-  for (std::uint32_t batch = 0; batch < bs; ++batch) { \
-    EMap<const EArrayXf> a(src_a, size); \
-    EMap<const EArrayXf> b(src_b, size); \
-    EMap<EArrayXf>(dest, size) = (op); \
-    dest += size; \
-    src_a += skip_a; \
-    src_b += skip_b; \
-  } \
+  broadcast_runs( \
+      a_.shape(), b_.shape(), y_.shape(), \
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa, \
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) { \
+    EIGEN_BROADCAST_RUN( \
+        src_a, src_b, EMap<EArrayXf>(dest + oy, size) = (op)); \
+  }); \
 }
 
 #endif  // PRIMITIV_DEVICE_OPS_COMMON_EIGEN_H_
@@ -9,8 +9,6 @@ namespace devices {
 void Eigen::copy_tensor_impl(const Tensor &x, Tensor &y) {
   switch (x.device().type()) {
     case Device::DeviceType::NAIVE:
-      reset_tensor_by_array(CDATA(x), y);
-      break;
     case Device::DeviceType::EIGEN:
       reset_tensor_by_array(CDATA(x), y);
       break;
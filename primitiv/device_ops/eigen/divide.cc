@@ -19,28 +19,26 @@ EIGEN_DEV_FW_X_SCALAR(divide_scalar_l, k / x);
 EIGEN_DEV_FW_AB(divide, a / b);
 
 void Eigen::divide_bw_impl(
-    const Tensor &, const Tensor &b_, const Tensor &y_, const Tensor &gy_,
+    const Tensor &a_, const Tensor &b_, const Tensor &y_, const Tensor &gy_,
     Tensor &ga_, Tensor &gb_) {
-  const std::uint32_t size = gy_.shape().volume();
-  const std::uint32_t bs = gy_.shape().batch();
-  const std::uint32_t skip_a = ga_.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb_.shape().has_batch() * size;
+  const float *pa = CDATA(a_);
   const float *pb = CDATA(b_);
   const float *py = CDATA(y_);
   const float *pgy = CDATA(gy_);
   float *pga = MDATA(ga_);
   float *pgb = MDATA(gb_);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
-    EMap<const EArrayXf> b(pb, size);
-    EMap<const EArrayXf> gy(pgy, size);
-    EMap<EArrayXf>(pga, size) += gy / b;
-    EMap<EArrayXf>(pgb, size) -= gy * EMap<const EArrayXf>(py, size) / b;
-    pb += skip_b;
-    py += size;
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  broadcast_runs(
+      ga_.shape(), gb_.shape(), gy_.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
+    EMap<const EArrayXf> gy(pgy + oy, size);
+    EMap<const EArrayXf> y(py + oy, size);
+    EIGEN_BROADCAST_RUN(pa, pb, {
+      MAYBE_USED(a);
+      EIGEN_BROADCAST_ACCUMULATE(sa, pga + oa, gy / b);
+      EIGEN_BROADCAST_ACCUMULATE(sb, pgb + ob, -gy * y / b);
+    });
+  });
 }
 
 }  // namespace devices
@@ -0,0 +1,67 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+
+#include <primitiv/eigen_device.h>
+#include <primitiv/device_ops/eigen/common.h>
+
+namespace {
+
+using EArray32f = ::Eigen::Array<float, 32, 1>;
+
+// Scaling factor of kept elements.
+inline float dropout_scale(float rate) {
+  return rate < 1 ? 1 / (1 - rate) : 0;
+}
+
+// Expands a word of the mask to the factors of corresponding 32 elements.
+struct DropoutFactor {
+  std::uint32_t bits;
+  float k;
+  float operator()(::Eigen::Index j) const {
+    return ((bits >> j) & 1) ? k : 0.f;
+  }
+};
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+Shape Eigen::dropout_mask_shape(const Shape &shape) const {
+  // Each bit represents whether the corresponding element is kept or not.
+  return Shape({(shape.size() + 31) / 32});
+}
+
+void Eigen::dropout_fw_impl(
+    const Tensor &x, float rate, Tensor &mask, Tensor &y) {
+  randomizer_.fill_bernoulli_bits(
+      1 - rate, x.shape().size(),
+      static_cast<std::uint32_t *>(get_mutable_handle(mask)));
+  dropout_bw_overwrite_impl(x, mask, rate, y);
+}
+
+#define EIGEN_DEV_DROPOUT_BW_KERNEL(fname, update) \
+void Eigen::fname( \
+    const Tensor &gy_, const Tensor &mask, float rate, Tensor &gx_) { \
+  const std::uint32_t size = gy_.shape().size(); \
+  const std::uint32_t *pmask = \
+    static_cast<const std::uint32_t *>(get_handle(mask)); \
+  const float k = ::dropout_scale(rate); \
+  EMap<const EArrayXf> gy(CDATA(gy_), size); \
+  EMap<EArrayXf> gx(MDATA(gx_), size); \
+  for (std::uint32_t i = 0; i < size; i += 32) { \
+    const std::uint32_t n = std::min(32u, size - i); \
+    gx.segment(i, n) update \
+      gy.segment(i, n) * EArray32f::NullaryExpr( \
+        ::DropoutFactor { pmask[i / 32], k }).head(n); \
+  } \
+}
+
+EIGEN_DEV_DROPOUT_BW_KERNEL(dropout_bw_impl, +=);
+EIGEN_DEV_DROPOUT_BW_KERNEL(dropout_bw_overwrite_impl, =);
+
+#undef EIGEN_DEV_DROPOUT_BW_KERNEL
+
+}  // namespace devices
+}  // namespace primitiv
@@ -3,6 +3,24 @@
 #include <primitiv/eigen_device.h>
 #include <primitiv/device_ops/eigen/common.h>
 
+namespace {
+
+// Calculates y += op(a) . op(b), where op(x) = x^T if transpose_x is true, or
+// x.
+void gemm(
+    const EMap<const EMatrixXf> &a, const EMap<const EMatrixXf> &b,
+    bool transpose_a, bool transpose_b, EMap<EMatrixXf> &y) {
+  if (transpose_a) {
+    if (transpose_b) y.noalias() += a.transpose() * b.transpose();
+    else y.noalias() += a.transpose() * b;
+  } else {
+    if (transpose_b) y.noalias() += a * b.transpose();
+    else y.noalias() += a * b;
+  }
+}
+
+}  // namespace
+
 namespace primitiv {
 namespace devices {
 
@@ -78,5 +96,67 @@ void Eigen::matmul_bw_impl(
   }
 }
 
+void Eigen::matmul_transposed_fw_impl(
+    const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b,
+    Tensor &y) {
+  const std::uint32_t a0 = a.shape()[0];
+  const std::uint32_t a1 = a.shape()[1];
+  const std::uint32_t b0 = b.shape()[0];
+  const std::uint32_t b1 = b.shape()[1];
+  const std::uint32_t y0 = y.shape()[0];
+  const std::uint32_t y1 = y.shape()[1];
+
+  const float *src_a = CDATA(a);
+  const float *src_b = CDATA(b);
+  float *dest = MDATA(y);
+
+  const std::uint32_t a_skip = a.shape().has_batch() * a0 * a1;
+  const std::uint32_t b_skip = b.shape().has_batch() * b0 * b1;
+  const std::uint32_t y_skip = y0 * y1;
+  const std::uint32_t bs = y.shape().batch();
+  for (std::uint32_t n = 0; n < bs; ++n) {
+    EMap<const EMatrixXf> aa(src_a + n * a_skip, a0, a1);
+    EMap<const EMatrixXf> bb(src_b + n * b_skip, b0, b1);
+    EMap<EMatrixXf> yy(dest + n * y_skip, y0, y1);
+    yy.setZero();
+    gemm(aa, bb, transpose_a, transpose_b, yy);
+  }
+}
+
+void Eigen::matmul_transposed_bw_impl(
+    const Tensor &a, const Tensor &b, const Tensor &, const Tensor &gy,
+    bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb) {
+  const std::uint32_t a0 = a.shape()[0];
+  const std::uint32_t a1 = a.shape()[1];
+  const std::uint32_t b0 = b.shape()[0];
+  const std::uint32_t b1 = b.shape()[1];
+  const std::uint32_t y0 = gy.shape()[0];
+  const std::uint32_t y1 = gy.shape()[1];
+
+  const float *src_a = CDATA(a);
+  const float *src_b = CDATA(b);
+  const float *src_gy = CDATA(gy);
+  float *dest_ga = MDATA(ga);
+  float *dest_gb = MDATA(gb);
+
+  const std::uint32_t a_skip = a.shape().has_batch() * a0 * a1;
+  const std::uint32_t b_skip = b.shape().has_batch() * b0 * b1;
+  const std::uint32_t y_skip = y0 * y1;
+  const std::uint32_t bs = gy.shape().batch();
+  for (std::uint32_t n = 0; n < bs; ++n) {
+    EMap<const EMatrixXf> aa(src_a + n * a_skip, a0, a1);
+    EMap<const EMatrixXf> bb(src_b + n * b_skip, b0, b1);
+    EMap<const EMatrixXf> gyy(src_gy + n * y_skip, y0, y1);
+    EMap<EMatrixXf> gaa(dest_ga + n * a_skip, a0, a1);
+    EMap<EMatrixXf> gbb(dest_gb + n * b_skip, b0, b1);
+    // ga += gy . op(b)^T, or op(b) . gy^T if a is transposed.
+    if (transpose_a) gemm(bb, gyy, transpose_b, true, gaa);
+    else gemm(gyy, bb, false, !transpose_b, gaa);
+    // gb += op(a)^T . gy, or gy^T . op(a) if b is transposed.
+    if (transpose_b) gemm(gyy, aa, true, transpose_a, gbb);
+    else gemm(aa, gyy, !transpose_a, false, gbb);
+  }
+}
+
 }  // namespace devices
 }  // namespace primitiv
@@ -16,25 +16,21 @@ EIGEN_DEV_FW_AB(multiply, a * b);
 void Eigen::multiply_bw_impl(
     const Tensor &a_, const Tensor &b_, const Tensor &, const Tensor &gy_,
     Tensor &ga_, Tensor &gb_) {
-  const std::uint32_t size = gy_.shape().volume();
-  const std::uint32_t bs = gy_.shape().batch();
-  const std::uint32_t skip_a = ga_.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb_.shape().has_batch() * size;
   const float *pa = CDATA(a_);
   const float *pb = CDATA(b_);
   const float *pgy = CDATA(gy_);
   float *pga = MDATA(ga_);
   float *pgb = MDATA(gb_);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
-    EMap<const EArrayXf> gy(pgy, size);
-    EMap<EArrayXf>(pga, size) += gy * EMap<const EArrayXf>(pb, size);
-    EMap<EArrayXf>(pgb, size) += gy * EMap<const EArrayXf>(pa, size);
-    pa += skip_a;
-    pb += skip_b;
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  broadcast_runs(
+      ga_.shape(), gb_.shape(), gy_.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
+    EMap<const EArrayXf> gy(pgy + oy, size);
+    EIGEN_BROADCAST_RUN(pa, pb, {
+      EIGEN_BROADCAST_ACCUMULATE(sa, pga + oa, gy * b);
+      EIGEN_BROADCAST_ACCUMULATE(sb, pgb + ob, gy * a);
+    });
+  });
 }
 
 }  // namespace devices
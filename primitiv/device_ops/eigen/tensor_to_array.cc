@@ -8,11 +8,9 @@
 namespace primitiv {
 namespace devices {
 
-std::vector<float> Eigen::tensor_to_vector_impl(const Tensor &x) {
+void Eigen::tensor_to_array_impl(const Tensor &x, float values[]) {
   const std::uint32_t num_elements = x.shape().size();
-  std::vector<float> ret(num_elements);
-  std::memcpy(&ret[0], CDATA(x), sizeof(float) * num_elements);
-  return ret;
+  std::memcpy(values, CDATA(x), sizeof(float) * num_elements);
 }
 
 }  // namespace devices
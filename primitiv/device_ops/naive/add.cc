@@ -11,28 +11,24 @@ CPUDEV_BW_X_CONST(add_const, pgy[i]);
 
 CPUDEV_FW_X_SCALAR(add_scalar, src_x[i] + *src_k);
 
-CPUDEV_FW_AB(add, src_a[i] + src_b[i]);
+CPUDEV_FW_AB(add, a + b);
 
 void Naive::add_bw_impl(
     const Tensor &, const Tensor &, const Tensor &, const Tensor &gy,
     Tensor &ga, Tensor &gb) {
-  const std::uint32_t size = gy.shape().volume();
-  const std::uint32_t bs = gy.shape().batch();
-  const std::uint32_t skip_a = ga.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb.shape().has_batch() * size;
   const float *pgy = CDATA(gy);
   float *pga = MDATA(ga);
   float *pgb = MDATA(gb);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+  broadcast_runs(
+      ga.shape(), gb.shape(), gy.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
     for (std::uint32_t i = 0; i < size; ++i) {
-      const float k = pgy[i];
-      pga[i] += k;
-      pgb[i] += k;
+      const float k = pgy[oy + i];
+      pga[oa + i * sa] += k;
+      pgb[ob + i * sb] += k;
     }
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  });
 }
 
 }  // namespace devices
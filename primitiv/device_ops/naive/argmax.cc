@@ -6,16 +6,14 @@
 namespace primitiv {
 namespace devices {
 
-std::vector<std::uint32_t> Naive::argmax_impl(
-    const Tensor &x, std::uint32_t dim) {
+void Naive::argmax_impl(
+    const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   const Shape &s = x.shape();
   const std::uint32_t n = s[dim];
   const std::uint32_t repeat = s.size() / n;
   const std::uint32_t skip1 = s.lower_volume(dim);
   const std::uint32_t skip2 = skip1 * n;
   const float *src = CDATA(x);
-  std::vector<std::uint32_t> ret;
-  ret.reserve(repeat);
   for (std::uint32_t i = 0; i < repeat; ++i) {
     std::uint32_t offset = i % skip1 + (i / skip1) * skip2;
     float max_val = src[offset];
@@ -27,9 +25,8 @@ std::vector<std::uint32_t> Naive::argmax_impl(
         argmax_val = j;
       }
     }
-    ret.emplace_back(argmax_val);
+    ids[i] = argmax_val;
   }
-  return ret;
 }
 
 }  // namespace devices
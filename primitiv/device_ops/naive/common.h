@@ -1,6 +1,8 @@
 #ifndef PRIMITIV_DEVICE_OPS_COMMON_NAIVE_H_
 #define PRIMITIV_DEVICE_OPS_COMMON_NAIVE_H_
 
+#include <primitiv/device_ops/broadcast.h>
+
 #define MAYBE_USED(x) static_cast<void>(x)
 
 #define CDATA(x) static_cast<const float *>(get_handle(x))
@@ -17,17 +19,23 @@ void Naive::name##_fw_impl(const Tensor &x, Tensor &y) { \
   REPEAT_OP(i, size, dest[i] = (op)); \
 }
 
-#define CPUDEV_BW_X(name, op) \
-void Naive::name##_bw_impl( \
+// Backward kernels of element-wise operations are defined in both the
+// accumulating (`+=`) and the overwriting (`=`) variants.
+#define CPUDEV_BW_X_KERNEL(fname, update, op) \
+void Naive::fname( \
     const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) { \
   const float *px = CDATA(x); MAYBE_USED(px); \
   const float *py = CDATA(y); MAYBE_USED(py); \
   const float *pgy = CDATA(gy); \
   float *pgx = MDATA(gx); \
   const std::uint32_t size = x.shape().size(); \
-  REPEAT_OP(i, size, pgx[i] += (op)); \
+  REPEAT_OP(i, size, pgx[i] update (op)); \
 }
 
+#define CPUDEV_BW_X(name, op) \
+  CPUDEV_BW_X_KERNEL(name##_bw_impl, +=, op) \
+  CPUDEV_BW_X_KERNEL(name##_bw_overwrite_impl, =, op)
+
 #define CPUDEV_FW_X_CONST(name, op) \
 void Naive::name##_fw_impl(const Tensor &x, float k, Tensor &y) { \
   float *dest = MDATA(y); \
@@ -36,8 +44,8 @@ void Naive::name##_fw_impl(const Tensor &x, float k, Tensor &y) { \
   REPEAT_OP(i, size, dest[i] = (op)); \
 }
 
-#define CPUDEV_BW_X_CONST(name, op) \
-void Naive::name##_bw_impl( \
+#define CPUDEV_BW_X_CONST_KERNEL(fname, update, op) \
+void Naive::fname( \
     const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) { \
   MAYBE_USED(k); \
   const float *px = CDATA(x); MAYBE_USED(px); \
@@ -45,9 +53,13 @@ void Naive::name##_bw_impl( \
   const float *pgy = CDATA(gy); \
   float *pgx = MDATA(gx); \
   const std::uint32_t size = x.shape().size(); \
-  REPEAT_OP(i, size, pgx[i] += (op)); \
+  REPEAT_OP(i, size, pgx[i] update (op)); \
 }
 
+#define CPUDEV_BW_X_CONST(name, op) \
+  CPUDEV_BW_X_CONST_KERNEL(name##_bw_impl, +=, op) \
+  CPUDEV_BW_X_CONST_KERNEL(name##_bw_overwrite_impl, =, op)
+
 #define CPUDEV_FW_X_SCALAR(name, op) \
 void Naive::name##_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) { \
   const std::uint32_t size = y.shape().volume(); \
@@ -65,21 +77,22 @@ void Naive::name##_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) { \
   } \
 }
 
+// `op` is an expression of the scalar values `a` and `b` of both operands.
 #define CPUDEV_FW_AB(name, op) \
-void Naive::name##_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) { \
-  const std::uint32_t size = y.shape().volume(); \
-  const std::uint32_t bs = y.shape().batch(); \
-  const std::uint32_t skip_a = a.shape().has_batch() * size; \
-  const std::uint32_t skip_b = b.shape().has_batch() * size; \
-  float *dest = MDATA(y); \
-  const float *src_a = CDATA(a); \
-  const float *src_b = CDATA(b); \
-  for (std::uint32_t batch = 0; batch < bs; ++batch) { \
-    REPEAT_OP(i, size, dest[i] = (op)); \
-    dest += size; \
-    src_a += skip_a; \
-    src_b += skip_b; \
-  } \
+void Naive::name##_fw_impl(const Tensor &a_, const Tensor &b_, Tensor &y_) { \
+  float *dest = MDATA(y_); \
+  const float *src_a = CDATA(a_); \
+  const float *src_b = CDATA(b_); \
+  broadcast_runs( \
+      a_.shape(), b_.shape(), y_.shape(), \
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa, \
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) { \
+    for (std::uint32_t i = 0; i < size; ++i) { \
+      const float a = src_a[oa + i * sa]; \
+      const float b = src_b[ob + i * sb]; \
+      dest[oy + i] = (op); \
+    } \
+  }); \
 }
 
 #endif  // PRIMITIV_DEVICE_OPS_COMMON_NAIVE_H_
@@ -9,6 +9,7 @@ namespace devices {
 void Naive::copy_tensor_impl(const Tensor &x, Tensor &y) {
   switch (x.device().type()) {
     case Device::DeviceType::NAIVE:
+    case Device::DeviceType::EIGEN:
       reset_tensor_by_array(CDATA(x), y);
       break;
     default:
@@ -16,32 +16,26 @@ CPUDEV_FW_X_SCALAR(divide_scalar_r, src_x[i] / *src_k);
 
 CPUDEV_FW_X_SCALAR(divide_scalar_l, *src_k / src_x[i]);
 
-CPUDEV_FW_AB(divide, src_a[i] / src_b[i]);
+CPUDEV_FW_AB(divide, a / b);
 
 void Naive::divide_bw_impl(
     const Tensor &, const Tensor &b, const Tensor &y, const Tensor &gy,
     Tensor &ga, Tensor &gb) {
-  const std::uint32_t size = gy.shape().volume();
-  const std::uint32_t bs = gy.shape().batch();
-  const std::uint32_t skip_a = ga.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb.shape().has_batch() * size;
   const float *pb = CDATA(b);
   const float *py = CDATA(y);
   const float *pgy = CDATA(gy);
   float *pga = MDATA(ga);
   float *pgb = MDATA(gb);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+  broadcast_runs(
+      ga.shape(), gb.shape(), gy.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
     for (std::uint32_t i = 0; i < size; ++i) {
-      const float k = pgy[i] / pb[i];
-      pga[i] += k;
-      pgb[i] -= k * py[i];
+      const float k = pgy[oy + i] / pb[ob + i * sb];
+      pga[oa + i * sa] += k;
+      pgb[ob + i * sb] -= k * py[oy + i];
     }
-    pb += skip_b;
-    py += size;
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  });
 }
 
 }  // namespace devices
@@ -0,0 +1,57 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+
+#include <primitiv/naive_device.h>
+#include <primitiv/device_ops/naive/common.h>
+
+namespace {
+
+// Scaling factor of kept elements.
+inline float dropout_scale(float rate) {
+  return rate < 1 ? 1 / (1 - rate) : 0;
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+Shape Naive::dropout_mask_shape(const Shape &shape) const {
+  // Each bit represents whether the corresponding element is kept or not.
+  return Shape({(shape.size() + 31) / 32});
+}
+
+void Naive::dropout_fw_impl(
+    const Tensor &x, float rate, Tensor &mask, Tensor &y) {
+  randomizer_.fill_bernoulli_bits(
+      1 - rate, x.shape().size(),
+      static_cast<std::uint32_t *>(get_mutable_handle(mask)));
+  dropout_bw_overwrite_impl(x, mask, rate, y);
+}
+
+#define CPUDEV_DROPOUT_BW_KERNEL(fname, update) \
+void Naive::fname( \
+    const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) { \
+  const float *pgy = CDATA(gy); \
+  const std::uint32_t *pmask = \
+    static_cast<const std::uint32_t *>(get_handle(mask)); \
+  float *pgx = MDATA(gx); \
+  const float k = ::dropout_scale(rate); \
+  const std::uint32_t size = gy.shape().size(); \
+  for (std::uint32_t i = 0; i < size; i += 32) { \
+    const std::uint32_t bits = pmask[i / 32]; \
+    const std::uint32_t n = std::min(32u, size - i); \
+    for (std::uint32_t j = 0; j < n; ++j) { \
+      pgx[i + j] update ((bits >> j) & 1) ? k * pgy[i + j] : 0; \
+    } \
+  } \
+}
+
+CPUDEV_DROPOUT_BW_KERNEL(dropout_bw_impl, +=);
+CPUDEV_DROPOUT_BW_KERNEL(dropout_bw_overwrite_impl, =);
+
+#undef CPUDEV_DROPOUT_BW_KERNEL
+
+}  // namespace devices
+}  // namespace primitiv
@@ -1,5 +1,7 @@
 #include <primitiv/config.h>
 
+#include <cmath>
+
 #include <primitiv/naive_device.h>
 #include <primitiv/device_ops/naive/common.h>
 
@@ -3,6 +3,30 @@
 #include <primitiv/naive_device.h>
 #include <primitiv/device_ops/naive/common.h>
 
+namespace {
+
+// Calculates y += op(a) . op(b), where op(x) = x^T if transpose_x is true, or
+// x. Shapes of op(a), op(b) and y are {d1, d2}, {d2, d3} and {d1, d3}.
+void gemm(
+    const float *a, const float *b, bool transpose_a, bool transpose_b,
+    std::uint32_t d1, std::uint32_t d2, std::uint32_t d3, float *y) {
+  const std::uint32_t a_i = transpose_a ? d2 : 1;
+  const std::uint32_t a_j = transpose_a ? 1 : d1;
+  const std::uint32_t b_j = transpose_b ? d3 : 1;
+  const std::uint32_t b_k = transpose_b ? 1 : d2;
+  for (std::uint32_t k = 0; k < d3; ++k) {
+    for (std::uint32_t i = 0; i < d1; ++i) {
+      float tmp = 0;
+      for (std::uint32_t j = 0; j < d2; ++j) {
+        tmp += a[i * a_i + j * a_j] * b[j * b_j + k * b_k];
+      }
+      y[i + k * d1] += tmp;
+    }
+  }
+}
+
+}  // namespace
+
 namespace primitiv {
 namespace devices {
 
@@ -50,11 +74,73 @@ void Naive::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
 }
 
 void Naive::matmul_bw_impl(
-    const Tensor &a, const Tensor &b, const Tensor &, const Tensor &gy,
+    const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
     Tensor &ga, Tensor &gb) {
-  // TODO(odashi): This code could be slow and requires memory. Fix this.
-  inplace_add_impl(matmul_fw(gy, transpose_fw(b)), ga);
-  inplace_add_impl(matmul_fw(transpose_fw(a), gy), gb);
+  matmul_transposed_bw_impl(a, b, y, gy, false, false, ga, gb);
+}
+
+void Naive::matmul_transposed_fw_impl(
+    const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b,
+    Tensor &y) {
+  const std::uint32_t d1 = y.shape()[0];
+  const std::uint32_t d2 = a.shape()[transpose_a ? 0 : 1];
+  const std::uint32_t d3 = y.shape()[1];
+  const std::uint32_t bs = y.shape().batch();
+  const std::uint32_t dest_shift = d1 * d3;
+  const std::uint32_t src_a_shift = a.shape().has_batch() * d1 * d2;
+  const std::uint32_t src_b_shift = b.shape().has_batch() * d2 * d3;
+
+  float *dest = MDATA(y);
+  const float *src_a = CDATA(a);
+  const float *src_b = CDATA(b);
+
+  for (std::uint32_t n = 0; n < dest_shift * bs; ++n) {
+    dest[n] = 0;
+  }
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    gemm(src_a, src_b, transpose_a, transpose_b, d1, d2, d3, dest);
+    dest += dest_shift;
+    src_a += src_a_shift;
+    src_b += src_b_shift;
+  }
+}
+
+void Naive::matmul_transposed_bw_impl(
+    const Tensor &a, const Tensor &b, const Tensor &, const Tensor &gy,
+    bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb) {
+  const std::uint32_t d1 = gy.shape()[0];
+  const std::uint32_t d2 = a.shape()[transpose_a ? 0 : 1];
+  const std::uint32_t d3 = gy.shape()[1];
+  const std::uint32_t bs = gy.shape().batch();
+  const std::uint32_t gy_shift = d1 * d3;
+  const std::uint32_t a_shift = a.shape().has_batch() * d1 * d2;
+  const std::uint32_t b_shift = b.shape().has_batch() * d2 * d3;
+
+  const float *src_a = CDATA(a);
+  const float *src_b = CDATA(b);
+  const float *src_gy = CDATA(gy);
+  float *dest_ga = MDATA(ga);
+  float *dest_gb = MDATA(gb);
+
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    // ga += gy . op(b)^T, or op(b) . gy^T if a is transposed.
+    if (transpose_a) {
+      gemm(src_b, src_gy, transpose_b, true, d2, d3, d1, dest_ga);
+    } else {
+      gemm(src_gy, src_b, false, !transpose_b, d1, d3, d2, dest_ga);
+    }
+    // gb += op(a)^T . gy, or gy^T . op(a) if b is transposed.
+    if (transpose_b) {
+      gemm(src_gy, src_a, true, transpose_a, d3, d1, d2, dest_gb);
+    } else {
+      gemm(src_a, src_gy, !transpose_a, false, d2, d1, d3, dest_gb);
+    }
+    src_a += a_shift;
+    src_b += b_shift;
+    src_gy += gy_shift;
+    dest_ga += a_shift;
+    dest_gb += b_shift;
+  }
 }
 
 }  // namespace devices
@@ -17,5 +17,10 @@ std::shared_ptr<void> Naive::new_handle(const Shape &shape) {
   return std::shared_ptr<void>(data, std::free);
 }
 
+std::shared_ptr<void> Naive::new_view_handle(
+    const Tensor &x, std::size_t offset) {
+  return get_view_handle<float>(x, offset);
+}
+
 }  // namespace devices
 }  // namespace primitiv
@@ -1,5 +1,7 @@
 #include <primitiv/config.h>
 
+#include <cmath>
+
 #include <primitiv/naive_device.h>
 #include <primitiv/device_ops/naive/common.h>
 
@@ -16,34 +18,28 @@ CPUDEV_FW_X_SCALAR(pow_scalar_r, std::pow(src_x[i], *src_k));
 
 CPUDEV_FW_X_SCALAR(pow_scalar_l, std::pow(*src_k, src_x[i]));
 
-CPUDEV_FW_AB(pow, std::pow(src_a[i], src_b[i]));
+CPUDEV_FW_AB(pow, std::pow(a, b));
 
 void Naive::pow_bw_impl(
     const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
     Tensor &ga, Tensor &gb) {
-  const std::uint32_t size = gy.shape().volume();
-  const std::uint32_t bs = gy.shape().batch();
-  const std::uint32_t skip_a = ga.shape().has_batch() * size;
-  const std::uint32_t skip_b = gb.shape().has_batch() * size;
   const float *pa = CDATA(a);
   const float *pb = CDATA(b);
   const float *py = CDATA(y);
   const float *pgy = CDATA(gy);
   float *pga = MDATA(ga);
   float *pgb = MDATA(gb);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+  broadcast_runs(
+      ga.shape(), gb.shape(), gy.shape(),
+      [&](std::uint32_t oy, std::uint32_t oa, std::uint32_t sa,
+          std::uint32_t ob, std::uint32_t sb, std::uint32_t size) {
     for (std::uint32_t i = 0; i < size; ++i) {
-      const float a = pgy[i] * py[i];
-      pga[i] += a * pb[i] / pa[i];
-      pgb[i] += a * std::log(pa[i]);
+      const float va = pa[oa + i * sa];
+      const float k = pgy[oy + i] * py[oy + i];
+      pga[oa + i * sa] += k * pb[ob + i * sb] / va;
+      pgb[ob + i * sb] += k * std::log(va);
     }
-    pa += skip_a;
-    pb += skip_b;
-    py += size;
-    pgy += size;
-    pga += skip_a;
-    pgb += skip_b;
-  }
+  });
 }
 
 }  // namespace devices
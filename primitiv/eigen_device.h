@@ -23,17 +23,21 @@ public:
    */
   explicit Eigen(std::uint32_t seed) : randomizer_(seed) {}
 
-  ~Eigen() override = default;
+  ~Eigen() override { finalize_async(); }
 
   void dump_description() const override;
   Device::DeviceType type() const override { return Device::DeviceType::EIGEN; }
 
 private:
   std::shared_ptr<void> new_handle(const Shape &shape) override;
+  std::shared_ptr<void> new_view_handle(const Tensor &x, std::size_t offset) override;
+  bool supports_dims_broadcast() const override { return true; }
+  bool supports_async() const override { return true; }
+  bool uses_host_memory() const override { return true; }
 
-  std::vector<float> tensor_to_vector_impl(const Tensor &x) override;
-  std::vector<std::uint32_t> argmax_impl(const Tensor &x, std::uint32_t dim) override;
-  std::vector<std::uint32_t> argmin_impl(const Tensor &x, std::uint32_t dim) override;
+  void tensor_to_array_impl(const Tensor &x, float values[]) override;
+  void argmax_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) override;
+  void argmin_impl(const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) override;
 
   void reset_tensor_impl(float k, Tensor &x) override;
   void reset_tensor_by_array_impl(const float values[], Tensor &x) override;
@@ -103,6 +107,26 @@ private:
 
   void pown_bw_impl(const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k, Tensor &gx) override;
 
+  void sqrt_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void exp_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void log_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void tanh_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void sigmoid_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void softplus_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void sin_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void cos_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void tan_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, Tensor &gx) override;
+  void add_const_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void subtract_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void subtract_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void multiply_const_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void divide_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void divide_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void pow_const_r_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void pow_const_l_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void prelu_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+  void elu_bw_overwrite_impl(const Tensor &x, const Tensor &y, const Tensor &gy, float k, Tensor &gx) override;
+
   void add_scalar_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
   void subtract_scalar_r_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
   void subtract_scalar_l_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
@@ -137,6 +161,12 @@ private:
   void matmul_bw_impl(
       const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
       Tensor &ga, Tensor &gb) override;
+  void matmul_transposed_fw_impl(
+      const Tensor &a, const Tensor &b, bool transpose_a, bool transpose_b,
+      Tensor &y) override;
+  void matmul_transposed_bw_impl(
+      const Tensor &a, const Tensor &b, const Tensor &y, const Tensor &gy,
+      bool transpose_a, bool transpose_b, Tensor &ga, Tensor &gb) override;
 
   void max_fw_impl(const Tensor &x, std::uint32_t dim, Tensor &y) override;
   void min_fw_impl(const Tensor &x, std::uint32_t dim, Tensor &y) override;
@@ -182,6 +212,11 @@ private:
       std::uint32_t stride0, std::uint32_t stride1,
       Tensor &gx) override;
 
+  Shape dropout_mask_shape(const Shape &shape) const override;
+  void dropout_fw_impl(const Tensor &x, float rate, Tensor &mask, Tensor &y) override;
+  void dropout_bw_impl(const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) override;
+  void dropout_bw_overwrite_impl(const Tensor &gy, const Tensor &mask, float rate, Tensor &gx) override;
+
   void inplace_multiply_const_impl(float k, Tensor &x) override;
 
   void inplace_add_impl(const Tensor &x, Tensor &y) override;
@@ -22,6 +22,12 @@ public:
     OPTIMIZER = 0x400,
   };
 
+  enum class Precision : std::int8_t {
+    FLOAT32  = 0x0,
+    FLOAT16  = 0x1,
+    BFLOAT16 = 0x2,
+  };
+
   static void assert_version(std::uint32_t major, std::uint32_t minor) {
     if (major != CurrentVersion::MAJOR || minor != CurrentVersion::MINOR) {
       PRIMITIV_THROW_ERROR(
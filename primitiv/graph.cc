@@ -1,10 +1,14 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <sstream>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
+#include <primitiv/device.h>
 #include <primitiv/error.h>
 #include <primitiv/functions.h>
 #include <primitiv/graph.h>
@@ -18,8 +22,21 @@ using std::vector;
 
 namespace primitiv {
 
+Graph::~Graph() {
+  clear();
+}
+
 void Graph::clear() {
+  // The arena never calls destructors. Nodes in the arena are destroyed here,
+  // and operators are destroyed by their deleters.
+  for (OperatorInfo &f : ops_) {
+    for (NodeInfo &n : f.rets) n.~NodeInfo();
+  }
   ops_.clear();
+  cse_table_.clear();
+  release_candidates_.clear();
+  first_unforwarded_ = 0;
+  arena_.reset();
 }
 
 #define CHECK_NODE(n) { \
@@ -42,9 +59,24 @@ void Graph::clear() {
 
 vector<Node> Graph::add_operator(
     std::unique_ptr<Operator> &&op, const std::vector<Node> &args) {
+  const std::uint32_t retn = op->num_returns();
+  const std::uint32_t ret_oid = add_operator_inner(
+      OperatorPtr(op.release(), OperatorDeleter { false }),
+      args.data(), args.size());
+
+  // Creates Node objects.
+  vector<Node> nodes;
+  nodes.reserve(retn);
+  for (std::uint32_t i = 0; i < retn; ++i) {
+    nodes.emplace_back(Node { *this, ret_oid, i });
+  }
+  return nodes;
+}
+
+std::uint32_t Graph::add_operator_inner(
+    OperatorPtr &&op, const Node *args, std::uint32_t argn) {
   const std::uint32_t argn_req = op->num_arguments();
   const std::uint32_t retn = op->num_returns();
-  const std::uint32_t argn = args.size();
 
   // Checks the number of arguments.
   if (argn_req == Operator::NONZERO) {
@@ -75,82 +107,457 @@ vector<Node> Graph::add_operator(
   }
 
   // Gathers information of arguments.
-  vector<Address> arg_addrs(argn);
-  vector<const Shape *> arg_shapes(argn);
+  arg_shapes_.resize(argn);
   for (std::uint32_t i = 0; i < argn; ++i) {
     const Node &arg = args[i];
     CHECK_NODE(arg);
-    arg_addrs[i] = { arg.oid_, arg.vid_ };
-    arg_shapes[i] = &ops_[arg.oid_].rets[arg.vid_].shape;
+    arg_shapes_[i] = &ops_[arg.oid_].rets[arg.vid_].shape;
   }
 
-  // Makes nodes of return values.
-  vector<NodeInfo> rets(retn);
-  vector<Shape *> ret_shapes(retn);
+  // Reuses the existing operator which calculates the same values.
+  std::size_t hash = 0;
+  if (simplification_) {
+    hash = typeid(*op).hash_code();
+    for (std::uint32_t i = 0; i < argn; ++i) {
+      hash = hash * 1000003u ^ (std::size_t(args[i].oid_) << 8 | args[i].vid_);
+    }
+    const auto range = cse_table_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (can_reuse(it->second, *op, args, argn)) return it->second;
+    }
+  }
+
+  // Return values require gradients if the operator refers a Parameter, or
+  // propagates gradients to any argument which requires gradients.
+  bool requires_grad = op->get_parameter() != nullptr;
+  if (op->propagates_gradients()) {
+    for (std::uint32_t i = 0; i < argn; ++i) {
+      requires_grad = requires_grad ||
+        ops_[args[i].oid_].rets[args[i].vid_].requires_grad;
+    }
+  }
+
+  // Makes nodes of return values in the arena.
+  NodeInfo *rets = arena_.allocate_array<NodeInfo>(retn);
+  ret_shapes_.resize(retn);
   for (std::uint32_t i = 0; i < retn; ++i) {
+    new (&rets[i]) NodeInfo();
     rets[i].device = ret_device;
-    ret_shapes[i] = &rets[i].shape;
+    rets[i].requires_grad = requires_grad;
+    ret_shapes_[i] = &rets[i].shape;
   }
 
   // Calculates the shape of the resulting value.
   // This may throw an exception when trying an invalid operation.
-  op->forward_shape(arg_shapes, ret_shapes);
+  try {
+    op->forward_shape(arg_shapes_, ret_shapes_);
+  } catch (...) {
+    for (std::uint32_t i = 0; i < retn; ++i) rets[i].~NodeInfo();
+    throw;
+  }
 
   // Updates the graph.
+  Address *arg_addrs = arena_.allocate_array<Address>(argn);
+  for (std::uint32_t i = 0; i < argn; ++i) {
+    arg_addrs[i] = { args[i].oid_, args[i].vid_ };
+    ++ops_[args[i].oid_].rets[args[i].vid_].num_uses;
+  }
   const std::uint32_t ret_oid = ops_.size();
-  //for (const Address &arg_addr : arg_addrs) {
-  //  ops_[arg_addr.oid].rets[arg_addr.vid].sinks.emplace_back(ret_oid);
-  //}
-  ops_.emplace_back(OperatorInfo { move(op), move(arg_addrs), move(rets) });
+  ops_.emplace_back(OperatorInfo {
+      move(op), { arg_addrs, argn }, { rets, retn } });
+  if (simplification_) cse_table_.emplace(hash, ret_oid);
+  return ret_oid;
+}
 
-  // Creates Node objects.
-  vector<Node> nodes;
-  nodes.reserve(retn);
-  for (std::uint32_t i = 0; i < retn; ++i) {
-    nodes.emplace_back(Node { *this, ret_oid, i });
+bool Graph::can_reuse(
+    std::uint32_t oid, const Operator &op,
+    const Node *args, std::uint32_t argn) const {
+  const OperatorInfo &f = ops_[oid];
+  if (f.args.size() != argn || !f.op->equals(op)) return false;
+  for (std::uint32_t i = 0; i < argn; ++i) {
+    if (f.args[i].oid != args[i].oid_ || f.args[i].vid != args[i].vid_) {
+      return false;
+    }
   }
-  return nodes;
+  for (const NodeInfo &n : f.rets) {
+    if (n.donated || n.released) return false;
+  }
+  return true;
 }
 
 const Tensor &Graph::forward(const Node &node) {
   CHECK_NODE(node);
+  const Address addr { node.oid_, node.vid_ };
+  const bool discards = checkpointing_ && !inference_mode_;
+  vector<Address> computed;
+  vector<Address> *computed_ptr = discards ? &computed : nullptr;
+  if (inference_mode_) release_values(addr);
+  if (autobatching_) forward_batched(addr, computed_ptr);
+  const Tensor *value = forward_recursive(addr, computed_ptr);
+  if (discards) discard_values(computed, addr);
+  return *value;
+}
+
+const Tensor *Graph::forward_recursive(
+    Address addr, vector<Address> *computed) {
+  OperatorInfo &cur_f = ops_[addr.oid];
+
+  if (cur_f.op->has_inner_values()) {
+    return cur_f.op->get_inner_values()[addr.vid];
+  }
 
-  std::function<const Tensor *(const Address)> forward_recursive = [&](
-      const Address addr) -> const Tensor * {
-    OperatorInfo &cur_f = ops_[addr.oid];
+  NodeInfo &cur_n = cur_f.rets[addr.vid];
+  if (cur_n.donated) {
+    PRIMITIV_THROW_ERROR(
+        "The value of the node is already donated to another operator. "
+        "oid: " << addr.oid << ", vid: " << addr.vid);
+  }
+  if (cur_n.released) {
+    PRIMITIV_THROW_ERROR(
+        "The value of the node is already released in the inference mode. "
+        "oid: " << addr.oid << ", vid: " << addr.vid);
+  }
+  if (cur_n.value.valid()) {
+    return &cur_n.value;
+  }
 
-    if (cur_f.op->has_inner_values()) {
-      return cur_f.op->get_inner_values()[addr.vid];
+  // Gathers arguments and return values.
+  vector<const Tensor *> args_v;
+  vector<Tensor *> rets_v;
+  args_v.reserve(cur_f.args.size());
+  rets_v.reserve(cur_f.rets.size());
+  for (const Address arg : cur_f.args) {
+    args_v.emplace_back(forward_recursive(arg, computed));
+  }
+  for (NodeInfo &ret : cur_f.rets) {
+    rets_v.emplace_back(&ret.value);
+  }
+
+  // Calculates the value.
+  if (buffer_donation_ && !checkpointing_ && can_donate(addr.oid)) {
+    // Moves the value of the first argument to the return value, and
+    // overwrites it.
+    const Address arg = cur_f.args[0];
+    NodeInfo &arg_n = ops_[arg.oid].rets[arg.vid];
+    cur_n.value = move(arg_n.value);
+    arg_n.donated = true;
+    arg_n.donee = addr.oid;
+    args_v[0] = &cur_n.value;
+    cur_f.op->forward_inplace(args_v, cur_n.value);
+  } else {
+    cur_f.op->forward(args_v, rets_v);
+  }
+  finish_forward(addr.oid, computed);
+
+  return &cur_n.value;
+}
+
+void Graph::forward_batched(Address addr, vector<Address> *computed) {
+  // Skips operators which are already calculated so that each forward()
+  // scans only the operators added after the previous one.
+  auto forwarded = [&](std::uint32_t oid) {
+    const OperatorInfo &f = ops_[oid];
+    if (f.op->has_inner_values()) return true;
+    for (const NodeInfo &n : f.rets) {
+      if (!n.value.valid() && !n.donated && !n.released) return false;
+    }
+    return true;
+  };
+  while (first_unforwarded_ < ops_.size() && forwarded(first_unforwarded_)) {
+    ++first_unforwarded_;
+  }
+  const std::uint32_t begin = first_unforwarded_;
+  if (addr.oid < begin) return;
+
+  // Marks operators which should be calculated.
+  // If some value is not available, does nothing here and leaves reporting
+  // the error to `forward_recursive()`.
+  // Operators before `begin` are never marked.
+  vector<bool> needed(addr.oid + 1 - begin, false);
+  auto require = [&](Address a) {
+    const OperatorInfo &f = ops_[a.oid];
+    const NodeInfo &n = f.rets[a.vid];
+    if (f.op->has_inner_values() || n.value.valid()) return true;
+    if (n.donated || n.released) return false;
+    needed[a.oid - begin] = true;
+    return true;
+  };
+  if (!require(addr)) return;
+  for (std::uint32_t oid = addr.oid + 1; oid-- > begin; ) {
+    if (!needed[oid - begin]) continue;
+    for (const Address arg : ops_[oid].args) {
+      if (!require(arg)) return;
     }
+  }
 
-    NodeInfo &cur_n = cur_f.rets[addr.vid];
-    if (cur_n.value.valid()) {
-      return &cur_n.value;
+  // Splits operators into levels by the depth from already-calculated nodes.
+  // Operators in the same level never depend on each other.
+  vector<std::uint32_t> depth(addr.oid + 1 - begin, 0);
+  vector<vector<std::uint32_t>> levels;
+  for (std::uint32_t oid = begin; oid <= addr.oid; ++oid) {
+    if (!needed[oid - begin]) continue;
+    std::uint32_t d = 0;
+    for (const Address arg : ops_[oid].args) {
+      if (arg.oid >= begin && needed[arg.oid - begin]) {
+        d = std::max(d, depth[arg.oid - begin] + 1);
+      }
     }
+    depth[oid - begin] = d;
+    if (d >= levels.size()) levels.resize(d + 1);
+    levels[d].emplace_back(oid);
+  }
+
+  struct Group {
+    vector<std::uint32_t> oids;
+    vector<bool> shared;
+  };
 
-    // Gathers arguments and return values.
-    vector<const Tensor *> args_v;
-    vector<Tensor *> rets_v;
-    args_v.reserve(cur_f.args.size());
-    rets_v.reserve(cur_f.rets.size());
-    for (const Address arg : cur_f.args) {
-      args_v.emplace_back(forward_recursive(arg));
+  // Checks whether the operator can be added to the group, and updates
+  // shared arguments of the group.
+  auto join = [&](Group &group, std::uint32_t oid) {
+    const OperatorInfo &a = ops_[group.oids[0]];
+    const OperatorInfo &b = ops_[oid];
+    const NodeInfo &ya = a.rets[0];
+    const NodeInfo &yb = b.rets[0];
+    if (!a.op->is_batchable_with(*b.op) ||
+        a.args.size() != b.args.size() ||
+        ya.device != yb.device ||
+        !ya.shape.has_same_dims(yb.shape)) {
+      return false;
     }
-    for (NodeInfo &ret : cur_f.rets) {
-      rets_v.emplace_back(&ret.value);
+    vector<bool> shared(a.args.size());
+    for (std::uint32_t i = 0; i < a.args.size(); ++i) {
+      const Address &arg_a = a.args[i];
+      const Address &arg_b = b.args[i];
+      const NodeInfo &xa = ops_[arg_a.oid].rets[arg_a.vid];
+      const NodeInfo &xb = ops_[arg_b.oid].rets[arg_b.vid];
+      shared[i] =
+        arg_a.oid == arg_b.oid && arg_a.vid == arg_b.vid &&
+        xa.shape.batch() == 1;
+      if (!group.shared.empty() && shared[i] != group.shared[i]) {
+        return false;
+      }
+      // Concatenated arguments should have the same minibatch size as the
+      // return value of each operator.
+      if (!shared[i] &&
+          (!xa.shape.has_same_dims(xb.shape) ||
+           xa.device != xb.device ||
+           xa.shape.batch() != ya.shape.batch() ||
+           xb.shape.batch() != yb.shape.batch())) {
+        return false;
+      }
     }
+    group.oids.emplace_back(oid);
+    group.shared = move(shared);
+    return true;
+  };
 
-    // Calculates the value.
-    cur_f.op->forward(args_v, rets_v);
+  for (const vector<std::uint32_t> &level : levels) {
+    vector<Group> groups;
+    for (const std::uint32_t oid : level) {
+      bool joined = false;
+      for (Group &group : groups) {
+        if (join(group, oid)) {
+          joined = true;
+          break;
+        }
+      }
+      if (!joined) groups.emplace_back(Group { { oid }, {} });
+    }
 
-    return &cur_n.value;
-  };
+    for (const Group &group : groups) {
+      if (group.oids.size() > 1) {
+        forward_group(group.oids, group.shared, computed);
+        continue;
+      }
+      const std::uint32_t oid = group.oids[0];
+      for (std::uint32_t vid = 0; vid < ops_[oid].rets.size(); ++vid) {
+        const NodeInfo &n = ops_[oid].rets[vid];
+        if (!n.value.valid() && !n.donated && !n.released) {
+          forward_recursive(Address { oid, vid }, computed);
+        }
+      }
+    }
+  }
+}
+
+void Graph::forward_group(
+    const vector<std::uint32_t> &oids, const vector<bool> &shared,
+    vector<Address> *computed) {
+  const OperatorInfo &rep_f = ops_[oids[0]];
+  const std::uint32_t argn = rep_f.args.size();
+
+  // Concatenates arguments along the minibatch.
+  vector<Tensor> xs(argn);
+  vector<const Tensor *> args_v(argn);
+  for (std::uint32_t i = 0; i < argn; ++i) {
+    const Address &rep_arg = rep_f.args[i];
+    if (shared[i]) {
+      args_v[i] = forward_recursive(rep_arg, computed);
+      continue;
+    }
+    vector<const Tensor *> parts;
+    parts.reserve(oids.size());
+    for (const std::uint32_t oid : oids) {
+      parts.emplace_back(forward_recursive(ops_[oid].args[i], computed));
+    }
+    Device &dev = *ops_[rep_arg.oid].rets[rep_arg.vid].device;
+    xs[i] = dev.batch_concat_fw(parts);
+    args_v[i] = &xs[i];
+  }
+
+  // Calculates all operators at once, and splits the result.
+  Tensor y;
+  rep_f.op->forward(args_v, vector<Tensor *> { &y });
+  Device &dev = *rep_f.rets[0].device;
+  std::uint32_t lower = 0;
+  for (const std::uint32_t oid : oids) {
+    NodeInfo &n = ops_[oid].rets[0];
+    const std::uint32_t upper = lower + n.shape.batch();
+    n.value = dev.batch_slice_fw(y, lower, upper);
+    lower = upper;
+    finish_forward(oid, computed);
+  }
+}
+
+void Graph::finish_forward(std::uint32_t oid, vector<Address> *computed) {
+  const OperatorInfo &cur_f = ops_[oid];
+  if (computed) {
+    for (std::uint32_t i = 0; i < cur_f.rets.size(); ++i) {
+      computed->emplace_back(Address { oid, i });
+    }
+  }
 
-  return *forward_recursive(Address { node.oid_, node.vid_ });
+  // Arguments which are no longer used are released at the next forward(),
+  // because the user may still add new operators referring them.
+  if (!inference_mode_) return;
+  for (const Address arg : cur_f.args) {
+    NodeInfo &arg_n = ops_[arg.oid].rets[arg.vid];
+    ++arg_n.num_finished_uses;
+    if (arg_n.num_finished_uses == arg_n.num_uses) {
+      release_candidates_.emplace_back(arg);
+    }
+  }
+}
+
+void Graph::release_values(Address keep) {
+  bool kept = false;
+  for (const Address addr : release_candidates_) {
+    if (addr.oid == keep.oid && addr.vid == keep.vid) {
+      kept = true;
+      continue;
+    }
+    NodeInfo &n = ops_[addr.oid].rets[addr.vid];
+    if (n.num_finished_uses == n.num_uses && n.value.valid()) {
+      n.value.invalidate();
+      n.released = true;
+    }
+  }
+  release_candidates_.clear();
+  if (kept) release_candidates_.emplace_back(keep);
 }
 
 void Graph::backward(const Node &node) {
   CHECK_NODE(node);
+  backward_inner(node, Tensor(), std::function<void(Parameter &)>());
+}
+
+void Graph::backward(
+    const Node &node, const std::function<void(Parameter &)> &callback) {
+  CHECK_NODE(node);
+  backward_inner(node, Tensor(), callback);
+}
+
+void Graph::backward(const Node &node, const Tensor &grad) {
+  CHECK_NODE(node);
+  const NodeInfo &n = ops_[node.oid_].rets[node.vid_];
+  if (grad.shape() != n.shape) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched. node.shape: " << n.shape.to_string()
+        << " != grad.shape: " << grad.shape().to_string());
+  }
+  if (&grad.device() != n.device) {
+    PRIMITIV_THROW_ERROR(
+        "Device mismatched. node.device: " << n.device
+        << " != grad.device: " << &grad.device());
+  }
+  backward_inner(node, grad, std::function<void(Parameter &)>());
+}
+
+void Graph::retain_gradient(const Node &node) {
+  CHECK_NODE(node);
+  NodeInfo &n = ops_[node.oid_].rets[node.vid_];
+  n.retain_grad = true;
+  if (n.requires_grad) return;
+
+  // The node and its descendants require gradients from now on.
+  n.requires_grad = true;
+  for (std::uint32_t oid = node.oid_ + 1; oid < ops_.size(); ++oid) {
+    OperatorInfo &cur_f = ops_[oid];
+    if (!cur_f.op->propagates_gradients()) continue;
+    bool requires_grad = false;
+    for (const Address &arg : cur_f.args) {
+      requires_grad = requires_grad ||
+        ops_[arg.oid].rets[arg.vid].requires_grad;
+    }
+    if (requires_grad) {
+      for (NodeInfo &cur_n : cur_f.rets) cur_n.requires_grad = true;
+    }
+  }
+}
+
+const Tensor &Graph::get_gradient(const Node &node) const {
+  CHECK_NODE(node);
+  const NodeInfo &n = ops_[node.oid_].rets[node.vid_];
+  if (!n.retain_grad || !n.grad.valid()) {
+    PRIMITIV_THROW_ERROR(
+        "Gradient of the node is not available. oid: " << node.oid_
+        << ", vid: " << node.vid_);
+  }
+  return n.grad;
+}
+
+void Graph::backward_inner(
+    const Node &node, const Tensor &grad,
+    const std::function<void(Parameter &)> &callback) {
+  if (inference_mode_) {
+    PRIMITIV_THROW_ERROR(
+        "Backpropagation is not available in the inference mode.");
+  }
+
+  // Discards retained gradients of the previous backpropagation.
+  for (std::uint32_t oid = 0; oid <= node.oid_; ++oid) {
+    for (NodeInfo &n : ops_[oid].rets) {
+      if (n.retain_grad) n.grad.invalidate();
+    }
+  }
+
+  // Counts operators referring each parameter to detect the last one.
+  std::unordered_map<Parameter *, std::uint32_t> num_refs;
+  if (callback) {
+    for (std::uint32_t oid = 0; oid <= node.oid_; ++oid) {
+      Parameter *param = ops_[oid].op->get_parameter();
+      if (param) ++num_refs[param];
+    }
+  }
+  auto notify = [&](const Operator &op) {
+    if (!callback) return;
+    Parameter *param = op.get_parameter();
+    if (param && --num_refs[param] == 0) callback(*param);
+  };
+
+  // Discards values of the finished operator for the gradient checkpointing.
+  // These values are no longer used because all users are already finished.
+  auto finish = [&](std::uint32_t oid) {
+    notify(*ops_[oid].op);
+    if (!checkpointing_ || oid == node.oid_) return;
+    for (std::uint32_t i = 0; i < ops_[oid].rets.size(); ++i) {
+      if (is_discardable(Address { oid, i })) {
+        ops_[oid].rets[i].value.invalidate();
+        first_unforwarded_ = std::min(first_unforwarded_, oid);
+      }
+    }
+  };
 
   OperatorInfo &last_f = ops_[node.oid_];
   NodeInfo &last_n = last_f.rets[node.vid_];
@@ -160,8 +567,11 @@ void Graph::backward(const Node &node) {
     forward(node);
   }
 
-  // Makes the identity gradient (dx/dx = 1) at the last node.
-  last_n.grad = functions::ones<Tensor>(last_n.shape, last_n.device);
+  // Makes the identity gradient (dx/dx = 1) at the last node, or uses the
+  // given gradient.
+  last_n.grad = grad.valid()
+    ? grad
+    : functions::ones<Tensor>(last_n.shape, last_n.device);
 
   // Performs the backpropagation.
   // NOTE(odashi):
@@ -177,36 +587,77 @@ void Graph::backward(const Node &node) {
     bool enabled = false;
     for (uint32_t i = 0; i < retn; ++i) {
       NodeInfo &cur_n = cur_f.rets[i];
-      rets_v[i] = &cur_n.value;
+      rets_v[i] = get_value(Address { static_cast<std::uint32_t>(oid), i });
       rets_g[i] = &cur_n.grad;
       enabled = enabled || cur_n.grad.valid();
     }
     if (!enabled) {
       // This operator is out of the forward path because all gradients of
       // return values are invalid.
+      finish(oid);
+      continue;
+    }
+
+    // Skips the operator if no Parameter exists in its ancestors.
+    bool required = cur_f.op->get_parameter() != nullptr;
+    if (cur_f.op->propagates_gradients()) {
+      for (const Address &arg : cur_f.args) {
+        required = required || ops_[arg.oid].rets[arg.vid].requires_grad;
+      }
+    }
+    if (!required) {
+      for (NodeInfo &cur_n : cur_f.rets) {
+        if (!cur_n.retain_grad) cur_n.grad.invalidate();
+      }
+      finish(oid);
       continue;
     }
 
     // All invalid gradients of return values should be treated as 0.
+    // They are passed to the operator as invalid tensors, except retained
+    // gradients which should be available after the backpropagation.
     for (uint32_t i = 0; i < retn; ++i) {
       NodeInfo &cur_n = cur_f.rets[i];
-      if (!cur_n.grad.valid()) {
+      if (cur_n.retain_grad && !cur_n.grad.valid()) {
         cur_n.grad = functions::zeros<Tensor>(cur_n.shape, cur_n.device);
       }
     }
 
+    // Recalculates values discarded by the gradient checkpointing.
+    if (checkpointing_) {
+      for (uint32_t i = 0; i < retn; ++i) {
+        forward_recursive(
+            Address { static_cast<std::uint32_t>(oid), i }, nullptr);
+      }
+      for (const Address &arg : cur_f.args) {
+        forward_recursive(arg, nullptr);
+      }
+    }
+
     // Gathers information of arguments.
+    // Invalid gradients of arguments are also passed as they are, except
+    // retained ones. The first operator propagating values to them overwrites
+    // the gradients, and following operators accumulate values to them.
+    // Gradients of arguments without any Parameter in their ancestors are not
+    // required, and are passed as nullptr.
+    if (argn > 0 &&
+        ops_[cur_f.args[0].oid].rets[cur_f.args[0].vid].donated &&
+        uses_first_argument_value(oid)) {
+      // Gradients required after the donation need the overwritten value.
+      PRIMITIV_THROW_ERROR(
+          "The value of the argument is already donated to the operator. "
+          "oid: " << oid);
+    }
     vector<const Tensor *> args_v(argn);
-    vector<Tensor *> args_g(argn);
+    vector<Tensor *> args_g(argn, nullptr);
     for (uint32_t i = 0; i < argn; ++i) {
       const Address arg = cur_f.args[i];
       OperatorInfo &arg_f = ops_[arg.oid];
       NodeInfo &arg_n = arg_f.rets[arg.vid];
-      args_v[i] = arg_n.value.valid()
-        ? &arg_n.value
-        : arg_f.op->get_inner_values()[arg.vid];
+      args_v[i] = get_value(arg);
+      if (!arg_n.requires_grad) continue;
       args_g[i] = &arg_n.grad;
-      if (!arg_n.grad.valid()) {
+      if (arg_n.retain_grad && !arg_n.grad.valid()) {
         arg_n.grad = functions::zeros<Tensor>(arg_n.shape, arg_n.device);
       }
     }
@@ -216,9 +667,90 @@ void Graph::backward(const Node &node) {
 
     // Deletes current gradient to suppress memory.
     for (uint32_t i = 0; i < retn; ++i) {
-      cur_f.rets[i].grad.invalidate();
+      NodeInfo &cur_n = cur_f.rets[i];
+      if (!cur_n.retain_grad) cur_n.grad.invalidate();
+    }
+
+    finish(oid);
+  }
+}
+
+void Graph::checkpoint(const Node &node) {
+  CHECK_NODE(node);
+  ops_[node.oid_].rets[node.vid_].checkpoint = true;
+}
+
+void Graph::discard_values(const vector<Address> &computed, Address keep) {
+  std::size_t segment = 0;
+  for (const Address addr : computed) {
+    if ((addr.oid == keep.oid && addr.vid == keep.vid) ||
+        !is_discardable(addr)) {
+      continue;
     }
+    NodeInfo &n = ops_[addr.oid].rets[addr.vid];
+    const std::size_t size = n.shape.size() * sizeof(float);
+    if (checkpoint_budget_ > 0 && segment + size > checkpoint_budget_) {
+      // Keeps this value as a new checkpoint to bound the segment size.
+      n.checkpoint = true;
+      segment = 0;
+      continue;
+    }
+    segment += size;
+    n.value.invalidate();
+    first_unforwarded_ = std::min(first_unforwarded_, addr.oid);
+  }
+}
+
+bool Graph::is_discardable(Address addr) const {
+  const OperatorInfo &f = ops_[addr.oid];
+  const NodeInfo &n = f.rets[addr.vid];
+  return !f.op->has_inner_values() &&
+    !f.args.empty() &&
+    !n.checkpoint &&
+    !n.donated &&
+    n.value.valid();
+}
+
+bool Graph::can_donate(std::uint32_t oid) const {
+  const OperatorInfo &cur_f = ops_[oid];
+  if (!cur_f.op->supports_inplace_forward() ||
+      uses_first_argument_value(oid)) {
+    return false;
+  }
+  const Address arg = cur_f.args[0];
+  const OperatorInfo &arg_f = ops_[arg.oid];
+  if (arg_f.op->has_inner_values() || arg_f.op->uses_return_values()) {
+    return false;
+  }
+  const NodeInfo &arg_n = arg_f.rets[arg.vid];
+  const NodeInfo &ret_n = cur_f.rets[0];
+  // Shared or borrowed values are never overwritten, and the in-place
+  // operation would allocate new memory without reusing them.
+  return arg_n.num_uses == 1 &&
+    arg_n.value.is_unique() &&
+    arg_n.shape == ret_n.shape &&
+    arg_n.device == ret_n.device;
+}
+
+bool Graph::uses_first_argument_value(std::uint32_t oid) const {
+  const OperatorInfo &cur_f = ops_[oid];
+  vector<bool> requires_grad(cur_f.args.size());
+  for (std::uint32_t i = 0; i < cur_f.args.size(); ++i) {
+    const Address arg = cur_f.args[i];
+    requires_grad[i] = ops_[arg.oid].rets[arg.vid].requires_grad;
   }
+  return cur_f.op->uses_first_argument_value(requires_grad);
+}
+
+const Tensor *Graph::get_value(Address addr) const {
+  while (ops_[addr.oid].rets[addr.vid].donated) {
+    addr = { ops_[addr.oid].rets[addr.vid].donee, 0 };
+  }
+  const OperatorInfo &f = ops_[addr.oid];
+  const NodeInfo &n = f.rets[addr.vid];
+  return f.op->has_inner_values()
+    ? f.op->get_inner_values()[addr.vid]
+    : &n.value;
 }
 
 Shape Graph::get_shape(const Node &node) const {
@@ -231,6 +763,22 @@ Device &Graph::get_device(const Node &node) const {
   return *ops_[node.oid_].rets[node.vid_].device;
 }
 
+const Operator &Graph::get_operator(const Node &node) const {
+  CHECK_NODE(node);
+  return *ops_[node.oid_].op;
+}
+
+std::vector<Node> Graph::get_arguments(const Node &node) {
+  CHECK_NODE(node);
+  const Array<Address> &args = ops_[node.oid_].args;
+  std::vector<Node> ret;
+  ret.reserve(args.size());
+  for (const Address &arg : args) {
+    ret.emplace_back(Node(*this, arg.oid, arg.vid));
+  }
+  return ret;
+}
+
 std::string Graph::dump(const std::string &format) const {
   if (format != "dot") PRIMITIV_THROW_ERROR("Unknown format: " << format);
 
@@ -1,9 +1,17 @@
 #ifndef PRIMITIV_GRAPH_H_
 #define PRIMITIV_GRAPH_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
+#include <primitiv/arena.h>
 #include <primitiv/mixins.h>
 #include <primitiv/operator.h>
 #include <primitiv/shape.h>
@@ -13,6 +21,7 @@ namespace primitiv {
 class Device;
 class Graph;
 class Node;
+class Parameter;
 
 /**
  * Pointer of a node in the computation graph.
@@ -102,6 +111,14 @@ public:
    */
   std::vector<float> to_vector() const;
 
+  /**
+   * Calculates the value of this node and copies it into an array.
+   * @param values Pointer to array of `shape().size()` elements in which the
+   *               calculated values are stored.
+   * @remarks This function calls Graph::forward() internally.
+   */
+  void to_array(float *values) const;
+
   /**
    * Returns argmax indices along an axis of this node.
    * @param dim A specified axis.
@@ -109,6 +126,14 @@ public:
    */
   std::vector<std::uint32_t> argmax(std::uint32_t dim) const;
 
+  /**
+   * Returns argmax indices along an axis of this node into an array.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `shape().size() / shape()[dim]` elements in
+   *            which the positions of the maximum values are stored.
+   */
+  void argmax(std::uint32_t dim, std::uint32_t *ids) const;
+
   /**
    * Returns argmin indices along an axis of this node.
    * @param dim A specified axis.
@@ -116,6 +141,14 @@ public:
    */
   std::vector<std::uint32_t> argmin(std::uint32_t dim) const;
 
+  /**
+   * Returns argmin indices along an axis of this node into an array.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `shape().size() / shape()[dim]` elements in
+   *            which the positions of the minimum values are stored.
+   */
+  void argmin(std::uint32_t dim, std::uint32_t *ids) const;
+
   /**
    * Executes the backward operation from this node.
    */
@@ -144,12 +177,14 @@ class Graph
     , mixins::Nonmovable<Graph> {
 public:
   Graph() = default;
-  ~Graph() = default;
+  ~Graph();
 
   /**
    * Clear all operators in the graph.
    * @remarks After calling this method, all Node objects supplied by the graph
    *          itself is invalidated.
+   *          Memory used by operators and nodes is kept and reused by
+   *          following operators.
    */
   void clear();
 
@@ -163,6 +198,39 @@ public:
   std::vector<Node> add_operator(
       std::unique_ptr<Operator> &&op, const std::vector<Node> &args);
 
+  /**
+   * Constructs a new operator in the memory owned by the graph, and adds it
+   * into the graph.
+   * @tparam Op Type of the operator.
+   * @param args List of arguments. Each node should point a node in the same
+   *        computation graph.
+   * @param ctor_args Arguments passed to the constructor of `Op`.
+   * @return A new Node object of the first resulting value.
+   * @remarks Unlike `add_operator()`, this function does not allocate any
+   *          memory on the heap once the graph has enough memory, which is
+   *          kept by `clear()`.
+   */
+  template<typename Op, typename... Args>
+  Node emplace_operator(
+      std::initializer_list<Node> args, Args&&... ctor_args) {
+    return emplace_operator_inner<Op>(
+        args.begin(), args.size(), std::forward<Args>(ctor_args)...);
+  }
+
+  /**
+   * Constructs a new operator in the memory owned by the graph, and adds it
+   * into the graph.
+   * @tparam Op Type of the operator.
+   * @param args List of arguments.
+   * @param ctor_args Arguments passed to the constructor of `Op`.
+   * @return A new Node object of the first resulting value.
+   */
+  template<typename Op, typename... Args>
+  Node emplace_operator(const std::vector<Node> &args, Args&&... ctor_args) {
+    return emplace_operator_inner<Op>(
+        args.data(), args.size(), std::forward<Args>(ctor_args)...);
+  }
+
   /**
    * Calculates the value of given node.
    * @param node Node object specifying the target node.
@@ -175,14 +243,194 @@ public:
    */
   const Tensor &forward(const Node &node);
 
+  /**
+   * Enables or disables the buffer donation.
+   * @param enabled `true` to enable the buffer donation, `false` otherwise.
+   * @remarks While the buffer donation is enabled, `forward()` lets
+   *          element-wise operators overwrite the value of their first
+   *          argument instead of allocating new memory, if the argument is
+   *          used by no other operators and its value is not required by the
+   *          backpropagation.
+   *          Values of such arguments are no longer available, and
+   *          `forward()` for them throws an exception. Operators added after
+   *          the donation should not refer these nodes.
+   *          The buffer donation is disabled by default.
+   */
+  void set_buffer_donation(bool enabled) { buffer_donation_ = enabled; }
+
+  /**
+   * Returns whether the buffer donation is enabled or not.
+   * @return `true` if the buffer donation is enabled, `false` otherwise.
+   */
+  bool get_buffer_donation() const { return buffer_donation_; }
+
+  /**
+   * Enables or disables the inference mode.
+   * @param enabled `true` to enable the inference mode, `false` otherwise.
+   * @remarks While the inference mode is enabled, `forward()` releases the
+   *          value of each node whose users were all calculated by the
+   *          previous `forward()` and no new users were added since then,
+   *          so that the memory usage is bounded by the values still
+   *          required by the recent operators. E.g., the recurrent state of
+   *          a decoding loop is kept until the next step refers it.
+   *          Released values are no longer available, and `forward()` for
+   *          them throws an exception. Operators added after the release
+   *          should not refer these nodes. `backward()` is not available
+   *          while the inference mode is enabled.
+   *          The inference mode is disabled by default.
+   */
+  void set_inference_mode(bool enabled) { inference_mode_ = enabled; }
+
+  /**
+   * Returns whether the inference mode is enabled or not.
+   * @return `true` if the inference mode is enabled, `false` otherwise.
+   */
+  bool get_inference_mode() const { return inference_mode_; }
+
+  /**
+   * Enables or disables the gradient checkpointing.
+   * @param enabled `true` to enable the checkpointing, `false` otherwise.
+   * @remarks While the checkpointing is enabled, `forward()` discards values
+   *          of intermediate nodes calculated in it, except checkpoints, the
+   *          requested node, and nodes without arguments (e.g., inputs and
+   *          random values). `backward()` recalculates discarded values from
+   *          the nearest checkpoints segment by segment, and discards them
+   *          again just after they are used.
+   *          Checkpoints are specified by `checkpoint()`, or are chosen
+   *          automatically according to `set_checkpoint_budget()`.
+   *          The buffer donation is not applied while the checkpointing is
+   *          enabled.
+   *          The checkpointing is disabled by default.
+   */
+  void set_checkpointing(bool enabled) { checkpointing_ = enabled; }
+
+  /**
+   * Returns whether the gradient checkpointing is enabled or not.
+   * @return `true` if the checkpointing is enabled, `false` otherwise.
+   */
+  bool get_checkpointing() const { return checkpointing_; }
+
+  /**
+   * Sets the approximate memory budget of the gradient checkpointing.
+   * @param size Number of bytes of values held in each segment between
+   *             checkpoints, assuming 32-bit floating point numbers.
+   *             `forward()` additionally marks a node as a checkpoint when
+   *             values discarded since the last checkpoint exceed this size.
+   *             0 disables automatic checkpoints.
+   */
+  void set_checkpoint_budget(std::size_t size) { checkpoint_budget_ = size; }
+
+  /**
+   * Returns the memory budget of the gradient checkpointing.
+   * @return Number of bytes, or 0 if automatic checkpoints are disabled.
+   */
+  std::size_t get_checkpoint_budget() const { return checkpoint_budget_; }
+
+  /**
+   * Marks the node as a checkpoint, whose value is kept while the gradient
+   * checkpointing is enabled.
+   * @param node Node object specifying the target node.
+   */
+  void checkpoint(const Node &node);
+
+  /**
+   * Enables or disables the automatic operator batching.
+   * @param enabled `true` to enable the batching, `false` otherwise.
+   * @remarks While the batching is enabled, `forward()` calculates operators
+   *          which have the same depth from already-calculated nodes and the
+   *          same type, constants and argument shapes by one batched
+   *          operation, by concatenating their arguments along the minibatch.
+   *          Arguments shared by all such operators with only one minibatch
+   *          are not concatenated, e.g., parameters of the same layer applied
+   *          to many independent inputs.
+   *          Only operators reporting `Operator::is_batchable_with()` are
+   *          batched, and results are identical to those without the
+   *          batching.
+   *          The batching is disabled by default.
+   */
+  void set_autobatching(bool enabled) { autobatching_ = enabled; }
+
+  /**
+   * Returns whether the automatic operator batching is enabled or not.
+   * @return `true` if the batching is enabled, `false` otherwise.
+   */
+  bool get_autobatching() const { return autobatching_; }
+
+  /**
+   * Enables or disables the graph simplification.
+   * @param enabled `true` to enable the simplification, `false` otherwise.
+   * @remarks While the simplification is enabled, adding an operator which
+   *          `Operator::equals()` an existing operator with the same arguments
+   *          returns nodes of the existing operator instead (common
+   *          subexpression elimination), and functions skip trivial
+   *          operations such as adding 0, multiplying 1, transposing twice
+   *          and reshaping to the same shape by returning their arguments.
+   *          Operators whose values are already donated or released are not
+   *          reused.
+   *          The simplification is disabled by default.
+   */
+  void set_simplification(bool enabled) { simplification_ = enabled; }
+
+  /**
+   * Returns whether the graph simplification is enabled or not.
+   * @return `true` if the simplification is enabled, `false` otherwise.
+   */
+  bool get_simplification() const { return simplification_; }
+
   /**
    * Calculates the backpropagation.
    * @param node Node object specifying the output node.
    * @remarks If `node` is not yet forwarded, this function implicitly calls
    *          `forward(node)`.
+   *          Operators without any Parameter (or retained node) in their
+   *          ancestors are skipped.
    */
   void backward(const Node &node);
 
+  /**
+   * Calculates the backpropagation with a notification of finished gradients.
+   * @param node Node object specifying the output node.
+   * @param callback Function called with each Parameter object used in the
+   *                 graph, just after its gradient is completely accumulated.
+   * @remarks The callback is called once for each Parameter while the
+   *          backpropagation is still running, so that the gradients of
+   *          finished parameters can be processed concurrently (e.g.,
+   *          all-reduced between data-parallel replicas) with the remaining
+   *          backward operations.
+   */
+  void backward(
+      const Node &node, const std::function<void(Parameter &)> &callback);
+
+  /**
+   * Calculates the backpropagation using a given gradient of the output node.
+   * @param node Node object specifying the output node.
+   * @param grad Gradient of the output node. This tensor should have the same
+   *             shape and device as `node`.
+   * @remarks This function is useful to continue the backpropagation from
+   *          another graph, e.g., the next stage of the pipeline parallelism.
+   */
+  void backward(const Node &node, const Tensor &grad);
+
+  /**
+   * Makes the gradient of the node available after the backpropagation.
+   * @param node Node object specifying the target node.
+   * @remarks Gradients of intermediate nodes are discarded during the
+   *          backpropagation by default to suppress the memory usage.
+   *          Gradients of nodes without any Parameter in their ancestors are
+   *          not calculated unless this function is called for them, e.g., the
+   *          gradient of an input node is available only if it is retained.
+   */
+  void retain_gradient(const Node &node);
+
+  /**
+   * Retrieves the gradient of the node calculated by the last backpropagation.
+   * @param node Node object specifying the target node.
+   * @return Gradient of the node.
+   * @throw primitiv::Error `retain_gradient(node)` is not called, or the
+   *                        gradient is not calculated.
+   */
+  const Tensor &get_gradient(const Node &node) const;
+
   /**
    * Retrieves the shape of the node.
    * @param node Node object specifying the target node.
@@ -197,6 +445,20 @@ public:
    */
   Device &get_device(const Node &node) const;
 
+  /**
+   * Retrieves the operator which calculates the node.
+   * @param node Node object specifying the target node.
+   * @return Operator object.
+   */
+  const Operator &get_operator(const Node &node) const;
+
+  /**
+   * Retrieves the arguments of the operator which calculates the node.
+   * @param node Node object specifying the target node.
+   * @return List of argument nodes.
+   */
+  std::vector<Node> get_arguments(const Node &node);
+
   /**
    * Dump internal graph structure.
    * @param format Name of the format. Available options:
@@ -220,6 +482,35 @@ private:
     std::uint32_t vid;
   };
 
+  /**
+   * Fixed-length array placed in the arena.
+   */
+  template<typename T>
+  struct Array {
+    T *data;
+    std::uint32_t n;
+
+    std::uint32_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    T &operator[](std::uint32_t i) const { return data[i]; }
+    T *begin() const { return data; }
+    T *end() const { return data + n; }
+  };
+
+  /**
+   * Deleter of operators, which are placed on the heap or the arena.
+   */
+  struct OperatorDeleter {
+    bool in_arena;
+
+    void operator()(Operator *op) const {
+      if (in_arena) op->~Operator();
+      else delete op;
+    }
+  };
+
+  using OperatorPtr = std::unique_ptr<Operator, OperatorDeleter>;
+
   /**
    * Informations of each node.
    */
@@ -228,7 +519,14 @@ private:
     Device *device;
     Tensor value;
     Tensor grad;
-    //std::vector<std::uint32_t> sinks;
+    bool retain_grad;
+    bool requires_grad;
+    std::uint32_t num_uses;
+    std::uint32_t num_finished_uses;
+    bool donated;
+    std::uint32_t donee;
+    bool released;
+    bool checkpoint;
   };
 
   /**
@@ -236,13 +534,172 @@ private:
    * operator, its arguments, and its return values.
    */
   struct OperatorInfo {
-    std::unique_ptr<Operator> op;
-    std::vector<Address> args;
-    std::vector<NodeInfo> rets;
+    OperatorPtr op;
+    Array<Address> args;
+    Array<NodeInfo> rets;
   };
 
-  static Graph *default_obj_;
+  /**
+   * Constructs a new operator in the arena, and adds it into the graph.
+   * @tparam Op Type of the operator.
+   * @param args Pointer to the first argument.
+   * @param argn Number of arguments.
+   * @param ctor_args Arguments passed to the constructor of `Op`.
+   * @return A new Node object of the first resulting value.
+   */
+  template<typename Op, typename... Args>
+  Node emplace_operator_inner(
+      const Node *args, std::uint32_t argn, Args&&... ctor_args) {
+    static_assert(
+        std::is_base_of<Operator, Op>::value,
+        "Op should be derived from primitiv::Operator.");
+    void *ptr = arena_.allocate(sizeof(Op), alignof(Op));
+    OperatorPtr op(
+        new (ptr) Op(std::forward<Args>(ctor_args)...),
+        OperatorDeleter { true });
+    return Node(*this, add_operator_inner(std::move(op), args, argn), 0);
+  }
+
+  /**
+   * Adds an operator into the graph.
+   * @param op Interface of the new operator.
+   * @param args Pointer to the first argument.
+   * @param argn Number of arguments.
+   * @return Operator ID of the new operator.
+   */
+  std::uint32_t add_operator_inner(
+      OperatorPtr &&op, const Node *args, std::uint32_t argn);
+
+  /**
+   * Checks whether the existing operator can be used instead of a new one.
+   * @param oid ID of the existing operator.
+   * @param op New operator.
+   * @param args Pointer to the first argument of the new operator.
+   * @param argn Number of arguments of the new operator.
+   * @return `true` if the existing operator calculates the same values,
+   *         `false` otherwise.
+   */
+  bool can_reuse(
+      std::uint32_t oid, const Operator &op,
+      const Node *args, std::uint32_t argn) const;
+
+  /**
+   * Calculates the value of the node recursively.
+   * @param addr Address of the node.
+   * @param computed If not nullptr, addresses of nodes calculated in this
+   *                 function are appended to it.
+   * @return Pointer to the value of the node.
+   */
+  const Tensor *forward_recursive(
+      Address addr, std::vector<Address> *computed);
+
+  /**
+   * Calculates all ancestors of the node using the automatic batching.
+   * @param addr Address of the node.
+   * @param computed If not nullptr, addresses of nodes calculated in this
+   *                 function are appended to it.
+   */
+  void forward_batched(Address addr, std::vector<Address> *computed);
+
+  /**
+   * Calculates operators together by one batched operation.
+   * @param oids IDs of batchable operators.
+   * @param shared Flags whether each argument is shared by all operators.
+   * @param computed If not nullptr, addresses of nodes calculated in this
+   *                 function are appended to it.
+   */
+  void forward_group(
+      const std::vector<std::uint32_t> &oids, const std::vector<bool> &shared,
+      std::vector<Address> *computed);
+
+  /**
+   * Updates the bookkeeping after calculating an operator.
+   * @param oid Operator ID.
+   * @param computed If not nullptr, addresses of return values are appended
+   *                 to it.
+   */
+  void finish_forward(std::uint32_t oid, std::vector<Address> *computed);
+
+  /**
+   * Discards values calculated in `forward()` for the gradient checkpointing.
+   * @param computed Addresses of calculated nodes in the calculation order.
+   * @param keep Address of the node which should not be discarded.
+   */
+  void discard_values(const std::vector<Address> &computed, Address keep);
+
+  /**
+   * Releases values of nodes whose users were all calculated by the previous
+   * `forward()` and have not been referred by any new operators.
+   * @param keep Address of the node which should not be released.
+   */
+  void release_values(Address keep);
+
+  /**
+   * Checks whether the value of the node can be discarded and recalculated.
+   * @param addr Address of the node.
+   * @return `true` if the value can be discarded, `false` otherwise.
+   */
+  bool is_discardable(Address addr) const;
+
+  /**
+   * Calculates the backpropagation.
+   * @param node Node object specifying the output node.
+   * @param grad Gradient of the output node, or an invalid tensor to use 1.
+   * @param callback Function called with each finished Parameter, or an empty
+   *                 function.
+   */
+  void backward_inner(
+      const Node &node, const Tensor &grad,
+      const std::function<void(Parameter &)> &callback);
+
+  /**
+   * Checks whether the operator can overwrite the value of its first argument.
+   * @param oid Operator ID.
+   * @return `true` if the value of the first argument can be donated to the
+   *         return value, `false` otherwise.
+   */
+  bool can_donate(std::uint32_t oid) const;
+
+  /**
+   * Checks whether the backward operation of the operator refers the value of
+   * its first argument under the current requirements of gradients.
+   * @param oid Operator ID.
+   * @return `true` if the value of the first argument is used, `false`
+   *         otherwise.
+   */
+  bool uses_first_argument_value(std::uint32_t oid) const;
+
+  /**
+   * Retrieves the tensor which holds the value of the node.
+   * @param addr Address of the node.
+   * @return Pointer to the value of the node. If the value is donated, the
+   *         value of the last node in the chain of donations is returned,
+   *         which has the same shape and device, but different contents.
+   */
+  const Tensor *get_value(Address addr) const;
+
+  Arena arena_;
   std::vector<OperatorInfo> ops_;
+  std::vector<const Shape *> arg_shapes_;
+  std::vector<Shape *> ret_shapes_;
+  bool buffer_donation_ = false;
+  bool inference_mode_ = false;
+  bool checkpointing_ = false;
+
+  // Nodes whose users were all calculated by the last forward(), which are
+  // released at the next forward() in the inference mode.
+  std::vector<Address> release_candidates_;
+  std::size_t checkpoint_budget_ = 0;
+  bool autobatching_ = false;
+
+  // Lower bound of operator IDs which may not be calculated yet, which is
+  // used to skip calculated operators in the autobatching.
+  std::uint32_t first_unforwarded_ = 0;
+  bool simplification_ = false;
+
+  // Operator IDs indexed by hashes of their types and arguments, which are
+  // used by the common subexpression elimination.
+  std::unordered_multimap<std::size_t, std::uint32_t> cse_table_;
 };
 
 inline Shape Node::shape() const {
@@ -265,16 +722,31 @@ inline std::vector<float> Node::to_vector() const {
   return g_->forward(*this).to_vector();
 }
 
+inline void Node::to_array(float *values) const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
+  g_->forward(*this).to_array(values);
+}
+
 inline std::vector<std::uint32_t> Node::argmax(std::uint32_t dim) const {
   if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
   return g_->forward(*this).argmax(dim);
 }
 
+inline void Node::argmax(std::uint32_t dim, std::uint32_t *ids) const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
+  g_->forward(*this).argmax(dim, ids);
+}
+
 inline std::vector<std::uint32_t> Node::argmin(std::uint32_t dim) const {
   if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
   return g_->forward(*this).argmin(dim);
 }
 
+inline void Node::argmin(std::uint32_t dim, std::uint32_t *ids) const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
+  g_->forward(*this).argmin(dim, ids);
+}
+
 inline void Node::backward() const {
   if (!valid()) PRIMITIV_THROW_ERROR("Invalid node.");
   g_->backward(*this);
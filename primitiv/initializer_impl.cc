@@ -14,11 +14,11 @@ void Constant::apply(Tensor &x) const {
 }
 
 void Uniform::apply(Tensor &x) const {
-  x = x.device().random_uniform(x.shape(), lower_, upper_);
+  x.device().inplace_random_uniform(lower_, upper_, x);
 }
 
 void Normal::apply(Tensor &x) const {
-  x = x.device().random_normal(x.shape(), mean_, sd_);
+  x.device().inplace_random_normal(mean_, sd_, x);
 }
 
 void Identity::apply(Tensor &x) const {
@@ -37,7 +37,7 @@ void XavierUniform::apply(Tensor &x) const {
         "XavierUniform initializer can be used to only matrices or vectors.");
   }
   const float bound = scale_ * std::sqrt(6. / (s[0] + s[1]));
-  x = x.device().random_uniform(s, -bound, bound);
+  x.device().inplace_random_uniform(-bound, bound, x);
 }
 
 void XavierNormal::apply(Tensor &x) const {
@@ -47,7 +47,7 @@ void XavierNormal::apply(Tensor &x) const {
         "XavierNormal initializer can be used to only matrices or vectors.");
   }
   const float sd = scale_ * std::sqrt(2. / (s[0] + s[1]));
-  x = x.device().random_normal(s, 0, sd);
+  x.device().inplace_random_normal(0, sd, x);
 }
 
 void XavierUniformConv2D::apply(Tensor &x) const {
@@ -60,7 +60,7 @@ void XavierUniformConv2D::apply(Tensor &x) const {
   const std::uint32_t fan_in = s[0] * s[1] * s[2];
   const std::uint32_t fan_out = s[0] * s[1] * s[3];
   const float bound = scale_ * std::sqrt(6. / (fan_in + fan_out));
-  x = x.device().random_uniform(s, -bound, bound);
+  x.device().inplace_random_uniform(-bound, bound, x);
 }
 
 void XavierNormalConv2D::apply(Tensor &x) const {
@@ -73,7 +73,7 @@ void XavierNormalConv2D::apply(Tensor &x) const {
   const std::uint32_t fan_in = s[0] * s[1] * s[2];
   const std::uint32_t fan_out = s[0] * s[1] * s[3];
   const float sd = scale_ * std::sqrt(2. / (fan_in + fan_out));
-  x = x.device().random_normal(s, 0, sd);
+  x.device().inplace_random_normal(0, sd, x);
 }
 
 }  // namespace initializers
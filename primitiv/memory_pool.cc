@@ -1,6 +1,8 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 #include <primitiv/error.h>
 #include <primitiv/memory_pool.h>
 #include <primitiv/numeric_utils.h>
@@ -9,6 +11,16 @@ using std::cerr;
 using std::endl;
 using std::make_pair;
 
+namespace {
+
+// Number of blocks moved between thread and central free lists at once.
+const std::size_t BATCH_SIZE = 8;
+
+// Maximum number of blocks in each free list of the thread caches.
+const std::size_t MAX_THREAD_CACHE_SIZE = 2 * BATCH_SIZE;
+
+}  // namespace
+
 namespace primitiv {
 
 MemoryPool::MemoryPool(
@@ -16,17 +28,22 @@ MemoryPool::MemoryPool(
     std::function<void(void *)> deleter)
 : allocator_(allocator)
 , deleter_(deleter)
-, reserved_(64)
-, supplied_() {}
+, blocks_(std::make_shared<Blocks>(id())) {}
 
 MemoryPool::~MemoryPool() {
   // NOTE(odashi):
   // Due to GC-based languages, we chouldn't assume that all memories were
   // disposed before arriving this code.
-  while (!supplied_.empty()) {
-    free(supplied_.begin()->first);
+  const std::lock_guard<std::mutex> lock(blocks_->mutex);
+  for (auto &cache : blocks_->caches) {
+    const std::lock_guard<std::mutex> cache_lock(cache->mutex);
+    for (auto &ptrs : cache->reserved) ptrs.clear();
+    cache->orphaned = true;
   }
-  release_reserved_blocks();
+  for (void *ptr : blocks_->allocated) {
+    deleter_(ptr);
+  }
+  blocks_->allocated.clear();
 }
 
 std::shared_ptr<void> MemoryPool::allocate(std::size_t size) {
@@ -38,43 +55,143 @@ std::shared_ptr<void> MemoryPool::allocate(std::size_t size) {
   const std::uint64_t shift = numeric_utils::calculate_shifts(size);
   if (shift > MAX_SHIFTS) PRIMITIV_THROW_ERROR("Invalid memory size: " << size);
 
-  void *ptr;
-  if (reserved_[shift].empty()) {
-    // Allocates a new block.
-    try {
-      ptr = allocator_(1ull << shift);
-    } catch (...) {
-      // Maybe out-of-memory.
-      // Release other blocks and try allocation again.
-      release_reserved_blocks();
-      // Below allocation may throw an error when the memory allocation
-      // process finally failed.
-      ptr = allocator_(1ull << shift);
+  ThreadCache &cache = blocks_->get_thread_cache();
+  {
+    // Returns an existing block in the thread cache.
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    std::vector<void *> &ptrs = cache.reserved[shift];
+    if (!ptrs.empty()) {
+      void *ptr = ptrs.back();
+      ptrs.pop_back();
+      return std::shared_ptr<void>(ptr, Deleter(blocks_, shift));
     }
-    supplied_.emplace(ptr, shift);
+  }
+
+  // Moves a batch of blocks from the central free list.
+  std::vector<void *> batch;
+  {
+    const std::lock_guard<std::mutex> lock(blocks_->mutex);
+    std::vector<void *> &ptrs = blocks_->reserved[shift];
+    const std::size_t n = std::min(ptrs.size(), BATCH_SIZE);
+    batch.assign(ptrs.end() - n, ptrs.end());
+    ptrs.resize(ptrs.size() - n);
+  }
+
+  void *ptr;
+  if (batch.empty()) {
+    ptr = allocate_new_block(shift);
   } else {
-    // Returns an existing block.
-    ptr = reserved_[shift].back();
-    reserved_[shift].pop_back();
-    supplied_.emplace(ptr, shift);
+    ptr = batch.back();
+    batch.pop_back();
+    if (!batch.empty()) {
+      const std::lock_guard<std::mutex> lock(cache.mutex);
+      std::vector<void *> &ptrs = cache.reserved[shift];
+      ptrs.insert(ptrs.end(), batch.begin(), batch.end());
+    }
+  }
+
+  return std::shared_ptr<void>(ptr, Deleter(blocks_, shift));
+}
+
+void *MemoryPool::allocate_new_block(std::uint32_t shift) {
+  void *ptr;
+  try {
+    ptr = allocator_(1ull << shift);
+  } catch (...) {
+    // Maybe out-of-memory.
+    // Release other blocks and try allocation again.
+    release_reserved_blocks();
+    // Below allocation may throw an error when the memory allocation
+    // process finally failed.
+    ptr = allocator_(1ull << shift);
   }
+  const std::lock_guard<std::mutex> lock(blocks_->mutex);
+  blocks_->allocated.emplace(ptr);
+  return ptr;
+}
+
+MemoryPool::ThreadCache &MemoryPool::Blocks::get_thread_cache() {
+  // Pool IDs are never reused, so that entries of the finished pools never
+  // match to any other pools.
+  thread_local std::unordered_map<
+    std::uint64_t, ThreadCacheOwner> thread_caches;
+
+  const auto it = thread_caches.find(pool_id);
+  if (it != thread_caches.end()) return *it->second.cache;
 
-  return std::shared_ptr<void>(ptr, Deleter(id()));
+  // Forgets caches of the finished pools.
+  for (auto jt = thread_caches.begin(); jt != thread_caches.end(); ) {
+    if (jt->second.cache->orphaned) jt = thread_caches.erase(jt);
+    else ++jt;
+  }
+
+  const auto cache = std::make_shared<ThreadCache>();
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    collect_finished_caches();
+    caches.emplace_back(cache);
+  }
+  thread_caches.emplace(pool_id, ThreadCacheOwner(cache));
+  return *cache;
 }
 
-void MemoryPool::free(void *ptr) {
-  auto it = supplied_.find(ptr);
-  if (it == supplied_.end()) {
-    PRIMITIV_THROW_ERROR("Detected to dispose unknown handle: " << ptr);
+void MemoryPool::Blocks::collect_finished_caches() {
+  for (auto it = caches.begin(); it != caches.end(); ) {
+    // The owner thread marks the cache under its mutex when it finishes, and
+    // never touches the cache after that.
+    ThreadCache &cache = **it;
+    const std::lock_guard<std::mutex> cache_lock(cache.mutex);
+    if (cache.finished) {
+      std::vector<std::vector<void *>> &src = cache.reserved;
+      for (std::uint32_t shift = 0; shift < src.size(); ++shift) {
+        reserved[shift].insert(
+            reserved[shift].end(), src[shift].begin(), src[shift].end());
+        src[shift].clear();
+      }
+      it = caches.erase(it);
+    } else {
+      ++it;
+    }
   }
-  reserved_[it->second].emplace_back(ptr);
-  supplied_.erase(it);
+}
+
+void MemoryPool::Blocks::free(void *ptr, std::uint32_t shift) {
+  ThreadCache &cache = get_thread_cache();
+  std::vector<void *> batch;
+  {
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    std::vector<void *> &ptrs = cache.reserved[shift];
+    ptrs.emplace_back(ptr);
+    if (ptrs.size() <= MAX_THREAD_CACHE_SIZE) return;
+    batch.assign(ptrs.end() - BATCH_SIZE, ptrs.end());
+    ptrs.resize(ptrs.size() - BATCH_SIZE);
+  }
+
+  // Moves a batch of blocks to the central free list.
+  const std::lock_guard<std::mutex> lock(mutex);
+  std::vector<void *> &ptrs = reserved[shift];
+  ptrs.insert(ptrs.end(), batch.begin(), batch.end());
 }
 
 void MemoryPool::release_reserved_blocks() {
-  for (auto &ptrs : reserved_) {
+  const std::lock_guard<std::mutex> lock(blocks_->mutex);
+
+  // Moves all blocks in the thread caches to the central free lists.
+  for (auto &cache : blocks_->caches) {
+    const std::lock_guard<std::mutex> cache_lock(cache->mutex);
+    for (std::uint32_t shift = 0; shift < cache->reserved.size(); ++shift) {
+      std::vector<void *> &src = cache->reserved[shift];
+      std::vector<void *> &dest = blocks_->reserved[shift];
+      dest.insert(dest.end(), src.begin(), src.end());
+      src.clear();
+    }
+  }
+  blocks_->collect_finished_caches();
+
+  for (auto &ptrs : blocks_->reserved) {
     while (!ptrs.empty()) {
       deleter_(ptrs.back());
+      blocks_->allocated.erase(ptrs.back());
       ptrs.pop_back();
     }
   }
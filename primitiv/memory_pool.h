@@ -1,11 +1,13 @@
 #ifndef PRIMITIV_MEMORY_POOL_H_
 #define PRIMITIV_MEMORY_POOL_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include <primitiv/mixins.h>
@@ -14,30 +16,113 @@ namespace primitiv {
 
 /**
  * Memory manager on the device specified by allocator/deleter functors.
+ * @remarks All public member functions and releasing of allocated memories
+ *          could be called from multiple threads concurrently.
+ *          Each thread has its own free lists, and exchanges memory blocks with
+ *          the central free lists in batches only when its own lists are empty
+ *          or too long.
  */
 class MemoryPool : public mixins::Identifiable<MemoryPool> {
+  /**
+   * Free lists owned by each thread.
+   */
+  struct ThreadCache {
+    // This mutex is locked by the owner thread and is contended only when the
+    // pool reclaims all cached blocks.
+    std::mutex mutex;
+    std::vector<std::vector<void *>> reserved;
+    std::atomic<bool> orphaned;
+
+    // Set by the owner thread when it finishes. Guarded by `mutex`.
+    bool finished;
+
+    ThreadCache() : mutex(), reserved(64), orphaned(false), finished(false) {}
+  };
+
+  /**
+   * Thread-local reference to a ThreadCache, which marks the cache as
+   * finished when the owner thread finishes.
+   */
+  class ThreadCacheOwner {
+    ThreadCacheOwner(const ThreadCacheOwner &) = delete;
+    ThreadCacheOwner &operator=(const ThreadCacheOwner &) = delete;
+    ThreadCacheOwner &operator=(ThreadCacheOwner &&) = delete;
+
+  public:
+    std::shared_ptr<ThreadCache> cache;
+
+    explicit ThreadCacheOwner(const std::shared_ptr<ThreadCache> &cache)
+      : cache(cache) {}
+
+    ThreadCacheOwner(ThreadCacheOwner &&src) : cache(std::move(src.cache)) {}
+
+    ~ThreadCacheOwner() {
+      if (!cache) return;
+      const std::lock_guard<std::mutex> lock(cache->mutex);
+      cache->finished = true;
+    }
+  };
+
+  /**
+   * Memory blocks managed by the pool.
+   * This object is shared between the pool and the deleters of supplied
+   * memories.
+   */
+  struct Blocks {
+    const std::uint64_t pool_id;
+
+    // Following members are guarded by `mutex`.
+    std::mutex mutex;
+    std::vector<std::vector<void *>> reserved;
+    std::unordered_set<void *> allocated;
+    std::vector<std::shared_ptr<ThreadCache>> caches;
+
+    explicit Blocks(std::uint64_t pool_id)
+      : pool_id(pool_id), mutex(), reserved(64), allocated(), caches() {}
+
+    /**
+     * Retrieves the free lists of the current thread.
+     * @return Reference of the ThreadCache object.
+     */
+    ThreadCache &get_thread_cache();
+
+    /**
+     * Moves all blocks in the caches of finished threads to the central free
+     * lists. `mutex` should be locked by the caller.
+     */
+    void collect_finished_caches();
+
+    /**
+     * Returns a supplied memory to the free lists of the current thread.
+     * @param ptr Handle of the memory to be disposed.
+     * @param shift Size of the memory in log2 scale.
+     */
+    void free(void *ptr, std::uint32_t shift);
+  };
+
   /**
    * Custom deleter class for MemoryPool.
    */
   class Deleter {
-    std::uint64_t pool_id_;
+    std::weak_ptr<Blocks> blocks_;
+    std::uint32_t shift_;
   public:
-    explicit Deleter(std::uint64_t pool_id) : pool_id_(pool_id) {}
+    Deleter(const std::shared_ptr<Blocks> &blocks, std::uint32_t shift)
+      : blocks_(blocks), shift_(shift) {}
 
     void operator()(void *ptr) {
-      try {
-        MemoryPool::get_object(pool_id_).free(ptr);
-      } catch (primitiv::Error) {
-        // Memory pool already has gone and the pointer is already deleted by
-        // the memory pool.
-      }
+      // The deleter does not look up the pool through Identifiable, which
+      // requires a global lock. Locking `blocks_` fails only when the memory
+      // pool already has gone, and then the pointer is already deleted by the
+      // memory pool.
+      const std::shared_ptr<Blocks> blocks = blocks_.lock();
+      if (blocks) blocks->free(ptr, shift_);
     }
   };
 
   std::function<void *(std::size_t)> allocator_;
   std::function<void(void *)> deleter_;
-  std::vector<std::vector<void *>> reserved_;
-  std::unordered_map<void *, std::uint32_t> supplied_;
+  std::shared_ptr<Blocks> blocks_;
 
 public:
   /**
@@ -60,10 +145,11 @@ public:
 
 private:
   /**
-   * Disposes the memory managed by this pool.
-   * @param ptr Handle of the memory to be disposed.
+   * Allocates a new memory block using the allocator functor.
+   * @param shift Size of the memory in log2 scale.
+   * @return Pointer of the new block.
    */
-  void free(void *ptr);
+  void *allocate_new_block(std::uint32_t shift);
 
   /**
    * Releases all reserved memory blocks.
@@ -1,9 +1,11 @@
 #ifndef PRIMITIV_MIXINS_H_
 #define PRIMITIV_MIXINS_H_
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <primitiv/error.h>
 
 namespace primitiv {
@@ -88,6 +90,7 @@ std::mutex Identifiable<T>::mutex_;
 
 /**
  * Mix-in class to provide default value setter/getter.
+ * @remarks Default objects are managed separately for each thread.
  */
 template<typename T>
 class DefaultSettable {
@@ -97,37 +100,86 @@ class DefaultSettable {
   DefaultSettable &operator=(DefaultSettable &&) = delete;
 
   /**
-   * Pointer of current default object.
+   * Holder of the default object of each thread.
    */
-  static T *default_obj_;
+  struct Slot {
+    // Written by other threads when the default object is destroyed.
+    std::atomic<T *> obj;
+
+    Slot() : obj(nullptr) {
+      Registry &r = registry();
+      const std::lock_guard<std::mutex> lock(r.mutex);
+      r.slots.emplace(this);
+    }
+
+    ~Slot() {
+      Registry &r = registry();
+      const std::lock_guard<std::mutex> lock(r.mutex);
+      r.slots.erase(this);
+    }
+  };
+
+  /**
+   * Slots of all living threads.
+   */
+  struct Registry {
+    std::unordered_set<Slot *> slots;
+    std::mutex mutex;
+  };
+
+  /**
+   * Retrieves the registry of slots.
+   * @return Reference of the registry.
+   * @remarks The registry is never destroyed so that thread-local slots and
+   *          static objects can access it regardless of the order of their
+   *          initialization and destruction.
+   */
+  static Registry &registry() {
+    static Registry *instance = new Registry();
+    return *instance;
+  }
+
+  /**
+   * Retrieves the slot of the current thread.
+   * @return Reference of the slot.
+   */
+  static Slot &slot() {
+    thread_local Slot slot;
+    return slot;
+  }
 
 protected:
   DefaultSettable() = default;
 
   ~DefaultSettable() {
-    // If the current default object is this, unregister it.
-    if (default_obj_ == static_cast<T *>(this)) {
-      default_obj_ = nullptr;
+    // If this object is the default object of some threads, unregister it.
+    Registry &r = registry();
+    const std::lock_guard<std::mutex> lock(r.mutex);
+    for (Slot *slot : r.slots) {
+      T *self = static_cast<T *>(this);
+      slot->obj.compare_exchange_strong(self, nullptr);
     }
   }
 
 public:
   /**
-   * Retrieves the current default object.
+   * Retrieves the current default object of the current thread.
    * @return Reference of the current default object.
    * @throw primitiv::Error Default object is null.
    */
   static T &get_default() {
-    if (!default_obj_) PRIMITIV_THROW_ERROR("Default object is null.");
-    return *default_obj_;
+    T *obj = slot().obj;
+    if (!obj) PRIMITIV_THROW_ERROR("Default object is null.");
+    return *obj;
   }
 
   /**
-   * Specifies a new default object.
+   * Specifies a new default object of the current thread.
    * @param obj Reference of the new default object.
+   * @remarks Other threads are not affected by this function.
    */
   static void set_default(T &obj) {
-    default_obj_ = &obj;
+    slot().obj = &obj;
   }
 
   /**
@@ -144,9 +196,6 @@ public:
   }
 };
 
-template<typename T>
-T *DefaultSettable<T>::default_obj_ = nullptr;
-
 }  // namespace mixins
 }  // namespace primitiv
 
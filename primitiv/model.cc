@@ -45,7 +45,10 @@ void Model::load(const std::string &path, bool with_stats, Device *device) {
   }
 }
 
-void Model::save(const std::string &path, bool with_stats) const {
+void Model::save(
+    const std::string &path, bool with_stats,
+    FileFormat::Precision precision,
+    FileFormat::Precision stats_precision) const {
   std::ofstream ofs(path);
   if (!ofs.is_open()) {
     PRIMITIV_THROW_ERROR("Could not open file: " << path);
@@ -69,7 +72,7 @@ void Model::save(const std::string &path, bool with_stats) const {
 
   for (const auto &kv : params) {
     writer << kv.first;
-    kv.second->save_inner(writer, with_stats);
+    kv.second->save_inner(writer, with_stats, precision, stats_precision);
   }
 }
 
@@ -9,6 +9,7 @@
 #include <unordered_set>
 
 #include <primitiv/error.h>
+#include <primitiv/file_format.h>
 #include <primitiv/mixins.h>
 
 namespace primitiv {
@@ -63,8 +64,39 @@ public:
    * Saves all parameters to a file.
    * @param path Path of the file.
    * @param with_stats Whether or not to save all additional statistics.
+   * @param precision Floating-point precision used to store the values.
+   * @param stats_precision Floating-point precision used to store the
+   *                        statistics.
+   * @remarks Reduced-precision data is converted back to single-precision
+   *          while loading.
    */
-  void save(const std::string &path, bool with_stats) const;
+  void save(
+      const std::string &path, bool with_stats,
+      FileFormat::Precision precision,
+      FileFormat::Precision stats_precision) const;
+
+  /**
+   * Saves all parameters to a file.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to save all additional statistics.
+   * @param precision Floating-point precision used to store the values.
+   * @remarks Statistics are always stored in single-precision so that
+   *          optimizers can be resumed without any loss.
+   */
+  void save(
+      const std::string &path, bool with_stats,
+      FileFormat::Precision precision) const {
+    save(path, with_stats, precision, FileFormat::Precision::FLOAT32);
+  }
+
+  /**
+   * Saves all parameters to a file.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to save all additional statistics.
+   */
+  void save(const std::string &path, bool with_stats) const {
+    save(path, with_stats, FileFormat::Precision::FLOAT32);
+  }
 
   /**
    * Saves all parameters to a file.
@@ -90,6 +90,16 @@ public:
    */
   Reader(std::istream &is) : is_(is) {}
 
+  /**
+   * Retrieves the type byte of the next object without consuming it.
+   * @return The first byte of the next object.
+   */
+  std::uint8_t peek_type() {
+    const int c = is_.peek();
+    check_eof();
+    return static_cast<std::uint8_t>(c);
+  }
+
   Reader &operator>>(std::nullptr_t) {
     // Do nothing. Only checking the type.
     check_type(0xc0);
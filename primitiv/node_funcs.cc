@@ -10,13 +10,11 @@
 #include <primitiv/functions.h>
 #include <primitiv/graph.h>
 #include <primitiv/shape.h>
+#include <primitiv/shape_ops.h>
 #include <primitiv/operator_impl.h>
 #include <primitiv/parameter.h>
 
-#define REG(g, op, ...) ( \
-    (g).add_operator( \
-      std::unique_ptr<Operator>(new operators::op), \
-      {__VA_ARGS__}))
+#define REG(g, op, ...) ((g).emplace_operator<operators::op>(__VA_ARGS__))
 
 #define REGX(x, op, ...) REG((x).graph(), op, __VA_ARGS__)
 
@@ -24,6 +22,37 @@ namespace {
 
 using primitiv::Node;
 
+// Replaces `x` with its argument if `x` is calculated by the Transpose
+// operator.
+bool unwrap_transpose(Node &x) {
+  primitiv::Graph &g = x.graph();
+  if (!dynamic_cast<const primitiv::operators::Transpose *>(
+        &g.get_operator(x))) {
+    return false;
+  }
+  x = g.get_arguments(x)[0];
+  return true;
+}
+
+// Replaces `x` with the source of reshaping if `x` is calculated by the Reshape
+// or Flatten operators, which do not change the contents of the value.
+void unwrap_reshape(Node &x) {
+  primitiv::Graph &g = x.graph();
+  for (;;) {
+    const primitiv::Operator &op = g.get_operator(x);
+    if (!dynamic_cast<const primitiv::operators::Reshape *>(&op) &&
+        !dynamic_cast<const primitiv::operators::Flatten *>(&op)) {
+      return;
+    }
+    x = g.get_arguments(x)[0];
+  }
+}
+
+// Returns whether the graph of `x` simplifies trivial operations.
+bool simplifies(const Node &x) {
+  return x.graph().get_simplification();
+}
+
 // Helper to transform pointers to nodes.
 std::vector<Node> ptr_to_obj(const std::vector<const Node *> &xs) {
   std::vector<Node> ret;
@@ -38,128 +67,152 @@ namespace primitiv {
 namespace functions {
 
 template<>
-Node positive(const Node &x) { return REGX(x, Positive(), x)[0]; }
+Node positive(const Node &x) { return REGX(x, Positive, {x}); }
 
 template<>
-Node negative(const Node &x) { return REGX(x, Negative(), x)[0]; }
+Node negative(const Node &x) { return REGX(x, Negative, {x}); }
 
 template<>
-Node add(const Node &x, float k) { return REGX(x, AddConst(k), x)[0]; }
+Node add(const Node &x, float k) {
+  if (k == 0 && simplifies(x)) return x;
+  return REGX(x, AddConst, {x}, k);
+}
 
 template<>
-Node add(float k, const Node &x) { return REGX(x, AddConst(k), x)[0]; }
+Node add(float k, const Node &x) { return add(x, k); }
 
 template<>
 Node add(const Node &a, const Node &b) {
-  if (a.shape().is_scalar()) return REGX(a, AddScalar(), b, a)[0];
-  else if (b.shape().is_scalar()) return REGX(a, AddScalar(), a, b)[0];
-  else return REGX(a, Add(), a, b)[0];
+  if (a.shape().is_scalar()) return REGX(a, AddScalar, {b, a});
+  else if (b.shape().is_scalar()) return REGX(a, AddScalar, {a, b});
+  else return REGX(a, Add, {a, b});
 }
 
 template<>
 Node subtract(const Node &x, float k) {
-  return REGX(x, SubtractConstR(k), x)[0];
+  if (k == 0 && simplifies(x)) return x;
+  return REGX(x, SubtractConstR, {x}, k);
 }
 
 template<>
 Node subtract(float k, const Node &x) {
-  return REGX(x, SubtractConstL(k), x)[0];
+  return REGX(x, SubtractConstL, {x}, k);
 }
 
 template<>
 Node subtract(const Node &a, const Node &b) {
-  if (a.shape().is_scalar()) return REGX(a, SubtractScalarL(), b, a)[0];
-  else if (b.shape().is_scalar()) return REGX(a, SubtractScalarR(), a, b)[0];
-  else return REGX(a, Subtract(), a, b)[0];
+  if (a.shape().is_scalar()) return REGX(a, SubtractScalarL, {b, a});
+  else if (b.shape().is_scalar()) return REGX(a, SubtractScalarR, {a, b});
+  else return REGX(a, Subtract, {a, b});
 }
 
 template<>
 Node multiply(const Node &x, float k) {
-  return REGX(x, MultiplyConst(k), x)[0];
+  if (k == 1 && simplifies(x)) return x;
+  return REGX(x, MultiplyConst, {x}, k);
 }
 
 template<>
-Node multiply(float k, const Node &x) {
-  return REGX(x, MultiplyConst(k), x)[0];
-}
+Node multiply(float k, const Node &x) { return multiply(x, k); }
 
 template<>
 Node multiply(const Node &a, const Node &b) {
-  if (a.shape().is_scalar()) return REGX(a, MultiplyScalar(), b, a)[0];
-  else if (b.shape().is_scalar()) return REGX(a, MultiplyScalar(), a, b)[0];
-  else return REGX(a, Multiply(), a, b)[0];
+  if (a.shape().is_scalar()) return REGX(a, MultiplyScalar, {b, a});
+  else if (b.shape().is_scalar()) return REGX(a, MultiplyScalar, {a, b});
+  else return REGX(a, Multiply, {a, b});
 }
 
 template<>
-Node divide(const Node &x, float k) { return REGX(x, DivideConstR(k), x)[0]; }
+Node divide(const Node &x, float k) {
+  if (k == 1 && simplifies(x)) return x;
+  return REGX(x, DivideConstR, {x}, k);
+}
 
 template<>
-Node divide(float k, const Node &x) { return REGX(x, DivideConstL(k), x)[0]; }
+Node divide(float k, const Node &x) { return REGX(x, DivideConstL, {x}, k); }
 
 template<>
 Node divide(const Node &a, const Node &b) {
-  if (a.shape().is_scalar()) return REGX(a, DivideScalarL(), b, a)[0];
-  else if (b.shape().is_scalar()) return REGX(a, DivideScalarR(), a, b)[0];
-  else return REGX(a, Divide(), a, b)[0];
+  if (a.shape().is_scalar()) return REGX(a, DivideScalarL, {b, a});
+  else if (b.shape().is_scalar()) return REGX(a, DivideScalarR, {a, b});
+  else return REGX(a, Divide, {a, b});
 }
 
 template<>
-Node pow(const Node &x, float k) { return REGX(x, PowConstR(k), x)[0]; }
+Node pow(const Node &x, float k) { return REGX(x, PowConstR, {x}, k); }
 
 template<>
-Node pow(float k, const Node &x) { return REGX(x, PowConstL(k), x)[0]; }
+Node pow(float k, const Node &x) { return REGX(x, PowConstL, {x}, k); }
 
 template<>
 Node pow(const Node &a, const Node &b) {
-  if (a.shape().is_scalar()) return REGX(a, PowScalarL(), b, a)[0];
-  else if (b.shape().is_scalar()) return REGX(a, PowScalarR(), a, b)[0];
-  else return REGX(a, Pow(), a, b)[0];
+  if (a.shape().is_scalar()) return REGX(a, PowScalarL, {b, a});
+  else if (b.shape().is_scalar()) return REGX(a, PowScalarR, {a, b});
+  else return REGX(a, Pow, {a, b});
 }
 
 template<>
-Node pown(const Node &x, std::int32_t k) { return REGX(x, PowN(k), x)[0]; }
+Node pown(const Node &x, std::int32_t k) {
+  if (k == 1 && simplifies(x)) return x;
+  return REGX(x, PowN, {x}, k);
+}
 
 Node input_node(
     const Shape &shape, const std::vector<float> &data, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      Input(shape, data, Device::get_reference_or_default(dev))
-  )[0];
+      Input, {}, shape, data, Device::get_reference_or_default(dev)
+  );
+}
+
+Node input_node(
+    const Shape &shape, std::vector<float> &&data, Device *dev, Graph *g) {
+  return REG(
+      Graph::get_reference_or_default(g),
+      Input, {}, shape, std::move(data), Device::get_reference_or_default(dev)
+  );
+}
+
+Node borrowed_input_node(
+    const Shape &shape, const float *data, Device *dev, Graph *g) {
+  return REG(
+      Graph::get_reference_or_default(g),
+      Input, {}, shape, data, Device::get_reference_or_default(dev)
+  );
 }
 
 Node parameter_node(primitiv::Parameter &param, Graph *g) {
-  return REG(Graph::get_reference_or_default(g), Parameter(param))[0];
+  return REG(Graph::get_reference_or_default(g), Parameter, {}, param);
 }
 
 template<>
 Node copy(const Node &x, Device *dev) {
-  return REGX(x, Copy(Device::get_reference_or_default(dev)), x)[0];
+  return REGX(x, Copy, {x}, Device::get_reference_or_default(dev));
 }
 
 template<>
 Node pick(
     const Node &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim) {
-  return REGX(x, Pick(ids, dim), x)[0];
+  return REGX(x, Pick, {x}, ids, dim);
 }
 
 template<>
 Node slice(
     const Node &x, std::uint32_t dim,
     std::uint32_t lower, std::uint32_t upper) {
-  return REGX(x, Slice(dim, lower, upper), x)[0];
+  return REGX(x, Slice, {x}, dim, lower, upper);
 }
 
 template<>
 std::vector<Node> split(const Node &x, std::uint32_t dim, std::uint32_t n) {
-  return REGX(x, Split(dim, n), x);
+  return x.graph().add_operator(
+      std::unique_ptr<Operator>(new operators::Split(dim, n)), {x});
 }
 
 template<>
 Node concat(const std::vector<Node> &xs, std::uint32_t dim) {
   if (xs.empty()) PRIMITIV_THROW_ERROR("No nodes to concat.");
-  return xs[0].graph().add_operator(
-      std::unique_ptr<Operator>(new operators::Concat(dim)), xs
-  )[0];
+  return xs[0].graph().emplace_operator<operators::Concat>(xs, dim);
 }
 
 template<>
@@ -169,112 +222,143 @@ Node concat(const std::vector<const Node *> &xs, std::uint32_t dim) {
 
 template<>
 Node reshape(const Node &x, const Shape &shape) {
-  return REGX(x, Reshape(shape), x)[0];
+  if (simplifies(x)) {
+    // Reshaping does not depend on the previous shape.
+    Node xx = x;
+    ::unwrap_reshape(xx);
+    if (shape_ops::reshape(xx.shape(), shape) == xx.shape()) return xx;
+    return REGX(xx, Reshape, {xx}, shape);
+  }
+  return REGX(x, Reshape, {x}, shape);
 }
 
 template<>
 Node flatten(const Node &x) {
-  return REGX(x, Flatten(), x)[0];
+  if (simplifies(x)) {
+    Node xx = x;
+    ::unwrap_reshape(xx);
+    if (shape_ops::flatten(xx.shape()) == xx.shape()) return xx;
+    return REGX(xx, Flatten, {xx});
+  }
+  return REGX(x, Flatten, {x});
 }
 
 template<>
 Node transpose(const Node &x) {
-  return REGX(x, Transpose(), x)[0];
+  Node xx = x;
+  if (simplifies(x) && ::unwrap_transpose(xx)) return xx;
+  return REGX(x, Transpose, {x});
 }
 
 template<>
 Node matmul(const Node &a, const Node &b) {
-  return REGX(a, MatrixMultiply(), a, b)[0];
+  // Transposed operands are directly passed to the matrix multiplication,
+  // and the Transpose operators are calculated only if other operators
+  // require their results.
+  Node aa = a, bb = b;
+  const bool transpose_a = unwrap_transpose(aa);
+  const bool transpose_b = unwrap_transpose(bb);
+  if (transpose_a || transpose_b) {
+    return REGX(
+        a, TransposedMatrixMultiply, {aa, bb}, transpose_a, transpose_b);
+  }
+  return REGX(a, MatrixMultiply, {a, b});
 }
 
 template<>
 Node sqrt(const Node &x) {
-  return REGX(x, Sqrt(), x)[0];
+  return REGX(x, Sqrt, {x});
 }
 
 template<>
 Node exp(const Node &x) {
-  return REGX(x, Exp(), x)[0];
+  return REGX(x, Exp, {x});
 }
 
 template<>
 Node log(const Node &x) {
-  return REGX(x, Log(), x)[0];
+  return REGX(x, Log, {x});
 }
 
 template<>
 Node tanh(const Node &x) {
-  return REGX(x, Tanh(), x)[0];
+  return REGX(x, Tanh, {x});
 }
 
 template<>
 Node sigmoid(const Node &x) {
-  return REGX(x, Sigmoid(), x)[0];
+  return REGX(x, Sigmoid, {x});
 }
 
 template<>
 Node softplus(const Node &x) {
-  return REGX(x, Softplus(), x)[0];
+  return REGX(x, Softplus, {x});
 }
 
 template<>
 Node sin(const Node &x) {
-  return REGX(x, Sin(), x)[0];
+  return REGX(x, Sin, {x});
 }
 
 template<>
 Node cos(const Node &x) {
-  return REGX(x, Cos(), x)[0];
+  return REGX(x, Cos, {x});
 }
 
 template<>
 Node tan(const Node &x) {
-  return REGX(x, Tan(), x)[0];
+  return REGX(x, Tan, {x});
 }
 
 template<>
 Node relu(const Node &x) {
-  return REGX(x, ReLU(), x)[0];
+  return REGX(x, ReLU, {x});
 }
 
 template<>
 Node lrelu(const Node &x) {
-  return REGX(x, LReLU(), x)[0];
+  return REGX(x, LReLU, {x});
 }
 
 template<>
 Node prelu(const Node &x, float a) {
-  return REGX(x, PReLU(a), x)[0];
+  return REGX(x, PReLU, {x}, a);
 }
 
 template<>
 Node elu(const Node &x, float a) {
-  return REGX(x, ELU(a), x)[0];
+  return REGX(x, ELU, {x}, a);
+}
+
+template<>
+Node dropout(const Node &x, float rate, bool enabled) {
+  if (!enabled) return x;
+  return REGX(x, Dropout, {x}, rate);
 }
 
 template<>
 Node max(const Node &x, std::uint32_t dim) {
-  return REGX(x, Max(dim), x)[0];
+  return REGX(x, Max, {x}, dim);
 }
 
 template<>
 Node min(const Node &x, std::uint32_t dim) {
-  return REGX(x, Min(dim), x)[0];
+  return REGX(x, Min, {x}, dim);
 }
 
 template<>
 Node sum(const Node &x, std::uint32_t dim) {
-  return REGX(x, Sum(dim), x)[0];
+  return REGX(x, Sum, {x}, dim);
 }
 
 template<>
 Node broadcast(const Node &x, std::uint32_t dim, std::uint32_t size) {
-  return REGX(x, Broadcast(dim, size), x)[0];
+  return REGX(x, Broadcast, {x}, dim, size);
 }
 
 template<>
 Node logsumexp(const Node &x, std::uint32_t dim) {
-  return REGX(x, LogSumExp(dim), x)[0];
+  return REGX(x, LogSumExp, {x}, dim);
 }
 
 template<>
@@ -289,18 +373,18 @@ Node softmax(const Node &x, std::uint32_t dim) {
 
 template<>
 Node softmax_cross_entropy(const Node &x, const Node &t, std::uint32_t dim) {
-  return REGX(x, SoftmaxCrossEntropy(dim), x, t)[0];
+  return REGX(x, SoftmaxCrossEntropy, {x, t}, dim);
 }
 
 template<>
 Node softmax_cross_entropy(
     const Node &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim) {
-  return REGX(x, SparseSoftmaxCrossEntropy(ids, dim), x)[0];
+  return REGX(x, SparseSoftmaxCrossEntropy, {x}, ids, dim);
 }
 
 template<>
 Node stop_gradient(const Node &x) {
-  return REGX(x, StopGradient(), x)[0];
+  return REGX(x, StopGradient, {x});
 }
 
 template<>
@@ -310,10 +394,8 @@ Node conv2d(
     std::uint32_t stride0, std::uint32_t stride1,
     std::uint32_t dilation0, std::uint32_t dilation1) {
   return REGX(
-      x,
-      Convolution2D(padding0, padding1, stride0, stride1, dilation0, dilation1),
-      x, w
-  )[0];
+      x, Convolution2D, {x, w},
+      padding0, padding1, stride0, stride1, dilation0, dilation1);
 }
 
 template<>
@@ -323,35 +405,32 @@ Node max_pool2d(
     std::uint32_t padding0, std::uint32_t padding1,
     std::uint32_t stride0, std::uint32_t stride1) {
   return REGX(
-      x,
-      MaxPooling2D(window0, window1, padding0, padding1, stride0, stride1),
-      x
-  )[0];
+      x, MaxPooling2D, {x},
+      window0, window1, padding0, padding1, stride0, stride1);
 }
 
 namespace batch {
 
 template<>
 Node pick(const Node &x, const std::vector<std::uint32_t> &ids) {
-  return REGX(x, BatchPick(ids), x)[0];
+  return REGX(x, BatchPick, {x}, ids);
 }
 
 template<>
 Node slice(const Node &x, std::uint32_t lower, std::uint32_t upper) {
-  return REGX(x, BatchSlice(lower, upper), x)[0];
+  return REGX(x, BatchSlice, {x}, lower, upper);
 }
 
 template<>
 std::vector<Node> split(const Node &x, std::uint32_t n) {
-  return REGX(x, BatchSplit(n), x);
+  return x.graph().add_operator(
+      std::unique_ptr<Operator>(new operators::BatchSplit(n)), {x});
 }
 
 template<>
 Node concat(const std::vector<Node> &xs) {
   if (xs.empty()) PRIMITIV_THROW_ERROR("No nodes to concat.");
-  return xs[0].graph().add_operator(
-      std::unique_ptr<Operator>(new operators::BatchConcat()), xs
-  )[0];
+  return xs[0].graph().emplace_operator<operators::BatchConcat>(xs);
 }
 
 template<>
@@ -361,7 +440,7 @@ Node concat(const std::vector<const Node *> &xs) {
 
 template<>
 Node sum(const Node &x) {
-  return REGX(x, BatchSum(), x)[0];
+  return REGX(x, BatchSum, {x});
 }
 
 }  // namespace batch
@@ -369,15 +448,15 @@ Node sum(const Node &x) {
 Node constant_node(const Shape &shape, float k, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      Constant(shape, k, Device::get_reference_or_default(dev))
-  )[0];
+      Constant, {}, shape, k, Device::get_reference_or_default(dev)
+  );
 }
 
 Node identity_node(std::uint32_t size, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      Identity(size, Device::get_reference_or_default(dev))
-  )[0];
+      Identity, {}, size, Device::get_reference_or_default(dev)
+  );
 }
 
 namespace random {
@@ -386,33 +465,34 @@ Node bernoulli_node(
     const Shape &shape, float p, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      RandomBernoulli(shape, p, Device::get_reference_or_default(dev))
-  )[0];
+      RandomBernoulli, {}, shape, p, Device::get_reference_or_default(dev)
+  );
 }
 
 Node uniform_node(
     const Shape &shape, float lower, float upper, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      RandomUniform(
-        shape, lower, upper, Device::get_reference_or_default(dev))
-  )[0];
+      RandomUniform, {},
+      shape, lower, upper, Device::get_reference_or_default(dev)
+  );
 }
 
 Node normal_node(
     const Shape &shape, float mean, float sd, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      RandomNormal(shape, mean, sd, Device::get_reference_or_default(dev))
-  )[0];
+      RandomNormal, {}, shape, mean, sd, Device::get_reference_or_default(dev)
+  );
 }
 
 Node log_normal_node(
     const Shape &shape, float mean, float sd, Device *dev, Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
-      RandomLogNormal(shape, mean, sd, Device::get_reference_or_default(dev))
-  )[0];
+      RandomLogNormal, {},
+      shape, mean, sd, Device::get_reference_or_default(dev)
+  );
 }
 
 Node gumbel_node(
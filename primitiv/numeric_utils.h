@@ -1,7 +1,13 @@
 #ifndef PRIMITIV_NUMERIC_UTILS_H_
 #define PRIMITIV_NUMERIC_UTILS_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif  // __F16C__
 
 namespace primitiv {
 namespace numeric_utils {
@@ -36,6 +42,170 @@ inline std::uint64_t calculate_shifts(std::uint64_t x) {
   return b - (1ull << (b - 1) == x);
 }
 
+/**
+ * Converts a single-precision float into an IEEE 754 half-precision float.
+ * @param x The input value.
+ * @return Bit pattern of the resulting half-precision value.
+ * @remarks Values are rounded to the nearest even, out-of-range values become
+ *          infinities, and NaNs are converted to quiet NaNs.
+ */
+inline std::uint16_t float_to_float16(float x) {
+  // This function uses floating-point additions to obtain the correct rounding
+  // of subnormals without any branches on the mantissa.
+  static const std::uint32_t f32_inf = 255u << 23;
+  static const std::uint32_t f16_max = (127u + 16u) << 23;
+  static const std::uint32_t denorm_magic_u = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  std::uint32_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  const std::uint32_t sign = u & 0x80000000u;
+  u ^= sign;
+
+  std::uint16_t ret;
+  if (u >= f16_max) {
+    // Infinity or NaN.
+    ret = u > f32_inf ? 0x7e00 : 0x7c00;
+  } else if (u < (113u << 23)) {
+    // Subnormal or zero.
+    float f, denorm_magic;
+    std::memcpy(&f, &u, sizeof(f));
+    std::memcpy(&denorm_magic, &denorm_magic_u, sizeof(denorm_magic));
+    f += denorm_magic;
+    std::memcpy(&u, &f, sizeof(u));
+    ret = static_cast<std::uint16_t>(u - denorm_magic_u);
+  } else {
+    // Normal number.
+    const std::uint32_t mant_odd = (u >> 13) & 1;
+    u += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xfff + mant_odd;
+    ret = static_cast<std::uint16_t>(u >> 13);
+  }
+  return ret | static_cast<std::uint16_t>(sign >> 16);
+}
+
+/**
+ * Converts an IEEE 754 half-precision float into a single-precision float.
+ * @param x Bit pattern of the half-precision value.
+ * @return The resulting value.
+ */
+inline float float16_to_float(std::uint16_t x) {
+  static const std::uint32_t shifted_exp = 0x7c00u << 13;
+  static const std::uint32_t magic_u = 113u << 23;
+
+  std::uint32_t u = (x & 0x7fffu) << 13;
+  const std::uint32_t exp = u & shifted_exp;
+  u += (127u - 15u) << 23;
+
+  float ret;
+  if (exp == shifted_exp) {
+    // Infinity or NaN.
+    u += (128u - 16u) << 23;
+    std::memcpy(&ret, &u, sizeof(ret));
+  } else if (exp == 0) {
+    // Subnormal or zero.
+    u += 1u << 23;
+    float magic;
+    std::memcpy(&ret, &u, sizeof(ret));
+    std::memcpy(&magic, &magic_u, sizeof(magic));
+    ret -= magic;
+  } else {
+    std::memcpy(&ret, &u, sizeof(ret));
+  }
+
+  std::memcpy(&u, &ret, sizeof(u));
+  u |= static_cast<std::uint32_t>(x & 0x8000u) << 16;
+  std::memcpy(&ret, &u, sizeof(ret));
+  return ret;
+}
+
+/**
+ * Converts a single-precision float into a bfloat16 value.
+ * @param x The input value.
+ * @return Bit pattern of the resulting bfloat16 value.
+ * @remarks Values are rounded to the nearest even, and NaNs are converted to
+ *          quiet NaNs.
+ */
+inline std::uint16_t float_to_bfloat16(float x) {
+  std::uint32_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  if ((u & 0x7fffffffu) > 0x7f800000u) {
+    return static_cast<std::uint16_t>((u >> 16) | 0x40u);
+  }
+  u += 0x7fffu + ((u >> 16) & 1u);
+  return static_cast<std::uint16_t>(u >> 16);
+}
+
+/**
+ * Converts a bfloat16 value into a single-precision float.
+ * @param x Bit pattern of the bfloat16 value.
+ * @return The resulting value.
+ */
+inline float bfloat16_to_float(std::uint16_t x) {
+  const std::uint32_t u = static_cast<std::uint32_t>(x) << 16;
+  float ret;
+  std::memcpy(&ret, &u, sizeof(ret));
+  return ret;
+}
+
+/**
+ * Converts an array of single-precision floats into half-precision floats.
+ * @param size Number of elements.
+ * @param src Pointer of the source array.
+ * @param dest Pointer of the destination array.
+ */
+inline void float_to_float16(
+    std::size_t size, const float *src, std::uint16_t *dest) {
+  std::size_t i = 0;
+#ifdef __F16C__
+  for (; i + 8 <= size; i += 8) {
+    const __m128i h = _mm256_cvtps_ph(
+        _mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), h);
+  }
+#endif  // __F16C__
+  for (; i < size; ++i) dest[i] = float_to_float16(src[i]);
+}
+
+/**
+ * Converts an array of half-precision floats into single-precision floats.
+ * @param size Number of elements.
+ * @param src Pointer of the source array.
+ * @param dest Pointer of the destination array.
+ */
+inline void float16_to_float(
+    std::size_t size, const std::uint16_t *src, float *dest) {
+  std::size_t i = 0;
+#ifdef __F16C__
+  for (; i + 8 <= size; i += 8) {
+    const __m128i h = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(h));
+  }
+#endif  // __F16C__
+  for (; i < size; ++i) dest[i] = float16_to_float(src[i]);
+}
+
+/**
+ * Converts an array of single-precision floats into bfloat16 values.
+ * @param size Number of elements.
+ * @param src Pointer of the source array.
+ * @param dest Pointer of the destination array.
+ */
+inline void float_to_bfloat16(
+    std::size_t size, const float *src, std::uint16_t *dest) {
+  for (std::size_t i = 0; i < size; ++i) dest[i] = float_to_bfloat16(src[i]);
+}
+
+/**
+ * Converts an array of bfloat16 values into single-precision floats.
+ * @param size Number of elements.
+ * @param src Pointer of the source array.
+ * @param dest Pointer of the destination array.
+ */
+inline void bfloat16_to_float(
+    std::size_t size, const std::uint16_t *src, float *dest) {
+  for (std::size_t i = 0; i < size; ++i) dest[i] = bfloat16_to_float(src[i]);
+}
+
 }  // namespace numeric_utils
 }  // namespace primitiv
 
@@ -582,15 +582,13 @@ std::shared_ptr<void> OpenCL::new_handle(const Shape &shape) {
   return state_->pool.allocate(sizeof(float) * shape.size());
 }
 
-std::vector<float> OpenCL::tensor_to_vector_impl(const Tensor &x) {
+void OpenCL::tensor_to_array_impl(const Tensor &x, float values[]) {
   const std::uint32_t size = x.shape().size();
-  std::vector<float> ret(size);
-  ::read_buffer(state_->queue, CDATA(x), ret.data(), size);
-  return ret;
+  ::read_buffer(state_->queue, CDATA(x), values, size);
 }
 
-std::vector<std::uint32_t> OpenCL::argmax_impl(
-    const Tensor &x, std::uint32_t dim) {
+void OpenCL::argmax_impl(
+    const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   const Shape &shape = x.shape();
   const std::uint32_t n = shape[dim];
   const std::uint32_t r = shape.size() / n;
@@ -622,13 +620,11 @@ std::vector<std::uint32_t> OpenCL::argmax_impl(
     CASE(1, 0);
 #undef CASE
   }
-  std::vector<std::uint32_t> ret(r);
-  ::read_buffer(state_->queue, ::get_buffer(py), ret.data(), r);
-  return ret;
+  ::read_buffer(state_->queue, ::get_buffer(py), ids, r);
 }
 
-std::vector<std::uint32_t> OpenCL::argmin_impl(
-    const Tensor &x, std::uint32_t dim) {
+void OpenCL::argmin_impl(
+    const Tensor &x, std::uint32_t dim, std::uint32_t ids[]) {
   const Shape &shape = x.shape();
   const std::uint32_t n = shape[dim];
   const std::uint32_t r = shape.size() / n;
@@ -660,9 +656,7 @@ std::vector<std::uint32_t> OpenCL::argmin_impl(
     CASE(1, 0);
 #undef CASE
   }
-  std::vector<std::uint32_t> ret(r);
-  ::read_buffer(state_->queue, ::get_buffer(py), ret.data(), r);
-  return ret;
+  ::read_buffer(state_->queue, ::get_buffer(py), ids, r);
 }
 
 void OpenCL::reset_tensor_impl(float k, Tensor &x) {
@@ -678,6 +672,7 @@ void OpenCL::reset_tensor_by_array_impl(const float values[], Tensor &x) {
 void OpenCL::copy_tensor_impl(const Tensor &x, Tensor &y) {
   switch (x.device().type()) {
     case Device::DeviceType::NAIVE:
+    case Device::DeviceType::EIGEN:
       reset_tensor_by_array(static_cast<const float *>(get_handle(x)), y);
       break;
     case Device::DeviceType::OPENCL:
@@ -10,6 +10,7 @@
 namespace primitiv {
 
 class Device;
+class Parameter;
 
 /**
  * Interface of the operator on the computation graph.
@@ -56,6 +57,13 @@ public:
    */
   virtual Device *get_device() const { return nullptr; }
 
+  /**
+   * Returns the Parameter object if the class refers it.
+   * @return A pointer of the Parameter object if the class refers it, or
+   *         nullptr otherwise.
+   */
+  virtual Parameter *get_parameter() const { return nullptr; }
+
   /**
    * Calculates only the resulting shape.
    * @param args Shapes of argument values.
@@ -97,12 +105,102 @@ public:
         << "`has inner values. Use `get_inner_values()` instead.");
   }
 
+  /**
+   * Returns whether the operator can calculate the return value in the memory
+   * of the first argument.
+   * @return `true` if `forward_inplace()` is available, `false` otherwise.
+   */
+  virtual bool supports_inplace_forward() const { return false; }
+
+  /**
+   * Calculates the forward operation by overwriting the first argument.
+   * @param args Argument tensors. `args[0]` points `ret`.
+   * @param ret Tensor which holds the value of the first argument, and is
+   *            overwritten by the return value.
+   * @remarks This function is called only if `supports_inplace_forward()`
+   *          returns `true`, and the first argument has the same shape as the
+   *          return value.
+   */
+  virtual void forward_inplace(
+      const std::vector<const Tensor *> &args, Tensor &ret) const {
+    static_cast<void>(args);
+    static_cast<void>(ret);
+    PRIMITIV_THROW_ERROR(
+        "Operator `" << name() << "` does not support in-place forward.");
+  }
+
+  /**
+   * Returns whether the operator always calculates the same results as another
+   * operator with the same arguments.
+   * @param other Another operator.
+   * @return `true` if `other` has the same type and attributes as this
+   *         operator and both are deterministic, `false` otherwise.
+   * @remarks This function is used to eliminate common subexpressions in the
+   *          computation graph. Operators which return different values for
+   *          each call (e.g., random numbers) should return `false`.
+   */
+  virtual bool equals(const Operator &other) const {
+    static_cast<void>(other);
+    return false;
+  }
+
+  /**
+   * Returns whether the operator can be calculated together with another
+   * operator by concatenating their arguments along the minibatch.
+   * @param other Another operator.
+   * @return `true` if `other` performs the same calculation for each minibatch
+   *         element as this operator, `false` otherwise.
+   * @remarks Batchable operators should have only one return value, and should
+   *          calculate each minibatch element independently.
+   */
+  virtual bool is_batchable_with(const Operator &other) const {
+    static_cast<void>(other);
+    return false;
+  }
+
+  /**
+   * Returns whether the backward operation propagates gradients to arguments.
+   * @return `false` if `backward()` never changes `args_g`, `true` otherwise.
+   */
+  virtual bool propagates_gradients() const { return true; }
+
+  /**
+   * Returns whether the backward operation refers values of arguments.
+   * @return `false` if `backward()` does not use `args_v`, `true` otherwise.
+   */
+  virtual bool uses_argument_values() const { return true; }
+
+  /**
+   * Returns whether the backward operation refers the value of the first
+   * argument when only gradients of some arguments are required.
+   * @param requires_grad Whether the gradient of each argument is required.
+   * @return `false` if `backward()` does not use `args_v[0]` in that case,
+   *         `true` otherwise.
+   */
+  virtual bool uses_first_argument_value(
+      const std::vector<bool> &requires_grad) const {
+    static_cast<void>(requires_grad);
+    return uses_argument_values();
+  }
+
+  /**
+   * Returns whether the backward operation refers values of return values.
+   * @return `false` if `backward()` does not use `rets_v`, `true` otherwise.
+   */
+  virtual bool uses_return_values() const { return true; }
+
   /**
    * Calculates the backward operation.
    * @param args_v Tensors of argument values.
    * @param rets_v Tensors of resulting values.
-   * @param rets_g Tensors of gradients of results.
-   * @param args_g Tensors of gradients of arguments.
+   * @param rets_g Tensors of gradients of results. Invalid tensors represent
+   *               gradients with 0.
+   * @param args_g Tensors of gradients of arguments. The gradients should be
+   *               accumulated to valid tensors, and invalid tensors represent
+   *               gradients which are not calculated yet and should be
+   *               overwritten. `nullptr` represents that the gradient of the
+   *               argument is not required, and is never given if the
+   *               operator has only one argument.
    * @remarks `args_v/g` and `rets_v/g` should have the same number of pointers
    *          with the value returned from `num_arguments()` and
    *          `num_returns()`.
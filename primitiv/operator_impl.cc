@@ -1,6 +1,7 @@
 #include <primitiv/config.h>
 
 #include <algorithm>
+#include <cstring>
 #include <primitiv/device.h>
 #include <primitiv/error.h>
 #include <primitiv/functions.h>
@@ -20,19 +21,33 @@ namespace operators {
  * Constructors.
  */
 
-Input::Input(const Shape &shape, const vector<float> &data, Device &device)
-: shape_(shape)
-, data_(data)
-, device_(device) {
-  if (data_.size() != shape_.size()) {
+namespace {
+
+void check_input_size(const Shape &shape, std::size_t size) {
+  if (size != shape.size()) {
     PRIMITIV_THROW_ERROR(
         "Data sizes mismatched."
         << " operator: Input"
-        << ", required: " << shape_.size() << " (" << shape_.to_string() << ")"
-        << ", actual: " << data_.size());
+        << ", required: " << shape.size() << " (" << shape.to_string() << ")"
+        << ", actual: " << size);
   }
 }
 
+}  // namespace
+
+Input::Input(const Shape &shape, const vector<float> &data, Device &device) {
+  check_input_size(shape, data.size());
+  value_ = device.new_tensor_by_vector(shape, data);
+}
+
+Input::Input(const Shape &shape, vector<float> &&data, Device &device) {
+  check_input_size(shape, data.size());
+  value_ = device.new_tensor_by_vector(shape, std::move(data));
+}
+
+Input::Input(const Shape &shape, const float *data, Device &device)
+: value_(device.new_tensor_by_borrowed_array(shape, data)) {}
+
 /*
  * Operator names.
  */
@@ -96,6 +111,7 @@ IMPL_NAME_1(PowConstR, k_);
 IMPL_NAME_1(PowConstL, k_);
 IMPL_NAME_1(PReLU, k_);
 IMPL_NAME_1(ELU, k_);
+IMPL_NAME_1(Dropout, rate_);
 
 IMPL_NAME_1(PowN, k_);
 
@@ -116,6 +132,7 @@ IMPL_NAME_0(Pow);
 
 IMPL_NAME_0(Transpose);
 IMPL_NAME_0(MatrixMultiply);
+IMPL_NAME_2(TransposedMatrixMultiply, transpose_a_, transpose_b_);
 
 IMPL_NAME_0(Sqrt);
 IMPL_NAME_0(Exp);
@@ -163,6 +180,160 @@ std::string MaxPooling2D::name() const {
 #undef IMPL_NAME_1
 #undef IMPL_NAME_2
 
+/*
+ * Operator equivalences.
+ */
+
+namespace {
+
+template<typename T>
+bool equal_attr(const T &a, const T &b) { return a == b; }
+
+// Floating point constants are compared by their bit patterns to distinguish
+// signed zeros and to match NaNs.
+bool equal_attr(float a, float b) {
+  std::uint32_t ia, ib;
+  std::memcpy(&ia, &a, sizeof(float));
+  std::memcpy(&ib, &b, sizeof(float));
+  return ia == ib;
+}
+
+// Devices and parameters are compared by their identities.
+bool equal_attr(const Device &a, const Device &b) { return &a == &b; }
+bool equal_attr(const primitiv::Parameter &a, const primitiv::Parameter &b) {
+  return &a == &b;
+}
+
+}  // namespace
+
+#define IMPL_NOT_EQUALS(cls) \
+  bool cls::equals(const Operator &other) const { \
+    UNUSED(other); \
+    return false; \
+  }
+#define IMPL_EQUALS_0(cls) \
+  bool cls::equals(const Operator &other) const { \
+    return dynamic_cast<const cls *>(&other) != nullptr; \
+  }
+#define IMPL_EQUALS_1(cls, k) \
+  bool cls::equals(const Operator &other) const { \
+    const cls *o = dynamic_cast<const cls *>(&other); \
+    return o && equal_attr(o->k, k); \
+  }
+#define IMPL_EQUALS_2(cls, k1, k2) \
+  bool cls::equals(const Operator &other) const { \
+    const cls *o = dynamic_cast<const cls *>(&other); \
+    return o && equal_attr(o->k1, k1) && equal_attr(o->k2, k2); \
+  }
+#define IMPL_EQUALS_3(cls, k1, k2, k3) \
+  bool cls::equals(const Operator &other) const { \
+    const cls *o = dynamic_cast<const cls *>(&other); \
+    return o && \
+      equal_attr(o->k1, k1) && \
+      equal_attr(o->k2, k2) && \
+      equal_attr(o->k3, k3); \
+  }
+
+// Inputs are not compared because their data can be large.
+IMPL_NOT_EQUALS(Input);
+IMPL_EQUALS_1(Parameter, param_);
+IMPL_EQUALS_1(Copy, device_);
+IMPL_EQUALS_3(Constant, shape_, k_, device_);
+IMPL_EQUALS_2(Identity, size_, device_);
+IMPL_NOT_EQUALS(RandomBernoulli);
+IMPL_NOT_EQUALS(RandomUniform);
+IMPL_NOT_EQUALS(RandomNormal);
+IMPL_NOT_EQUALS(RandomLogNormal);
+IMPL_EQUALS_2(Pick, ids_, dim_);
+IMPL_EQUALS_3(Slice, dim_, lower_, upper_);
+IMPL_EQUALS_2(Split, dim_, n_);
+IMPL_EQUALS_1(Concat, dim_);
+IMPL_EQUALS_1(Reshape, shape_);
+IMPL_EQUALS_1(Max, dim_);
+IMPL_EQUALS_1(Min, dim_);
+IMPL_EQUALS_1(Sum, dim_);
+IMPL_EQUALS_1(LogSumExp, dim_);
+IMPL_EQUALS_2(Broadcast, dim_, size_);
+IMPL_EQUALS_1(SoftmaxCrossEntropy, dim_);
+IMPL_EQUALS_2(SparseSoftmaxCrossEntropy, ids_, dim_);
+IMPL_EQUALS_0(StopGradient);
+IMPL_EQUALS_0(Flatten);
+IMPL_EQUALS_0(Positive);
+IMPL_EQUALS_0(Negative);
+
+IMPL_EQUALS_1(AddConst, k_);
+IMPL_EQUALS_1(SubtractConstR, k_);
+IMPL_EQUALS_1(SubtractConstL, k_);
+IMPL_EQUALS_1(MultiplyConst, k_);
+IMPL_EQUALS_1(DivideConstR, k_);
+IMPL_EQUALS_1(DivideConstL, k_);
+IMPL_EQUALS_1(PowConstR, k_);
+IMPL_EQUALS_1(PowConstL, k_);
+IMPL_EQUALS_1(PReLU, k_);
+IMPL_EQUALS_1(ELU, k_);
+IMPL_NOT_EQUALS(Dropout);
+
+IMPL_EQUALS_1(PowN, k_);
+
+IMPL_EQUALS_0(AddScalar);
+IMPL_EQUALS_0(SubtractScalarR);
+IMPL_EQUALS_0(SubtractScalarL);
+IMPL_EQUALS_0(MultiplyScalar);
+IMPL_EQUALS_0(DivideScalarR);
+IMPL_EQUALS_0(DivideScalarL);
+IMPL_EQUALS_0(PowScalarR);
+IMPL_EQUALS_0(PowScalarL);
+
+IMPL_EQUALS_0(Add);
+IMPL_EQUALS_0(Subtract);
+IMPL_EQUALS_0(Multiply);
+IMPL_EQUALS_0(Divide);
+IMPL_EQUALS_0(Pow);
+
+IMPL_EQUALS_0(Transpose);
+IMPL_EQUALS_0(MatrixMultiply);
+IMPL_EQUALS_2(TransposedMatrixMultiply, transpose_a_, transpose_b_);
+
+IMPL_EQUALS_0(Sqrt);
+IMPL_EQUALS_0(Exp);
+IMPL_EQUALS_0(Log);
+IMPL_EQUALS_0(Tanh);
+IMPL_EQUALS_0(Sigmoid);
+IMPL_EQUALS_0(Softplus);
+IMPL_EQUALS_0(Sin);
+IMPL_EQUALS_0(Cos);
+IMPL_EQUALS_0(Tan);
+IMPL_EQUALS_0(ReLU);
+IMPL_EQUALS_0(LReLU);
+
+IMPL_EQUALS_1(BatchPick, ids_);
+IMPL_EQUALS_2(BatchSlice, lower_, upper_);
+IMPL_EQUALS_1(BatchSplit, n_);
+IMPL_EQUALS_0(BatchConcat);
+IMPL_EQUALS_0(BatchSum);
+
+bool Convolution2D::equals(const Operator &other) const {
+  const Convolution2D *o = dynamic_cast<const Convolution2D *>(&other);
+  return o &&
+    o->padding0_ == padding0_ && o->padding1_ == padding1_ &&
+    o->stride0_ == stride0_ && o->stride1_ == stride1_ &&
+    o->dilation0_ == dilation0_ && o->dilation1_ == dilation1_;
+}
+
+bool MaxPooling2D::equals(const Operator &other) const {
+  const MaxPooling2D *o = dynamic_cast<const MaxPooling2D *>(&other);
+  return o &&
+    o->window0_ == window0_ && o->window1_ == window1_ &&
+    o->padding0_ == padding0_ && o->padding1_ == padding1_ &&
+    o->stride0_ == stride0_ && o->stride1_ == stride1_;
+}
+
+#undef IMPL_NOT_EQUALS
+#undef IMPL_EQUALS_0
+#undef IMPL_EQUALS_1
+#undef IMPL_EQUALS_2
+#undef IMPL_EQUALS_3
+
 /*
  * Shape forwarding operations.
  */
@@ -181,7 +352,7 @@ std::string MaxPooling2D::name() const {
 #define FWD_SHAPE_ELEMENTWISE(name) \
   FWD_SHAPE(name) { *y[0] = shape_ops::elementwise(*x[0], *x[1]); }
 
-FWD_SHAPE(Input) { UNUSED(x); *y[0] = shape_; }
+FWD_SHAPE(Input) { UNUSED(x); *y[0] = value_.shape(); }
 FWD_SHAPE(Parameter) { UNUSED(x); *y[0] = param_.shape(); }
 FWD_SHAPE(Copy) { *y[0] = *x[0]; }
 FWD_SHAPE(Constant) { UNUSED(x); *y[0] = shape_; }
@@ -235,6 +406,7 @@ FWD_SHAPE_UNARY(ReLU);
 FWD_SHAPE_UNARY(LReLU);
 FWD_SHAPE_UNARY(PReLU);
 FWD_SHAPE_UNARY(ELU);
+FWD_SHAPE_UNARY(Dropout);
 FWD_SHAPE_UNARY(PowN);
 FWD_SHAPE_SCALAR(AddScalar);
 FWD_SHAPE_SCALAR(SubtractScalarR);
@@ -251,6 +423,9 @@ FWD_SHAPE_ELEMENTWISE(Divide);
 FWD_SHAPE_ELEMENTWISE(Pow);
 FWD_SHAPE(Transpose) { *y[0] = shape_ops::transpose(*x[0]); }
 FWD_SHAPE(MatrixMultiply) { *y[0] = shape_ops::matmul(*x[0], *x[1]); }
+FWD_SHAPE(TransposedMatrixMultiply) {
+  *y[0] = shape_ops::matmul(*x[0], *x[1], transpose_a_, transpose_b_);
+}
 FWD_SHAPE(Max) { *y[0] = x[0]->resize_dim(dim_, 1); }
 FWD_SHAPE(Min) { *y[0] = x[0]->resize_dim(dim_, 1); }
 FWD_SHAPE(Sum) { *y[0] = x[0]->resize_dim(dim_, 1); }
@@ -287,6 +462,12 @@ FWD_SHAPE(MaxPooling2D) {
       *x[0], window0_, window1_, padding0_, padding1_, stride0_, stride1_);
 }
 FWD_SHAPE(SoftmaxCrossEntropy) {
+  // Dimensions are not broadcasted unlike other elementwise operations.
+  if (!x[0]->has_same_dims(*x[1])) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched for the softmax cross entropy. "
+        "x: " << x[0]->to_string() << " != t: " << x[1]->to_string());
+  }
   *y[0] = shape_ops::elementwise(*x[0], *x[1]);
   y[0]->update_dim(dim_, 1);
 }
@@ -319,7 +500,7 @@ vector<const Tensor *> Parameter::get_inner_values() const {
 
 FORWARD(Input) {
   UNUSED(x);
-  *y[0] = functions::input<Tensor>(shape_, data_, device_);
+  *y[0] = value_;
 }
 
 FORWARD(Copy) { *y[0] = functions::copy(*x[0], device_); }
@@ -389,6 +570,7 @@ FORWARD(PowConstR) { *y[0] = functions::pow(*x[0], k_); }
 FORWARD(PowConstL) { *y[0] = functions::pow(k_, *x[0]); }
 FORWARD(PReLU) { *y[0] = functions::prelu(*x[0], k_); }
 FORWARD(ELU) { *y[0] = functions::elu(*x[0], k_); }
+FORWARD(Dropout) { *y[0] = x[0]->device().dropout_fw(*x[0], rate_, mask_); }
 
 FORWARD(PowN) { *y[0] = functions::pown(*x[0], k_); }
 
@@ -409,6 +591,9 @@ FORWARD(Pow) { *y[0] = functions::pow(*x[0], *x[1]); }
 
 FORWARD(Transpose) { *y[0] = functions::transpose(*x[0]); }
 FORWARD(MatrixMultiply) { *y[0] = functions::matmul(*x[0], *x[1]); }
+FORWARD(TransposedMatrixMultiply) {
+  *y[0] = x[0]->device().matmul_fw(*x[0], *x[1], transpose_a_, transpose_b_);
+}
 
 FORWARD(Sum) { *y[0] = functions::sum(*x[0], dim_); }
 FORWARD(LogSumExp) { *y[0] = functions::logsumexp(*x[0], dim_); }
@@ -457,10 +642,103 @@ FORWARD(StopGradient) { *y[0] = *x[0]; }
 
 #undef FORWARD
 
+/*
+ * In-place forward operations.
+ */
+
+#define FORWARD_INPLACE(name) \
+  void name::forward_inplace( \
+      const vector<const Tensor *> &x, \
+      Tensor &y) const
+
+#define FORWARD_INPLACE_X(name, fw) \
+  FORWARD_INPLACE(name) { \
+    UNUSED(x); \
+    y = y.device().fw(std::move(y)); \
+  }
+
+#define FORWARD_INPLACE_X_CONST(name, fw, k) \
+  FORWARD_INPLACE(name) { \
+    UNUSED(x); \
+    y = y.device().fw(std::move(y), k); \
+  }
+
+#define FORWARD_INPLACE_AB(name, fw) \
+  FORWARD_INPLACE(name) { y = y.device().fw(std::move(y), *x[1]); }
+
+FORWARD_INPLACE_X(Negative, negate_fw);
+FORWARD_INPLACE_X(Sqrt, sqrt_fw);
+FORWARD_INPLACE_X(Exp, exp_fw);
+FORWARD_INPLACE_X(Log, log_fw);
+FORWARD_INPLACE_X(Tanh, tanh_fw);
+FORWARD_INPLACE_X(Sigmoid, sigmoid_fw);
+FORWARD_INPLACE_X(Softplus, softplus_fw);
+FORWARD_INPLACE_X(Sin, sin_fw);
+FORWARD_INPLACE_X(Cos, cos_fw);
+FORWARD_INPLACE_X(Tan, tan_fw);
+FORWARD_INPLACE_X_CONST(ReLU, prelu_fw, 0);
+FORWARD_INPLACE_X_CONST(LReLU, prelu_fw, .01);
+
+FORWARD_INPLACE_X_CONST(AddConst, add_const_fw, k_);
+FORWARD_INPLACE_X_CONST(SubtractConstR, subtract_const_r_fw, k_);
+FORWARD_INPLACE_X_CONST(SubtractConstL, subtract_const_l_fw, k_);
+FORWARD_INPLACE_X_CONST(MultiplyConst, multiply_const_fw, k_);
+FORWARD_INPLACE_X_CONST(DivideConstR, divide_const_r_fw, k_);
+FORWARD_INPLACE_X_CONST(DivideConstL, divide_const_l_fw, k_);
+FORWARD_INPLACE_X_CONST(PowConstR, pow_const_r_fw, k_);
+FORWARD_INPLACE_X_CONST(PowConstL, pow_const_l_fw, k_);
+FORWARD_INPLACE_X_CONST(PReLU, prelu_fw, k_);
+FORWARD_INPLACE_X_CONST(ELU, elu_fw, k_);
+
+FORWARD_INPLACE_AB(Add, add_fw);
+FORWARD_INPLACE_AB(Subtract, subtract_fw);
+FORWARD_INPLACE_AB(Multiply, multiply_fw);
+FORWARD_INPLACE_AB(Divide, divide_fw);
+FORWARD_INPLACE_AB(Pow, pow_fw);
+
+#undef FORWARD_INPLACE_X
+#undef FORWARD_INPLACE_X_CONST
+#undef FORWARD_INPLACE_AB
+#undef FORWARD_INPLACE
+
 /*
  * Backward operations.
  */
 
+namespace {
+
+// Gradients of arguments given to Operator::backward() are invalid until the
+// first operator propagates values to them. Following functions overwrite such
+// gradients directly instead of accumulating values to zero-filled tensors.
+
+// Fills 0 to the gradient `gx` of the argument `x` if it is not calculated.
+Tensor &init_gradient(const Tensor &x, Tensor &gx) {
+  if (!gx.valid()) gx = functions::zeros<Tensor>(x.shape(), x.device());
+  return gx;
+}
+
+// gx += v
+void add_gradient(const Tensor &x, const Tensor &v, Tensor &gx) {
+  if (gx.valid()) gx += v;
+  else if (v.shape() == x.shape()) gx = v;
+  else init_gradient(x, gx) += v;
+}
+
+// gx -= v
+void subtract_gradient(const Tensor &x, const Tensor &v, Tensor &gx) {
+  if (gx.valid()) gx -= v;
+  else if (v.shape() == x.shape()) gx = -v;
+  else init_gradient(x, gx) -= v;
+}
+
+// Returns `*gx` if the gradient is required, or the temporary `dummy`.
+// This is used for kernels which always calculate gradients of all arguments.
+Tensor &required_or(Tensor *gx, Tensor &dummy) {
+  return gx ? *gx : dummy;
+}
+
+}  // namespace
+
 #define BACKWARD(name) \
   void name::backward( \
       const vector<const Tensor *> &x, \
@@ -481,9 +759,8 @@ BACKWARD(Parameter) {
 }
 
 BACKWARD(Copy) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += functions::copy(*gy[0], gx[0]->device());
+  add_gradient(*x[0], functions::copy(*gy[0], x[0]->device()), *gx[0]);
 }
 
 BACKWARD_NOP(Constant);
@@ -494,58 +771,57 @@ BACKWARD_NOP(RandomNormal);
 BACKWARD_NOP(RandomLogNormal);
 
 BACKWARD(Pick) {
-  UNUSED(x);
   UNUSED(y);
-  gy[0]->device().pick_bw(*gy[0], ids_, dim_, *gx[0]);
+  gy[0]->device().pick_bw(*gy[0], ids_, dim_, init_gradient(*x[0], *gx[0]));
 }
 
 BACKWARD(Slice) {
-  UNUSED(x);
   UNUSED(y);
-  gy[0]->device().slice_bw(*gy[0], dim_, lower_, *gx[0]);
+  gy[0]->device().slice_bw(*gy[0], dim_, lower_, init_gradient(*x[0], *gx[0]));
 }
 
 BACKWARD(Split) {
-  UNUSED(x);
-  UNUSED(y);
-  Device &dev = gy[0]->device();
-  const std::uint32_t span = gy[0]->shape()[dim_];
+  // Invalid gradients of unused return values are skipped.
+  Device &dev = x[0]->device();
+  const std::uint32_t span = y[0]->shape()[dim_];
+  init_gradient(*x[0], *gx[0]);
   for (std::uint32_t i = 0; i < n_; ++i) {
-    dev.slice_bw(*gy[i], dim_, i * span, *gx[0]);
+    if (gy[i]->valid()) dev.slice_bw(*gy[i], dim_, i * span, *gx[0]);
   }
 }
 
 BACKWARD(Concat) {
-  UNUSED(x);
   UNUSED(y);
   std::uint32_t offset = 0;
-  for (Tensor *gxi : gx) {
-    const std::uint32_t span = gxi->shape()[dim_];
-    *gxi += functions::slice(*gy[0], dim_, offset, offset + span);
+  for (std::uint32_t i = 0; i < x.size(); ++i) {
+    const std::uint32_t span = x[i]->shape()[dim_];
+    if (gx[i]) {
+      add_gradient(
+          *x[i], functions::slice(*gy[0], dim_, offset, offset + span),
+          *gx[i]);
+    }
     offset += span;
   }
 }
 
 BACKWARD(Reshape) {
   UNUSED(y);
-  *gx[0] += gy[0]->reshape(x[0]->shape());
+  add_gradient(*x[0], gy[0]->reshape(x[0]->shape()), *gx[0]);
 }
 
 BACKWARD(Flatten) {
   UNUSED(y);
-  *gx[0] += gy[0]->reshape(x[0]->shape());
+  add_gradient(*x[0], gy[0]->reshape(x[0]->shape()), *gx[0]);
 }
 
 BACKWARD(Positive) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += *gy[0];
+  add_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(Negative) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] -= *gy[0];
+  subtract_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(Sqrt) {
@@ -584,12 +860,16 @@ BACKWARD(Tan) {
   gy[0]->device().tan_bw(*x[0], *y[0], *gy[0], *gx[0]);
 }
 
+// ReLU and LReLU use `y` instead of `x` because both have the same sign, so
+// that the memory of `x` can be reused by the in-place forward.
 BACKWARD(ReLU) {
-  gy[0]->device().prelu_bw(*x[0], *y[0], *gy[0], 0, *gx[0]);
+  UNUSED(x);
+  gy[0]->device().prelu_bw(*y[0], *y[0], *gy[0], 0, *gx[0]);
 }
 
 BACKWARD(LReLU) {
-  gy[0]->device().prelu_bw(*x[0], *y[0], *gy[0], .01, *gx[0]);
+  UNUSED(x);
+  gy[0]->device().prelu_bw(*y[0], *y[0], *gy[0], .01, *gx[0]);
 }
 
 BACKWARD(Transpose) {
@@ -597,15 +877,18 @@ BACKWARD(Transpose) {
 }
 
 BACKWARD(AddConst) {
-  gy[0]->device().add_const_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
+  UNUSED(y);
+  add_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(SubtractConstR) {
-  gy[0]->device().subtract_const_r_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
+  UNUSED(y);
+  add_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(SubtractConstL) {
-  gy[0]->device().subtract_const_l_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
+  UNUSED(y);
+  subtract_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(MultiplyConst) {
@@ -636,83 +919,168 @@ BACKWARD(ELU) {
   gy[0]->device().elu_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
 }
 
+BACKWARD(Dropout) {
+  UNUSED(x);
+  UNUSED(y);
+  gy[0]->device().dropout_bw(*gy[0], mask_, rate_, *gx[0]);
+}
+
 BACKWARD(PowN) {
   gy[0]->device().pown_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
 }
 
 BACKWARD(AddScalar) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += *gy[0];
-  *gx[1] += functions::sum(gy[0]->flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], *gy[0], *gx[0]);
+  if (gx[1]) add_gradient(*x[1], functions::sum(gy[0]->flatten(), 0), *gx[1]);
 }
 
 BACKWARD(SubtractScalarR) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += *gy[0];
-  *gx[1] -= functions::sum(gy[0]->flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], *gy[0], *gx[0]);
+  if (gx[1]) {
+    subtract_gradient(*x[1], functions::sum(gy[0]->flatten(), 0), *gx[1]);
+  }
 }
 
 BACKWARD(SubtractScalarL) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] -= *gy[0];
-  *gx[1] += functions::sum(gy[0]->flatten(), 0);
+  if (gx[0]) subtract_gradient(*x[0], *gy[0], *gx[0]);
+  if (gx[1]) add_gradient(*x[1], functions::sum(gy[0]->flatten(), 0), *gx[1]);
 }
 
 BACKWARD(MultiplyScalar) {
   UNUSED(y);
-  *gx[0] += *x[1] * *gy[0];
-  *gx[1] += functions::sum((*x[0] * *gy[0]).flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], *x[1] * *gy[0], *gx[0]);
+  if (gx[1]) {
+    add_gradient(
+        *x[1], functions::sum((*x[0] * *gy[0]).flatten(), 0), *gx[1]);
+  }
 }
 
 BACKWARD(DivideScalarR) {
   const Tensor a = *gy[0] / *x[1];
-  *gx[0] += a;
-  *gx[1] -= functions::sum((a * *y[0]).flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], a, *gx[0]);
+  if (gx[1]) {
+    subtract_gradient(
+        *x[1], functions::sum((a * *y[0]).flatten(), 0), *gx[1]);
+  }
 }
 
 BACKWARD(DivideScalarL) {
   const Tensor a = *gy[0] / *x[0];
-  *gx[0] -= a * *y[0];
-  *gx[1] += functions::sum(a.flatten(), 0);
+  if (gx[0]) subtract_gradient(*x[0], a * *y[0], *gx[0]);
+  if (gx[1]) add_gradient(*x[1], functions::sum(a.flatten(), 0), *gx[1]);
 }
 
 BACKWARD(PowScalarR) {
   const Tensor a = *gy[0] * *y[0];
-  *gx[0] += a * *x[1] / *x[0];
-  *gx[1] += functions::sum((a * functions::log(*x[0])).flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], a * *x[1] / *x[0], *gx[0]);
+  if (gx[1]) {
+    add_gradient(
+        *x[1], functions::sum((a * functions::log(*x[0])).flatten(), 0),
+        *gx[1]);
+  }
 }
 
 BACKWARD(PowScalarL) {
   const Tensor a = *gy[0] * *y[0];
-  *gx[0] += a * functions::log(*x[1]);
-  *gx[1] += functions::sum((a * *x[0] / *x[1]).flatten(), 0);
+  if (gx[0]) add_gradient(*x[0], a * functions::log(*x[1]), *gx[0]);
+  if (gx[1]) {
+    add_gradient(
+        *x[1], functions::sum((a * *x[0] / *x[1]).flatten(), 0), *gx[1]);
+  }
 }
 
 BACKWARD(Add) {
-  gy[0]->device().add_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  if (x[0]->shape() == y[0]->shape() && x[1]->shape() == y[0]->shape()) {
+    // Both gradients are gy itself without broadcasting.
+    if (gx[0]) add_gradient(*x[0], *gy[0], *gx[0]);
+    if (gx[1]) add_gradient(*x[1], *gy[0], *gx[1]);
+    return;
+  }
+  Tensor dummy;
+  gy[0]->device().add_bw(
+      *x[0], *x[1], *y[0], *gy[0],
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(Subtract) {
-  gy[0]->device().subtract_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  if (x[0]->shape() == y[0]->shape() && x[1]->shape() == y[0]->shape()) {
+    // Both gradients are +/-gy without broadcasting.
+    if (gx[0]) add_gradient(*x[0], *gy[0], *gx[0]);
+    if (gx[1]) subtract_gradient(*x[1], *gy[0], *gx[1]);
+    return;
+  }
+  Tensor dummy;
+  gy[0]->device().subtract_bw(
+      *x[0], *x[1], *y[0], *gy[0],
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(Multiply) {
-  gy[0]->device().multiply_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  Tensor dummy;
+  gy[0]->device().multiply_bw(
+      *x[0], *x[1], *y[0], *gy[0],
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(Divide) {
-  gy[0]->device().divide_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  Tensor dummy;
+  gy[0]->device().divide_bw(
+      *x[0], *x[1], *y[0], *gy[0],
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(Pow) {
-  gy[0]->device().pow_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  Tensor dummy;
+  gy[0]->device().pow_bw(
+      *x[0], *x[1], *y[0], *gy[0],
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(MatrixMultiply) {
-  gy[0]->device().matmul_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+  Device &dev = gy[0]->device();
+  if (gx[0] && gx[1]) {
+    dev.matmul_bw(*x[0], *x[1], *y[0], *gy[0], *gx[0], *gx[1]);
+    return;
+  }
+  // Calculates only the required gradient: ga = gy . b^T, gb = a^T . gy
+  if (gx[0]) {
+    add_gradient(*x[0], dev.matmul_fw(*gy[0], *x[1], false, true), *gx[0]);
+  }
+  if (gx[1]) {
+    add_gradient(*x[1], dev.matmul_fw(*x[0], *gy[0], true, false), *gx[1]);
+  }
+}
+
+BACKWARD(TransposedMatrixMultiply) {
+  Device &dev = gy[0]->device();
+  if (gx[0] && gx[1]) {
+    dev.matmul_bw(
+        *x[0], *x[1], *y[0], *gy[0], transpose_a_, transpose_b_,
+        *gx[0], *gx[1]);
+    return;
+  }
+  // Calculates only the required gradient:
+  //   ga = gy . op(b)^T   (or its transpose if transpose_a),
+  //   gb = op(a)^T . gy   (or its transpose if transpose_b).
+  if (gx[0]) {
+    add_gradient(
+        *x[0],
+        transpose_a_
+          ? dev.matmul_fw(*x[1], *gy[0], transpose_b_, true)
+          : dev.matmul_fw(*gy[0], *x[1], false, !transpose_b_),
+        *gx[0]);
+  }
+  if (gx[1]) {
+    add_gradient(
+        *x[1],
+        transpose_b_
+          ? dev.matmul_fw(*gy[0], *x[0], true, transpose_a_)
+          : dev.matmul_fw(*x[0], *gy[0], !transpose_a_, false),
+        *gx[1]);
+  }
 }
 
 BACKWARD(Max) {
@@ -725,67 +1093,70 @@ BACKWARD(Min) {
 
 BACKWARD(Sum) {
   UNUSED(y);
-  *gx[0] += functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]);
+  add_gradient(
+      *x[0], functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]), *gx[0]);
 }
 
 BACKWARD(LogSumExp) {
   // NOTE(odashi): dy/dx = softmax(x) = exp(x - y)
   const std::uint32_t n = x[0]->shape()[dim_];
-  *gx[0]
-    += functions::exp(*x[0] - functions::broadcast(*y[0], dim_, n))
-    * functions::broadcast(*gy[0], dim_, n);
+  add_gradient(
+      *x[0],
+      functions::exp(*x[0] - functions::broadcast(*y[0], dim_, n))
+      * functions::broadcast(*gy[0], dim_, n),
+      *gx[0]);
 }
 
 BACKWARD(Broadcast) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += functions::sum(*gy[0], dim_);
+  add_gradient(*x[0], functions::sum(*gy[0], dim_), *gx[0]);
 }
 
 BACKWARD(BatchPick) {
-  UNUSED(x);
   UNUSED(y);
-  gy[0]->device().batch_pick_bw(*gy[0], ids_, *gx[0]);
+  gy[0]->device().batch_pick_bw(*gy[0], ids_, init_gradient(*x[0], *gx[0]));
 }
 
 BACKWARD(BatchSlice) {
-  UNUSED(x);
   UNUSED(y);
-  gy[0]->device().batch_slice_bw(*gy[0], lower_, *gx[0]);
+  gy[0]->device().batch_slice_bw(*gy[0], lower_, init_gradient(*x[0], *gx[0]));
 }
 
 BACKWARD(BatchSplit) {
-  UNUSED(x);
-  UNUSED(y);
-  Device &dev = gy[0]->device();
-  const std::uint32_t span = gy[0]->shape().batch();
+  // Invalid gradients of unused return values are skipped.
+  Device &dev = x[0]->device();
+  const std::uint32_t span = y[0]->shape().batch();
+  init_gradient(*x[0], *gx[0]);
   for (std::uint32_t i = 0; i < n_; ++i) {
-    dev.batch_slice_bw(*gy[i], i * span, *gx[0]);
+    if (gy[i]->valid()) dev.batch_slice_bw(*gy[i], i * span, *gx[0]);
   }
 }
 
 BACKWARD(BatchConcat) {
-  UNUSED(x);
   UNUSED(y);
   std::uint32_t offset = 0;
-  for (Tensor *gxi : gx) {
-    const std::uint32_t span = gxi->shape().batch();
-    *gxi += functions::batch::slice(*gy[0], offset, offset + span);
+  for (std::uint32_t i = 0; i < x.size(); ++i) {
+    const std::uint32_t span = x[i]->shape().batch();
+    if (gx[i]) {
+      add_gradient(
+          *x[i], functions::batch::slice(*gy[0], offset, offset + span),
+          *gx[i]);
+    }
     offset += span;
   }
 }
 
 BACKWARD(BatchSum) {
-  UNUSED(x);
   UNUSED(y);
-  *gx[0] += *gy[0];
+  add_gradient(*x[0], *gy[0], *gx[0]);
 }
 
 BACKWARD(Convolution2D) {
+  Tensor dummy;
   gy[0]->device().conv2d_bw(
       *x[0], *x[1], *y[0], *gy[0],
       padding0_, padding1_, stride0_, stride1_, dilation0_, dilation1_,
-      *gx[0], *gx[1]);
+      required_or(gx[0], dummy), required_or(gx[1], dummy));
 }
 
 BACKWARD(MaxPooling2D) {
@@ -800,8 +1171,11 @@ BACKWARD(SoftmaxCrossEntropy) {
   const Tensor log_softmax_x = functions::log_softmax(*x[0], dim_);
   const Tensor bcast_gy = functions::broadcast(
       *gy[0], dim_, x[0]->shape()[dim_]);
-  *gx[0] += (functions::exp(log_softmax_x) - *x[1]) * bcast_gy;
-  *gx[1] -= log_softmax_x * bcast_gy;
+  if (gx[0]) {
+    add_gradient(
+        *x[0], (functions::exp(log_softmax_x) - *x[1]) * bcast_gy, *gx[0]);
+  }
+  if (gx[1]) subtract_gradient(*x[1], log_softmax_x * bcast_gy, *gx[1]);
 }
 
 BACKWARD(SparseSoftmaxCrossEntropy) {
@@ -809,13 +1183,17 @@ BACKWARD(SparseSoftmaxCrossEntropy) {
   //       = gy * softmax(x) - gy * delta(x, i)
   UNUSED(y);
 #ifdef PRIMITIV_USE_CACHE
-  *gx[0]
-    += functions::exp(log_softmax_x_)
-    * functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]);
+  add_gradient(
+      *x[0],
+      functions::exp(log_softmax_x_)
+      * functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]),
+      *gx[0]);
 #else
-  *gx[0]
-    += functions::softmax(*x[0], dim_)
-    * functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]);
+  add_gradient(
+      *x[0],
+      functions::softmax(*x[0], dim_)
+      * functions::broadcast(*gy[0], dim_, x[0]->shape()[dim_]),
+      *gx[0]);
 #endif  // PRIMITIV_USE_CACHE
   gy[0]->device().pick_bw(-*gy[0], ids_, dim_, *gx[0]);
 }
@@ -15,6 +15,7 @@ namespace operators {
 #define PRIMITIV_DECL_DEFAULTS(argn, retn, inval) \
 public: \
   std::string name() const override; \
+  bool equals(const Operator &other) const override; \
   std::uint32_t num_arguments() const override { return argn; }; \
   std::uint32_t num_returns() const override { return retn; }; \
   bool has_inner_values() const override { return inval; }; \
@@ -34,15 +35,47 @@ public: \
       const std::vector<const Tensor *> &args, \
       const std::vector<Tensor *> &rets) const override;
 
+// Declares which values are used by the backward operation.
+#define PRIMITIV_DECL_USED_VALUES(args_v, rets_v) \
+public: \
+  bool uses_argument_values() const override { return args_v; } \
+  bool uses_return_values() const override { return rets_v; }
+
+// Declares the in-place forward operation.
+#define PRIMITIV_DECL_INPLACE_FORWARD \
+public: \
+  bool supports_inplace_forward() const override { return true; } \
+  void forward_inplace( \
+      const std::vector<const Tensor *> &args, Tensor &ret) const override;
+
+// Declares that the operator can be batched with the same operator.
+#define PRIMITIV_DECL_BATCHABLE(name_) \
+public: \
+  bool is_batchable_with(const Operator &other) const override { \
+    return dynamic_cast<const name_ *>(&other) != nullptr; \
+  }
+
+// Declares that the operator can be batched with the same operator which has
+// the same constant.
+#define PRIMITIV_DECL_BATCHABLE_K(name_) \
+public: \
+  bool is_batchable_with(const Operator &other) const override { \
+    const name_ *o = dynamic_cast<const name_ *>(&other); \
+    return o && o->k_ == k_; \
+  }
+
 class Input : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   Input(const Shape &shape, const std::vector<float> &data, Device &device);
-  Device *get_device() const override { return &device_; }
+  Input(const Shape &shape, std::vector<float> &&data, Device &device);
+  Input(const Shape &shape, const float *data, Device &device);
+  Device *get_device() const override { return &value_.device(); }
 private:
-  Shape shape_;
-  std::vector<float> data_;
-  Device &device_;
+  // The value is made when the operator is created, and is shared with the
+  // results of `forward()`. The data is transferred to the device only once.
+  Tensor value_;
 };
 
 class Parameter : public Operator {
@@ -50,6 +83,7 @@ class Parameter : public Operator {
 public:
   explicit Parameter(primitiv::Parameter &param) : param_(param) {}
   Device *get_device() const override { return &param_.device(); }
+  primitiv::Parameter *get_parameter() const override { return &param_; }
   std::vector<const Tensor *> get_inner_values() const override;
 private:
   primitiv::Parameter &param_;
@@ -66,6 +100,7 @@ private:
 
 class Constant : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   Constant(const Shape &shape, float k, Device &device)
     : shape_(shape), k_(k), device_(device) {}
@@ -78,6 +113,7 @@ private:
 
 class Identity : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   Identity(std::uint32_t size, Device &device) : size_(size), device_(device) {}
   Device *get_device() const override { return &device_; }
@@ -88,6 +124,7 @@ private:
 
 class RandomBernoulli : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   RandomBernoulli(const Shape &shape, float p, Device &device)
     : shape_(shape), p_(p), device_(device) {}
@@ -100,6 +137,7 @@ private:
 
 class RandomUniform : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   RandomUniform(const Shape &shape, float lower, float upper, Device &device)
     : shape_(shape), lower_(lower), upper_(upper), device_(device) {}
@@ -113,6 +151,7 @@ private:
 
 class RandomNormal : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   RandomNormal(const Shape &shape, float mean, float sd, Device &device)
     : shape_(shape), mean_(mean), sd_(sd), device_(device) {}
@@ -126,6 +165,7 @@ private:
 
 class RandomLogNormal : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
 public:
   RandomLogNormal(const Shape &shape, float mu, float beta, Device &device)
     : shape_(shape), mu_(mu), beta_(beta), device_(device) {}
@@ -266,22 +306,72 @@ private:
     PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1); \
   }
 
-PRIMITIV_DECL_UNARY(StopGradient);
+// Element-wise unary operator which supports the in-place forward.
+#define PRIMITIV_DECL_UNARY_INPLACE(name_, args_v, rets_v) \
+  class name_ : public Operator { \
+    PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1); \
+    PRIMITIV_DECL_USED_VALUES(args_v, rets_v); \
+    PRIMITIV_DECL_INPLACE_FORWARD; \
+    PRIMITIV_DECL_BATCHABLE(name_); \
+  }
+
+// Element-wise unary operator with a constant which supports the in-place
+// forward.
+#define PRIMITIV_DECL_UNARY_K_INPLACE(name_, type, args_v, rets_v) \
+  class name_ : public Operator { \
+    PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1); \
+    PRIMITIV_DECL_USED_VALUES(args_v, rets_v); \
+    PRIMITIV_DECL_INPLACE_FORWARD; \
+    PRIMITIV_DECL_BATCHABLE_K(name_); \
+  public: \
+    explicit name_(type k) : k_(k) {} \
+  private: \
+    type k_; \
+  }
+
+// Element-wise binary operator which supports the in-place forward.
+#define PRIMITIV_DECL_BINARY_INPLACE(name_, args_v, rets_v) \
+  class name_ : public Operator { \
+    PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1); \
+    PRIMITIV_DECL_USED_VALUES(args_v, rets_v); \
+    PRIMITIV_DECL_INPLACE_FORWARD; \
+    PRIMITIV_DECL_BATCHABLE(name_); \
+  }
+
+class Dropout : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
+public:
+  explicit Dropout(float rate) : rate_(rate) {}
+private:
+  float rate_;
+  // The mask is generated by the first forward operation, and is reused when
+  // the value is recalculated by the gradient checkpointing.
+  mutable Tensor mask_;
+};
+
+class StopGradient : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_USED_VALUES(false, false);
+public:
+  bool propagates_gradients() const override { return false; }
+};
+
 PRIMITIV_DECL_UNARY(Flatten);
 
 PRIMITIV_DECL_UNARY(Positive);
-PRIMITIV_DECL_UNARY(Negative);
-
-PRIMITIV_DECL_UNARY_K(AddConst, float);
-PRIMITIV_DECL_UNARY_K(SubtractConstR, float);
-PRIMITIV_DECL_UNARY_K(SubtractConstL, float);
-PRIMITIV_DECL_UNARY_K(MultiplyConst, float);
-PRIMITIV_DECL_UNARY_K(DivideConstR, float);
-PRIMITIV_DECL_UNARY_K(DivideConstL, float);
-PRIMITIV_DECL_UNARY_K(PowConstR, float);
-PRIMITIV_DECL_UNARY_K(PowConstL, float);
-PRIMITIV_DECL_UNARY_K(PReLU, float);
-PRIMITIV_DECL_UNARY_K(ELU, float);
+PRIMITIV_DECL_UNARY_INPLACE(Negative, false, false);
+
+PRIMITIV_DECL_UNARY_K_INPLACE(AddConst, float, false, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(SubtractConstR, float, false, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(SubtractConstL, float, false, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(MultiplyConst, float, false, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(DivideConstR, float, false, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(DivideConstL, float, true, true);
+PRIMITIV_DECL_UNARY_K_INPLACE(PowConstR, float, true, true);
+PRIMITIV_DECL_UNARY_K_INPLACE(PowConstL, float, false, true);
+PRIMITIV_DECL_UNARY_K_INPLACE(PReLU, float, true, false);
+PRIMITIV_DECL_UNARY_K_INPLACE(ELU, float, true, true);
 
 PRIMITIV_DECL_UNARY_K(PowN, std::int32_t);
 
@@ -294,26 +384,61 @@ PRIMITIV_DECL_BINARY(DivideScalarL);
 PRIMITIV_DECL_BINARY(PowScalarR);
 PRIMITIV_DECL_BINARY(PowScalarL);
 
-PRIMITIV_DECL_BINARY(Add);
-PRIMITIV_DECL_BINARY(Subtract);
-PRIMITIV_DECL_BINARY(Multiply);
-PRIMITIV_DECL_BINARY(Divide);
-PRIMITIV_DECL_BINARY(Pow);
+PRIMITIV_DECL_BINARY_INPLACE(Add, false, false);
+PRIMITIV_DECL_BINARY_INPLACE(Subtract, false, false);
+
+class Multiply : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1);
+  PRIMITIV_DECL_USED_VALUES(true, false);
+  PRIMITIV_DECL_INPLACE_FORWARD;
+  PRIMITIV_DECL_BATCHABLE(Multiply);
+public:
+  // The value of `a` is used only by the gradient of `b`.
+  bool uses_first_argument_value(
+      const std::vector<bool> &requires_grad) const override {
+    return requires_grad[1];
+  }
+};
+
+PRIMITIV_DECL_BINARY_INPLACE(Divide, true, true);
+PRIMITIV_DECL_BINARY_INPLACE(Pow, true, true);
 
 PRIMITIV_DECL_UNARY(Transpose);
-PRIMITIV_DECL_BINARY(MatrixMultiply);
-
-PRIMITIV_DECL_UNARY(Sqrt);
-PRIMITIV_DECL_UNARY(Exp);
-PRIMITIV_DECL_UNARY(Log);
-PRIMITIV_DECL_UNARY(Tanh);
-PRIMITIV_DECL_UNARY(Sigmoid);
-PRIMITIV_DECL_UNARY(Softplus);
-PRIMITIV_DECL_UNARY(Sin);
-PRIMITIV_DECL_UNARY(Cos);
-PRIMITIV_DECL_UNARY(Tan);
-PRIMITIV_DECL_UNARY(ReLU);
-PRIMITIV_DECL_UNARY(LReLU);
+class MatrixMultiply : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1);
+  PRIMITIV_DECL_USED_VALUES(true, false);
+  PRIMITIV_DECL_BATCHABLE(MatrixMultiply);
+};
+
+class TransposedMatrixMultiply : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1);
+  PRIMITIV_DECL_USED_VALUES(true, false);
+public:
+  TransposedMatrixMultiply(bool transpose_a, bool transpose_b)
+    : transpose_a_(transpose_a), transpose_b_(transpose_b) {}
+  bool is_batchable_with(const Operator &other) const override {
+    const TransposedMatrixMultiply *o =
+      dynamic_cast<const TransposedMatrixMultiply *>(&other);
+    return o &&
+      o->transpose_a_ == transpose_a_ &&
+      o->transpose_b_ == transpose_b_;
+  }
+private:
+  bool transpose_a_;
+  bool transpose_b_;
+};
+
+PRIMITIV_DECL_UNARY_INPLACE(Sqrt, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(Exp, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(Log, true, false);
+PRIMITIV_DECL_UNARY_INPLACE(Tanh, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(Sigmoid, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(Softplus, true, false);
+PRIMITIV_DECL_UNARY_INPLACE(Sin, true, false);
+PRIMITIV_DECL_UNARY_INPLACE(Cos, true, false);
+PRIMITIV_DECL_UNARY_INPLACE(Tan, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(ReLU, false, true);
+PRIMITIV_DECL_UNARY_INPLACE(LReLU, false, true);
 
 class BatchPick : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
@@ -379,6 +504,8 @@ private:
   std::uint32_t stride0_, stride1_;
 };
 
+#undef PRIMITIV_DECL_BATCHABLE
+#undef PRIMITIV_DECL_BATCHABLE_K
 #undef PRIMITIV_DECL_UNARY
 #undef PRIMITIV_DECL_UNARY_K
 #undef PRIMITIV_DECL_BINARY
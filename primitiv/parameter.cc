@@ -1,11 +1,14 @@
 #include <primitiv/config.h>
 
+#include <cstring>
 #include <fstream>
 #include <primitiv/device.h>
 #include <primitiv/error.h>
 #include <primitiv/file_format.h>
 #include <primitiv/functions.h>
 #include <primitiv/initializer.h>
+#include <primitiv/model.h>
+#include <primitiv/numeric_utils.h>
 #include <primitiv/parameter.h>
 
 using std::string;
@@ -24,17 +27,53 @@ primitiv::Shape read_shape(primitiv::msgpack::Reader &reader) {
 // Reads Tensor data.
 primitiv::Tensor read_tensor(
     primitiv::msgpack::Reader &reader, primitiv::Device &device) {
+  using primitiv::FileFormat;
   primitiv::Shape shape = ::read_shape(reader);
-  primitiv::msgpack::objects::Binary data;
+  const std::uint8_t type = reader.peek_type();
+
+  if (type >= 0xc4 && type <= 0xc6) {
+    // Single-precision values stored in a bin object.
+    primitiv::msgpack::objects::Binary data;
+    reader >> data;
+    if (data.size() != shape.size() * sizeof(float)) {
+      PRIMITIV_THROW_ERROR(
+          "Shape and data length mismatched. "
+          "shape.size() * sizeof(float): " << (shape.size() * sizeof(float))
+          << " != data.size(): " << data.size());
+    }
+    return device.new_tensor_by_array(
+        shape, reinterpret_cast<const float *>(data.data()));
+  }
+
+  // Reduced-precision values stored in an ext object.
+  primitiv::msgpack::objects::Extension data;
   reader >> data;
-  if (data.size() != shape.size() * sizeof(float)) {
+  if (data.size() != shape.size() * sizeof(std::uint16_t)) {
     PRIMITIV_THROW_ERROR(
         "Shape and data length mismatched. "
-        "shape.size() * sizeof(float): " << (shape.size() * sizeof(float))
+        "shape.size() * sizeof(std::uint16_t): "
+        << (shape.size() * sizeof(std::uint16_t))
         << " != data.size(): " << data.size());
   }
-  return device.new_tensor_by_array(
-      shape, reinterpret_cast<const float *>(data.data()));
+  std::vector<std::uint16_t> reduced(shape.size());
+  std::memcpy(reduced.data(), data.data(), data.size());
+  const std::uint16_t *src = reduced.data();
+  std::vector<float> raw_data(shape.size());
+  switch (static_cast<FileFormat::Precision>(data.type())) {
+    case FileFormat::Precision::FLOAT16:
+      primitiv::numeric_utils::float16_to_float(
+          raw_data.size(), src, raw_data.data());
+      break;
+    case FileFormat::Precision::BFLOAT16:
+      primitiv::numeric_utils::bfloat16_to_float(
+          raw_data.size(), src, raw_data.data());
+      break;
+    default:
+      PRIMITIV_THROW_ERROR(
+          "Unknown precision of the tensor data: "
+          << static_cast<int>(data.type()));
+  }
+  return device.new_tensor_by_array(shape, raw_data.data());
 }
 
 // Writes Shape data.
@@ -45,13 +84,40 @@ void write_shape(
 
 // Writes Tensor data.
 void write_tensor(
-    const primitiv::Tensor &src, primitiv::msgpack::Writer &writer) {
+    const primitiv::Tensor &src, primitiv::FileFormat::Precision precision,
+    primitiv::msgpack::Writer &writer) {
+  using primitiv::FileFormat;
   const primitiv::Shape &shape = src.shape();
   const std::vector<float> raw_data = src.to_vector();
-  primitiv::msgpack::objects::Binary data(
-      shape.size() * sizeof(float),
-      reinterpret_cast<const char *>(raw_data.data()));
   ::write_shape(shape, writer);
+
+  if (precision == FileFormat::Precision::FLOAT32) {
+    primitiv::msgpack::objects::Binary data(
+        shape.size() * sizeof(float),
+        reinterpret_cast<const char *>(raw_data.data()));
+    writer << data;
+    return;
+  }
+
+  std::vector<std::uint16_t> reduced(raw_data.size());
+  switch (precision) {
+    case FileFormat::Precision::FLOAT16:
+      primitiv::numeric_utils::float_to_float16(
+          raw_data.size(), raw_data.data(), reduced.data());
+      break;
+    case FileFormat::Precision::BFLOAT16:
+      primitiv::numeric_utils::float_to_bfloat16(
+          raw_data.size(), raw_data.data(), reduced.data());
+      break;
+    default:
+      PRIMITIV_THROW_ERROR(
+          "Unknown precision of the tensor data: "
+          << static_cast<int>(precision));
+  }
+  primitiv::msgpack::objects::Extension data(
+      static_cast<std::int8_t>(precision),
+      shape.size() * sizeof(std::uint16_t),
+      reinterpret_cast<const char *>(reduced.data()));
   writer << data;
 }
 
@@ -72,6 +138,9 @@ void assert_shape(
   }
 }
 
+// Innermost active LocalGradients object of each thread.
+thread_local primitiv::LocalGradients *current_local_gradients = nullptr;
+
 }  // namespace
 
 namespace primitiv {
@@ -157,8 +226,11 @@ void Parameter::load_inner(
   stats_ = std::move(stats);
 }
 
-void Parameter::save_inner(msgpack::Writer &writer, bool with_stats) const {
-  ::write_tensor(value_, writer);
+void Parameter::save_inner(
+    msgpack::Writer &writer, bool with_stats,
+    FileFormat::Precision precision,
+    FileFormat::Precision stats_precision) const {
+  ::write_tensor(value_, precision, writer);
 
   if (with_stats) {
 #ifdef PRIMITIV_WORDSIZE_64
@@ -172,7 +244,7 @@ void Parameter::save_inner(msgpack::Writer &writer, bool with_stats) const {
     writer << static_cast<std::uint32_t>(stats_.size());
     for (const auto &kv : stats_) {
       writer << kv.first;
-      ::write_tensor(kv.second, writer);
+      ::write_tensor(kv.second, stats_precision, writer);
     }
   } else {
     writer << std::uint32_t(0);
@@ -197,7 +269,10 @@ void Parameter::load(const string &path, bool with_stats, Device *device) {
   load_inner(reader, with_stats, Device::get_reference_or_default(device));
 }
 
-void Parameter::save(const string &path, bool with_stats) const  {
+void Parameter::save(
+    const string &path, bool with_stats,
+    FileFormat::Precision precision,
+    FileFormat::Precision stats_precision) const  {
   if (!valid()) PRIMITIV_THROW_ERROR("Attempted to save an invalid Parameter object.");
 
   std::ofstream ofs(path);
@@ -210,12 +285,23 @@ void Parameter::save(const string &path, bool with_stats) const  {
   writer << FileFormat::CurrentVersion::MINOR;
   writer << static_cast<std::uint32_t>(FileFormat::DataType::PARAMETER);
 
-  save_inner(writer, with_stats);
+  save_inner(writer, with_stats, precision, stats_precision);
 }
 
-void Parameter::reset_gradient() {
+const Tensor &Parameter::gradient() const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  const Tensor *local = LocalGradients::find(*this);
+  return local ? *local : grad_;
+}
+
+Tensor &Parameter::gradient() {
   if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-  grad_.reset(0);
+  Tensor *local = LocalGradients::find(*this);
+  return local ? *local : grad_;
+}
+
+void Parameter::reset_gradient() {
+  gradient().reset(0);
 }
 
 void Parameter::add_stats(const string &name, const Shape &shape) {
@@ -223,8 +309,71 @@ void Parameter::add_stats(const string &name, const Shape &shape) {
   if (has_stats(name)) {
     PRIMITIV_THROW_ERROR("Statistics with name `" << name << "` already exists.");
   }
-  stats_.emplace(
+  current_stats().emplace(
       std::make_pair(name, functions::zeros<Tensor>(shape, device_)));
 }
 
+bool Parameter::has_stats(const string &name) const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  const auto &stats = current_stats();
+  return stats.find(name) != stats.end();
+}
+
+const Tensor &Parameter::stats(const string &name) const {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  return current_stats().at(name);
+}
+
+Tensor &Parameter::stats(const string &name) {
+  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  return current_stats().at(name);
+}
+
+const std::unordered_map<string, Tensor> &Parameter::current_stats() const {
+  const auto *local = LocalGradients::find_stats(*this);
+  return local ? *local : stats_;
+}
+
+std::unordered_map<string, Tensor> &Parameter::current_stats() {
+  auto *local = LocalGradients::find_stats(*this);
+  return local ? *local : stats_;
+}
+
+LocalGradients::LocalGradients() : prev_(::current_local_gradients) {
+  ::current_local_gradients = this;
+}
+
+LocalGradients::~LocalGradients() {
+  ::current_local_gradients = prev_;
+}
+
+void LocalGradients::add(const Parameter &param) {
+  if (!param.valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  grads_[&param] = functions::zeros<Tensor>(param.shape(), param.device());
+  stats_[&param].clear();
+}
+
+void LocalGradients::add(const Model &model) {
+  for (const auto &kv : model.get_trainable_parameters()) {
+    add(*kv.second);
+  }
+}
+
+Tensor *LocalGradients::find(const Parameter &param) {
+  for (LocalGradients *lg = ::current_local_gradients; lg; lg = lg->prev_) {
+    const auto it = lg->grads_.find(&param);
+    if (it != lg->grads_.end()) return &it->second;
+  }
+  return nullptr;
+}
+
+std::unordered_map<string, Tensor> *LocalGradients::find_stats(
+    const Parameter &param) {
+  for (LocalGradients *lg = ::current_local_gradients; lg; lg = lg->prev_) {
+    const auto it = lg->stats_.find(&param);
+    if (it != lg->stats_.end()) return &it->second;
+  }
+  return nullptr;
+}
+
 }  // namespace primitiv
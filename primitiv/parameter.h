@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 #include <primitiv/error.h>
+#include <primitiv/file_format.h>
 #include <primitiv/mixins.h>
 #include <primitiv/msgpack/reader.h>
 #include <primitiv/msgpack/writer.h>
@@ -15,6 +16,7 @@ namespace primitiv {
 
 class Device;
 class Initializer;
+class Model;
 
 /**
  * Class to manage a trainable tensor parameter.
@@ -35,8 +37,14 @@ private:
    * Saves parameters to msgpack::Writer.
    * @param writer msgpack::Writer object.
    * @param with_stats Whether or not to save all additional statistics.
+   * @param precision Floating-point precision used to store the values.
+   * @param stats_precision Floating-point precision used to store the
+   *                        statistics.
    */
-  void save_inner(msgpack::Writer &writer, bool with_stats) const;
+  void save_inner(
+      msgpack::Writer &writer, bool with_stats,
+      FileFormat::Precision precision,
+      FileFormat::Precision stats_precision) const;
 
 public:
   /**
@@ -206,8 +214,41 @@ public:
    * @param path File path to save parameters.
    * @param with_stats Whether or not to save all additional statistics as well
    *                   as parameter values if the parameter object has them.
+   * @param precision Floating-point precision used to store the values.
+   * @param stats_precision Floating-point precision used to store the
+   *                        statistics.
+   * @remarks Reduced-precision data is converted back to single-precision
+   *          while loading.
    */
-  void save(const std::string &path, bool with_stats) const;
+  void save(
+      const std::string &path, bool with_stats,
+      FileFormat::Precision precision,
+      FileFormat::Precision stats_precision) const;
+
+  /**
+   * Saves current parameters into specified file.
+   * @param path File path to save parameters.
+   * @param with_stats Whether or not to save all additional statistics as well
+   *                   as parameter values if the parameter object has them.
+   * @param precision Floating-point precision used to store the values.
+   * @remarks Statistics are always stored in single-precision so that
+   *          optimizers can be resumed without any loss.
+   */
+  void save(
+      const std::string &path, bool with_stats,
+      FileFormat::Precision precision) const {
+    save(path, with_stats, precision, FileFormat::Precision::FLOAT32);
+  }
+
+  /**
+   * Saves current parameters into specified file.
+   * @param path File path to save parameters.
+   * @param with_stats Whether or not to save all additional statistics as well
+   *                   as parameter values if the parameter object has them.
+   */
+  void save(const std::string &path, bool with_stats) const {
+    save(path, with_stats, FileFormat::Precision::FLOAT32);
+  }
 
   /**
    * Saves current parameters into specified file.
@@ -233,6 +274,9 @@ public:
    * @param name Name of the statistics.
    * @param shape Shape of the tensor.
    * @remarks All elements in the new statistics tensor is initialized by 0.
+   *          If the parameter is registered to an active LocalGradients
+   *          object of the current thread, the statistics is added to the
+   *          thread-local statistics instead.
    */
   void add_stats(const std::string &name, const Shape &shape);
 
@@ -240,11 +284,11 @@ public:
    * Checks whether the statistics with name `name` exists or not.
    * @param name Name of the statistics.
    * @return true if the entry exists, false otherwise.
+   * @remarks If the parameter is registered to an active LocalGradients
+   *          object of the current thread, this function checks the
+   *          thread-local statistics instead.
    */
-  bool has_stats(const std::string &name) const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return stats_.find(name) != stats_.end();
-  }
+  bool has_stats(const std::string &name) const;
 
   /**
    * Returns the shape of the parameter.
@@ -285,41 +329,51 @@ public:
   /**
    * Returns the current gradient of the parameter.
    * @return A tensor representing the gradient of the value.
+   * @remarks If the parameter is registered to an active LocalGradients object
+   *          of the current thread, this function returns the thread-local
+   *          gradient instead.
    */
-  const Tensor &gradient() const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return grad_;
-  }
+  const Tensor &gradient() const;
 
   /**
    * Returns the current gradient of the parameter.
    * @return A tensor representing the gradient of the value.
+   * @remarks If the parameter is registered to an active LocalGradients object
+   *          of the current thread, this function returns the thread-local
+   *          gradient instead.
    */
-  Tensor &gradient() {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return grad_; }
+  Tensor &gradient();
 
   /**
    * Returns the current opotional statistics tensor specified by given name.
    * @param name Name of the statistics.
    * @return A tensor.
+   * @remarks If the parameter is registered to an active LocalGradients
+   *          object of the current thread, this function returns the
+   *          thread-local statistics instead.
    */
-  const Tensor &stats(const std::string &name) const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return stats_.at(name);
-  }
+  const Tensor &stats(const std::string &name) const;
 
   /**
    * Returns the current opotional statistics tensor specified by given name.
    * @param name Name of the statistics.
    * @return A tensor.
+   * @remarks If the parameter is registered to an active LocalGradients
+   *          object of the current thread, this function returns the
+   *          thread-local statistics instead.
    */
-  Tensor &stats(const std::string &name) {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return stats_.at(name);
-  }
+  Tensor &stats(const std::string &name);
 
 private:
+  /**
+   * Retrieves the statistics used in the current thread.
+   * @return Thread-local statistics if the parameter is registered to an
+   *         active LocalGradients object of the current thread, shared
+   *         statistics otherwise.
+   */
+  const std::unordered_map<std::string, Tensor> &current_stats() const;
+  std::unordered_map<std::string, Tensor> &current_stats();
+
   Shape shape_;
   Device *device_;
   Tensor value_;
@@ -327,6 +381,76 @@ private:
   std::unordered_map<std::string, Tensor> stats_;
 };
 
+/**
+ * Thread-local gradients and optimizer statistics of parameters.
+ * While this object is alive, Parameter::gradient() and Parameter::stats()
+ * called in the thread which created this object return the buffers held by
+ * this object for each registered parameter, instead of those shared by all
+ * threads.
+ * @remarks This class enables asynchronous (Hogwild-style) training: each
+ *          thread has its own Graph, Optimizer and LocalGradients, and updates
+ *          values of the shared Parameter objects without locking.
+ *          Optimizers add their statistics (e.g., moments of Adam) to the
+ *          thread-local buffers when `Optimizer::add()` is called while this
+ *          object is active. These statistics are discarded with this object
+ *          and are not saved by `Parameter::save()`.
+ *          Values of the parameters should not be shared with other tensors
+ *          (e.g., through `Tensor::reshape()` or `functions::parameter<Tensor>`)
+ *          while threads are updating them, and the registered parameters
+ *          should outlive this object.
+ */
+class LocalGradients : mixins::Nonmovable<LocalGradients> {
+public:
+  /**
+   * Creates a new LocalGradients object and activates it in the current
+   * thread.
+   */
+  LocalGradients();
+
+  /**
+   * Deactivates this object.
+   * @remarks The object should be destroyed in the thread which created it.
+   */
+  ~LocalGradients();
+
+  /**
+   * Registers a parameter and initializes its local gradient with 0.
+   * @param param Parameter object.
+   */
+  void add(const Parameter &param);
+
+  /**
+   * Registers all trainable parameters in a model.
+   * @param model Model object.
+   */
+  void add(const Model &model);
+
+  /**
+   * Retrieves the local gradient of a parameter in the current thread.
+   * @param param Parameter object.
+   * @return Pointer of the local gradient, or nullptr if `param` is not
+   *         registered to any active LocalGradients objects of the current
+   *         thread.
+   */
+  static Tensor *find(const Parameter &param);
+
+  /**
+   * Retrieves the local statistics of a parameter in the current thread.
+   * @param param Parameter object.
+   * @return Pointer of the local statistics, or nullptr if `param` is not
+   *         registered to any active LocalGradients objects of the current
+   *         thread.
+   */
+  static std::unordered_map<std::string, Tensor> *find_stats(
+      const Parameter &param);
+
+private:
+  LocalGradients *prev_;
+  std::unordered_map<const Parameter *, Tensor> grads_;
+  std::unordered_map<
+    const Parameter *, std::unordered_map<std::string, Tensor>> stats_;
+};
+
 }  // namespace primitiv
 
 #endif  // PRIMITIV_PARAMETER_H_
@@ -0,0 +1,240 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <primitiv/random.h>
+
+namespace {
+
+// Constants of Philox-4x32.
+constexpr std::uint32_t PHILOX_M0 = 0xd2511f53;
+constexpr std::uint32_t PHILOX_M1 = 0xcd9e8d57;
+constexpr std::uint32_t PHILOX_W0 = 0x9e3779b9;
+constexpr std::uint32_t PHILOX_W1 = 0xbb67ae85;
+constexpr std::uint32_t PHILOX_ROUNDS = 10;
+
+// Second word of the key. The first word is the seed.
+constexpr std::uint32_t KEY_SALT = 0x7072696d;  // "prim"
+
+// Minimum number of blocks (4 words) generated by one thread.
+constexpr std::uint64_t MIN_BLOCKS_PER_THREAD = 1 << 14;
+
+constexpr float TWO_PI = 6.283185307179586f;
+
+// Converts a random word into a float in [0, 1).
+inline float to_float_co(std::uint32_t x) {
+  return (x >> 8) * (1.f / (1 << 24));
+}
+
+// Converts a random word into a float in (0, 1].
+inline float to_float_oc(std::uint32_t x) {
+  return ((x >> 8) + 1) * (1.f / (1 << 24));
+}
+
+// Converts 4 random words into 4 values of the standard normal distribution
+// using the Box-Muller transform.
+inline void box_muller(const std::uint32_t w[4], float v[4]) {
+  for (std::uint32_t i = 0; i < 4; i += 2) {
+    const float r = std::sqrt(-2.f * std::log(to_float_oc(w[i])));
+    const float t = TWO_PI * to_float_co(w[i + 1]);
+    v[i] = r * std::cos(t);
+    v[i + 1] = r * std::sin(t);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+
+DefaultRandomizer::DefaultRandomizer()
+: DefaultRandomizer(std::random_device()()) {}
+
+DefaultRandomizer::DefaultRandomizer(std::uint32_t seed)
+: key_ { seed, ::KEY_SALT }
+, counter_(0)
+, num_threads_(std::max(1u, std::thread::hardware_concurrency())) {}
+
+void DefaultRandomizer::philox(
+    const std::uint32_t key[2], const std::uint32_t counter[4],
+    std::uint32_t result[4]) {
+  std::uint32_t k0 = key[0], k1 = key[1];
+  std::uint32_t c0 = counter[0], c1 = counter[1];
+  std::uint32_t c2 = counter[2], c3 = counter[3];
+  for (std::uint32_t r = 0; r < ::PHILOX_ROUNDS; ++r) {
+    const std::uint64_t p0 = static_cast<std::uint64_t>(::PHILOX_M0) * c0;
+    const std::uint64_t p1 = static_cast<std::uint64_t>(::PHILOX_M1) * c2;
+    const std::uint32_t hi0 = p0 >> 32, lo0 = static_cast<std::uint32_t>(p0);
+    const std::uint32_t hi1 = p1 >> 32, lo1 = static_cast<std::uint32_t>(p1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+    k0 += ::PHILOX_W0;
+    k1 += ::PHILOX_W1;
+  }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
+
+void DefaultRandomizer::generate(
+    std::uint64_t counter, std::uint32_t words[4]) const {
+  const std::uint32_t c[4] {
+    static_cast<std::uint32_t>(counter),
+    static_cast<std::uint32_t>(counter >> 32),
+    0, 0,
+  };
+  philox(key_, c, words);
+}
+
+std::vector<CommandQueue *> DefaultRandomizer::get_workers(
+    std::uint64_t num_workers) {
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  try {
+    while (workers_.size() < num_workers) {
+      workers_.emplace_back(new CommandQueue());
+    }
+  } catch (const std::system_error &) {
+    // Uses only existing workers if no more threads could be launched.
+  }
+  std::vector<CommandQueue *> workers;
+  const std::uint64_t n = std::min<std::uint64_t>(num_workers, workers_.size());
+  for (std::uint64_t i = 0; i < n; ++i) workers.emplace_back(workers_[i].get());
+  return workers;
+}
+
+template<typename Function>
+void DefaultRandomizer::parallel_for(
+    std::uint64_t num_units, std::uint64_t min_units, Function fn) {
+  const std::uint64_t num_threads = std::min<std::uint64_t>(
+      num_threads_, std::max<std::uint64_t>(1, num_units / min_units));
+  const std::vector<CommandQueue *> workers = num_threads > 1
+    ? get_workers(num_threads - 1)
+    : std::vector<CommandQueue *>();
+  if (workers.empty()) {
+    fn(0, num_units);
+    return;
+  }
+
+  // The calling thread processes the first chunk, and workers process others.
+  const std::uint64_t num_chunks = workers.size() + 1;
+  const std::uint64_t chunk = (num_units + num_chunks - 1) / num_chunks;
+  std::uint64_t begin = chunk;
+  for (CommandQueue *worker : workers) {
+    if (begin >= num_units) break;
+    const std::uint64_t end = std::min(begin + chunk, num_units);
+    worker->push([&fn, begin, end] { fn(begin, end); });
+    begin = end;
+  }
+  fn(0, std::min(chunk, num_units));
+  for (CommandQueue *worker : workers) worker->wait();
+}
+
+template<typename Transform>
+void DefaultRandomizer::fill(
+    std::size_t size, float *data, Transform transform) {
+  const std::uint64_t num_blocks = (size + 3) / 4;
+  if (num_blocks == 0) return;
+
+  // Each call reserves its own range of counters, and the `b`-th block of the
+  // array always uses the counter `base + b`. Resulting values do not depend
+  // on how the blocks are assigned to threads.
+  const std::uint64_t base = counter_.fetch_add(num_blocks);
+
+  parallel_for(
+      num_blocks, ::MIN_BLOCKS_PER_THREAD,
+      [&](std::uint64_t begin, std::uint64_t end) {
+    std::uint32_t words[4];
+    float values[4];
+    for (std::uint64_t b = begin; b < end; ++b) {
+      generate(base + b, words);
+      transform(words, values);
+      const std::size_t offset = b * 4;
+      const std::size_t n = std::min<std::size_t>(4, size - offset);
+      for (std::size_t i = 0; i < n; ++i) {
+        data[offset + i] = values[i];
+      }
+    }
+  });
+}
+
+void DefaultRandomizer::fill_bernoulli(
+    float p, std::size_t size, float *data) {
+  fill(size, data, [p](const std::uint32_t w[4], float v[4]) {
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      v[i] = ::to_float_co(w[i]) < p;
+    }
+  });
+}
+
+void DefaultRandomizer::fill_bernoulli_bits(
+    float p, std::size_t size, std::uint32_t *data) {
+  const std::uint64_t num_blocks = (size + 3) / 4;
+  if (num_blocks == 0) return;
+
+  // Counters are assigned in the same manner as `fill()`, and each word of the
+  // array is generated from 8 consecutive blocks.
+  const std::uint64_t base = counter_.fetch_add(num_blocks);
+  const std::uint64_t num_words = (size + 31) / 32;
+
+  parallel_for(
+      num_words, ::MIN_BLOCKS_PER_THREAD / 8,
+      [&](std::uint64_t begin, std::uint64_t end) {
+    std::uint32_t words[4];
+    for (std::uint64_t w = begin; w < end; ++w) {
+      const std::uint64_t b_end = std::min(w * 8 + 8, num_blocks);
+      std::uint32_t bits = 0;
+      for (std::uint64_t b = w * 8; b < b_end; ++b) {
+        generate(base + b, words);
+        const std::uint32_t shift = (b % 8) * 4;
+        for (std::uint32_t i = 0; i < 4; ++i) {
+          bits |= static_cast<std::uint32_t>(::to_float_co(words[i]) < p)
+            << (shift + i);
+        }
+      }
+      // Clears bits after the end of the array.
+      const std::size_t rest = size - w * 32;
+      if (rest < 32) bits &= (1u << rest) - 1;
+      data[w] = bits;
+    }
+  });
+}
+
+void DefaultRandomizer::fill_uniform(
+    float lower, float upper, std::size_t size, float *data) {
+  const float scale = upper - lower;
+  const float lower_eps = std::nextafter(lower, upper);
+  fill(size, data, [=](const std::uint32_t w[4], float v[4]) {
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      const float x = lower + scale * ::to_float_oc(w[i]);
+      v[i] = x < lower_eps || x > upper ? upper : x;
+    }
+  });
+}
+
+void DefaultRandomizer::fill_normal(
+    float mean, float sd, std::size_t size, float *data) {
+  fill(size, data, [=](const std::uint32_t w[4], float v[4]) {
+    ::box_muller(w, v);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      v[i] = mean + sd * v[i];
+    }
+  });
+}
+
+void DefaultRandomizer::fill_log_normal(
+    float mean, float sd, std::size_t size, float *data) {
+  fill(size, data, [=](const std::uint32_t w[4], float v[4]) {
+    ::box_muller(w, v);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      v[i] = std::exp(mean + sd * v[i]);
+    }
+  });
+}
+
+}  // namespace primitiv
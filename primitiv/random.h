@@ -1,30 +1,58 @@
 #ifndef PRIMITIV_RANDOM_H_
 #define PRIMITIV_RANDOM_H_
 
-#include <cmath>
+#include <atomic>
 #include <cstddef>
-#include <random>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <primitiv/command_queue.h>
 #include <primitiv/mixins.h>
 
 namespace primitiv {
 
 /**
  * Default randomizer for any devices.
+ * @remarks This randomizer uses the counter-based generator Philox-4x32-10:
+ *          each call of `fill_*()` reserves a range of counters, and the
+ *          `i`-th element of the array is calculated only from the seed and
+ *          the counter of the element. Large arrays are filled by multiple
+ *          threads, and results are always identical regardless of the number
+ *          of threads.
+ *          Worker threads are launched at the first call which requires them,
+ *          and are reused by subsequent calls until the randomizer is
+ *          destroyed.
+ *          All member functions could be called from multiple threads.
  */
 class DefaultRandomizer : mixins::Nonmovable<DefaultRandomizer> {
-  std::mt19937 rng_;
-
 public:
   /**
    * Creates a randomizer object using environment seeds.
    */
-  DefaultRandomizer() : rng_(std::random_device()()) {}
+  DefaultRandomizer();
 
   /**
    * Creates a randomizer object using a user seed.
    * @param seed Seed value of the randomizer.
    */
-  explicit DefaultRandomizer(std::uint32_t seed) : rng_(seed) {}
+  explicit DefaultRandomizer(std::uint32_t seed);
+
+  /**
+   * Retrieves the maximum number of threads used in `fill_*()`.
+   * @return Maximum number of threads.
+   */
+  std::uint32_t get_num_threads() const { return num_threads_; }
+
+  /**
+   * Specifies the maximum number of threads used in `fill_*()`.
+   * @param num_threads Maximum number of threads. 0 is treated as 1.
+   * @remarks Default value is the number of hardware threads. This value does
+   *          not affect resulting sequences.
+   */
+  void set_num_threads(std::uint32_t num_threads) {
+    num_threads_ = num_threads > 0 ? num_threads : 1;
+  }
 
   /**
    * Fill an array using a Bernoulli distribution.
@@ -32,12 +60,20 @@ public:
    * @param size Length of the array `data`.
    * @param data Pointer of the array in which results are stored.
    */
-  void fill_bernoulli(float p, std::size_t size, float *data) {
-    std::bernoulli_distribution dist(p);
-    for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
-    }
-  }
+  void fill_bernoulli(float p, std::size_t size, float *data);
+
+  /**
+   * Fill an array of bits using a Bernoulli distribution.
+   * @param p Probability with witch each bit becomes 1.
+   * @param size Number of bits.
+   * @param data Pointer of the array of `(size + 31) / 32` words in which
+   *             results are stored. The `i`-th bit is stored in the
+   *             `(i % 32)`-th lowest bit of `data[i / 32]`, and remaining bits
+   *             of the last word become 0.
+   * @remarks Each bit has the same value as the corresponding element of
+   *          `fill_bernoulli()` called with the same state.
+   */
+  void fill_bernoulli_bits(float p, std::size_t size, std::uint32_t *data);
 
   /**
    * Fill an array using a uniform distribution.
@@ -47,14 +83,7 @@ public:
    * @param data Pointer of the array in which results are stored.
    * @remarks Range of the resulting sequence is (lower, upper].
    */
-  void fill_uniform(float lower, float upper, std::size_t size, float *data) {
-    std::uniform_real_distribution<float> dist(lower, upper);
-    const float lower_eps = std::nextafter(lower, upper);
-    for (std::size_t i = 0; i < size; ++i) {
-      const float x = dist(rng_);
-      data[i] = x < lower_eps ? upper : x;
-    }
-  }
+  void fill_uniform(float lower, float upper, std::size_t size, float *data);
 
   /**
    * Fill an array using a normal distribution.
@@ -63,12 +92,7 @@ public:
    * @param size Length of the array `data`.
    * @param data Pointer of the array in which results are stored.
    */
-  void fill_normal(float mean, float sd, std::size_t size, float *data) {
-    std::normal_distribution<float> dist(mean, sd);
-    for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
-    }
-  }
+  void fill_normal(float mean, float sd, std::size_t size, float *data);
 
   /**
    * Fill an array using a log-normal distribution.
@@ -77,12 +101,60 @@ public:
    * @param size Length of the array `data`.
    * @param data Pointer of the array in which results are stored.
    */
-  void fill_log_normal(float mean, float sd, std::size_t size, float *data) {
-    std::lognormal_distribution<float> dist(mean, sd);
-    for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
-    }
-  }
+  void fill_log_normal(float mean, float sd, std::size_t size, float *data);
+
+  /**
+   * Calculates the Philox-4x32-10 function.
+   * @param key Key of the function, i.e., the seed of the sequence.
+   * @param counter Counter of the function.
+   * @param result Array of 4 words in which results are stored.
+   */
+  static void philox(
+      const std::uint32_t key[2], const std::uint32_t counter[4],
+      std::uint32_t result[4]);
+
+private:
+  /**
+   * Generates 4 random words.
+   * @param counter Counter of the block.
+   * @param words Array of 4 words in which results are stored.
+   */
+  void generate(std::uint64_t counter, std::uint32_t words[4]) const;
+
+  /**
+   * Calls a function for disjoint ranges which cover all units, using worker
+   * threads if possible.
+   * @param num_units Number of units.
+   * @param min_units Minimum number of units processed by one thread.
+   * @param fn Function called as `fn(begin, end)` for each range.
+   */
+  template<typename Function>
+  void parallel_for(
+      std::uint64_t num_units, std::uint64_t min_units, Function fn);
+
+  /**
+   * Obtains worker threads, launching new ones if necessary.
+   * @param num_workers Number of required workers.
+   * @return Worker queues. The number of them may be less than `num_workers`
+   *         if no more threads could be launched.
+   */
+  std::vector<CommandQueue *> get_workers(std::uint64_t num_workers);
+
+  /**
+   * Fills an array using random words.
+   * @param size Length of the array `data`.
+   * @param data Pointer of the array in which results are stored.
+   * @param transform Function to convert 4 random words into 4 values, which
+   *                  is called as `transform(words, values)`.
+   */
+  template<typename Transform>
+  void fill(std::size_t size, float *data, Transform transform);
+
+  const std::uint32_t key_[2];
+  std::atomic<std::uint64_t> counter_;
+  std::atomic<std::uint32_t> num_threads_;
+  std::mutex workers_mutex_;
+  std::vector<std::unique_ptr<CommandQueue>> workers_;
 };
 
 }  // namespace primitiv
@@ -31,12 +31,22 @@ Shape scalar_op(const Shape &x, const Shape &k) {
 }
 
 Shape elementwise(const Shape &a, const Shape &b) {
-  if (!a.has_same_dims(b) || !a.has_compatible_batch(b)) {
+  if (!a.has_compatible_batch(b)) {
     PRIMITIV_THROW_ERROR(
         "Shape mismatched for the elementwise operation. "
         "a: " << a.to_string() << " != b: " << b.to_string());
   }
-  return a.resize_batch(std::max(a.batch(), b.batch()));
+  const std::uint32_t depth = std::max(a.depth(), b.depth());
+  std::vector<std::uint32_t> dims(depth);
+  for (std::uint32_t i = 0; i < depth; ++i) {
+    if (a[i] != b[i] && a[i] != 1 && b[i] != 1) {
+      PRIMITIV_THROW_ERROR(
+          "Shape mismatched for the elementwise operation. "
+          "a: " << a.to_string() << " != b: " << b.to_string());
+    }
+    dims[i] = std::max(a[i], b[i]);
+  }
+  return Shape(dims, std::max(a.batch(), b.batch()));
 }
 
 Shape slice(
@@ -131,6 +141,13 @@ Shape matmul(const Shape &l, const Shape &r) {
   return Shape({l[0], r[1]}, std::max(l.batch(), r.batch()));
 }
 
+Shape matmul(
+    const Shape &l, const Shape &r, bool transpose_l, bool transpose_r) {
+  return matmul(
+      transpose_l ? transpose(l) : l,
+      transpose_r ? transpose(r) : r);
+}
+
 Shape conv2d(
     const Shape &x, const Shape &w,
     std::uint32_t padding0, std::uint32_t padding1,
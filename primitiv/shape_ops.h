@@ -37,6 +37,9 @@ Shape scalar_op(const Shape &x, const Shape &k);
  * @param a A shape.
  * @param b Other shape.
  * @return Calculated shape, that is equivalent to `(a + b).shape()`.
+ * @remarks Each dimension of `a` and `b` should be the same, or either of them
+ *          should be 1. In the latter case, the operand with 1 is broadcasted
+ *          to the other one, similarly to the minibatch.
  */
 Shape elementwise(const Shape &a, const Shape &b);
 
@@ -98,6 +101,16 @@ Shape transpose(const Shape &x);
  */
 Shape matmul(const Shape &l, const Shape &r);
 
+/** Calculates a shape of matrix products with transposed operands.
+ * @param l Shape of the left hand side.
+ * @param r Shape of the right hand side.
+ * @param transpose_l Whether `l` is used as transposed or not.
+ * @param transpose_r Whether `r` is used as transposed or not.
+ * @return Calculated shape.
+ */
+Shape matmul(
+    const Shape &l, const Shape &r, bool transpose_l, bool transpose_r);
+
 /**
  * Calculates a resulting shape of convolution.
  * @param x Shape of the input tensor.
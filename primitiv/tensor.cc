@@ -12,7 +12,9 @@ float Tensor::to_float() const {
     PRIMITIV_THROW_ERROR(
         "Tensor has more than 1 values. shape = " << shape_.to_string());
   }
-  return device_->tensor_to_vector(*this)[0];
+  float ret;
+  device_->tensor_to_array(*this, &ret);
+  return ret;
 }
 
 std::vector<float> Tensor::to_vector() const {
@@ -20,21 +22,46 @@ std::vector<float> Tensor::to_vector() const {
   return device_->tensor_to_vector(*this);
 }
 
+void Tensor::to_array(float *values) const {
+  check_valid();
+  device_->tensor_to_array(*this, values);
+}
+
+const float *Tensor::host_data() const {
+  check_valid();
+  return device_->tensor_host_data(*this);
+}
+
 std::vector<std::uint32_t> Tensor::argmax(std::uint32_t dim) const {
   check_valid();
   return device_->argmax(*this, dim);
 }
 
+void Tensor::argmax(std::uint32_t dim, std::uint32_t *ids) const {
+  check_valid();
+  device_->argmax(*this, dim, ids);
+}
+
 std::vector<std::uint32_t> Tensor::argmin(std::uint32_t dim) const {
   check_valid();
   return device_->argmin(*this, dim);
 }
 
+void Tensor::argmin(std::uint32_t dim, std::uint32_t *ids) const {
+  check_valid();
+  device_->argmin(*this, dim, ids);
+}
+
+bool Tensor::is_unique() const {
+  return valid() && Device::is_unique(*this);
+}
+
 void *Tensor::mutable_handle() {
   check_valid();
-  // If the internal memory is shared with other objects, the memory will be
-  // duplicated to maintain the safety of other objects.
-  if (handle_.use_count() > 1) {
+  // If the internal memory is shared with other objects or borrowed from an
+  // external array, the memory will be duplicated to maintain the safety of
+  // other objects.
+  if (handle_.use_count() > 1 || Device::is_borrowed(*this)) {
     *this = device_->copy_tensor(*this);
   }
   return handle_.get();
@@ -62,6 +62,16 @@ public:
     }
   }
 
+  /**
+   * Check whether the internal memory is owned only by this object.
+   * @return true if the object is valid and the internal memory is neither
+   *         shared with other objects nor borrowed from an external array,
+   *         false otherwise.
+   * @remarks In-place operations reuse the internal memory only if this
+   *          returns true, and allocate new memory otherwise.
+   */
+  bool is_unique() const;
+
   /**
    * Returns the shape of the Tensor.
    * @return Shape of the Tensor.
@@ -96,6 +106,27 @@ public:
    */
   std::vector<float> to_vector() const;
 
+  /**
+   * Copies internal values in the tensor into an array.
+   * @param values Pointer to array of `shape().size()` elements in which the
+   *               internal values are stored.
+   * @remarks Each resulting values are ordered by the column-major order, and
+   *          the batch size is assumed as the last dimension of the tensor.
+   */
+  void to_array(float *values) const;
+
+  /**
+   * Retrieves the pointer to internal values on the host memory without
+   * copying.
+   * @return Const-pointer to the array of `shape().size()` internal values,
+   *         which are ordered in the same manner as `to_vector()`.
+   * @throw primitiv::Error The device does not store values in the host memory
+   *                        (e.g., CUDA and OpenCL).
+   * @remarks The pointer is available until this object is destroyed or
+   *          updated by any operations.
+   */
+  const float *host_data() const;
+
   /**
    * Retrieves argmax indices along an axis.
    * @param dim A specified axis.
@@ -103,6 +134,14 @@ public:
    */
   std::vector<std::uint32_t> argmax(std::uint32_t dim) const;
 
+  /**
+   * Retrieves argmax indices along an axis into an array.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `shape().size() / shape()[dim]` elements in
+   *            which the positions of the maximum values are stored.
+   */
+  void argmax(std::uint32_t dim, std::uint32_t *ids) const;
+
   /**
    * Retrieves argmin indices along an axis.
    * @param dim A specified axis.
@@ -110,6 +149,14 @@ public:
    */
   std::vector<std::uint32_t> argmin(std::uint32_t dim) const;
 
+  /**
+   * Retrieves argmin indices along an axis into an array.
+   * @param dim A specified axis.
+   * @param ids Pointer to array of `shape().size() / shape()[dim]` elements in
+   *            which the positions of the minimum values are stored.
+   */
+  void argmin(std::uint32_t dim, std::uint32_t *ids) const;
+
   /**
    * Invalidates this object.
    */
@@ -132,13 +132,23 @@ Tensor input_tensor(
   return ::get_device(dev).new_tensor_by_vector(shape, data);
 }
 
+Tensor input_tensor(
+    const Shape &shape, std::vector<float> &&data, Device *dev) {
+  return ::get_device(dev).new_tensor_by_vector(shape, std::move(data));
+}
+
+Tensor borrowed_input_tensor(
+    const Shape &shape, const float *data, Device *dev) {
+  return ::get_device(dev).new_tensor_by_borrowed_array(shape, data);
+}
+
 Tensor parameter_tensor(Parameter &param) {
   return param.value();
 }
 
 template<>
 Tensor copy(const Tensor &x, Device *dev) {
-  return ::get_device(dev).copy_tensor(x);
+  return ::get_device(dev).share_tensor(x);
 }
 
 template<>
@@ -267,6 +277,13 @@ Tensor elu(const Tensor &x, float a) {
   return x.device().elu_fw(x, a);
 }
 
+template<>
+Tensor dropout(const Tensor &x, float rate, bool enabled) {
+  if (!enabled) return x;
+  Tensor mask;
+  return x.device().dropout_fw(x, rate, mask);
+}
+
 template<>
 Tensor max(const Tensor &x, std::uint32_t dim) {
   return x.device().max_fw(x, dim);
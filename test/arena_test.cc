@@ -0,0 +1,56 @@
+#include <primitiv/config.h>
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <primitiv/arena.h>
+
+namespace primitiv {
+
+class ArenaTest : public testing::Test {};
+
+TEST_F(ArenaTest, CheckAllocation) {
+  Arena arena(64);
+  EXPECT_EQ(0u, arena.capacity());
+
+  char *p1 = static_cast<char *>(arena.allocate(16, 1));
+  char *p2 = static_cast<char *>(arena.allocate(16, 1));
+  EXPECT_EQ(64u, arena.capacity());
+  EXPECT_EQ(p1 + 16, p2);
+}
+
+TEST_F(ArenaTest, CheckAlignment) {
+  Arena arena(256);
+  arena.allocate(1, 1);
+  for (const std::size_t align : {2u, 4u, 8u, 16u, 32u}) {
+    const void *p = arena.allocate(1, align);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p) % align);
+  }
+  const double *a = arena.allocate_array<double>(4);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(a) % alignof(double));
+}
+
+TEST_F(ArenaTest, CheckNewBlocks) {
+  Arena arena(64);
+  arena.allocate(48, 1);
+  arena.allocate(48, 1);
+  EXPECT_EQ(128u, arena.capacity());
+
+  // Larger requests have their own blocks.
+  arena.allocate(1000, 1);
+  EXPECT_EQ(1128u, arena.capacity());
+}
+
+TEST_F(ArenaTest, CheckReset) {
+  Arena arena(64);
+  void *p1 = arena.allocate(48, 1);
+  void *p2 = arena.allocate(48, 1);
+  EXPECT_EQ(128u, arena.capacity());
+
+  // Blocks are reused after reset.
+  arena.reset();
+  EXPECT_EQ(p1, arena.allocate(48, 1));
+  EXPECT_EQ(p2, arena.allocate(48, 1));
+  EXPECT_EQ(128u, arena.capacity());
+}
+
+}  // namespace primitiv
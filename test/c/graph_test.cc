@@ -299,6 +299,45 @@ TEST_F(CGraphTest, CheckForward) {
   ::primitivDeleteGraph(g);
 }
 
+TEST_F(CGraphTest, CheckTensorArrays) {
+  ::primitivResetStatus();
+  const std::uint32_t dims[] = {2, 3};
+  ::primitivShape_t *shape;
+  ::primitivCreateShapeWithDims(dims, 2, 1, &shape);
+  float data[] = {1, 6, 2, 5, 4, 3};
+  ::primitivTensor_t *x;
+  ::primitivApplyTensorInput(shape, data, 6, dev, &x);
+
+  std::size_t size;
+  float values[6];
+  ::primitivEvaluateTensorAsArray(x, nullptr, &size);
+  EXPECT_EQ(6u, size);
+  size = 5;
+  EXPECT_EQ(
+      PRIMITIV_C_ERROR, ::primitivEvaluateTensorAsArray(x, values, &size));
+  ::primitivResetStatus();
+  size = 6;
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivEvaluateTensorAsArray(x, values, &size));
+  EXPECT_TRUE(array_match(data, values, 6));
+
+  const float *host_data;
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivGetTensorHostData(x, &host_data));
+  EXPECT_TRUE(array_match(data, const_cast<float *>(host_data), 6));
+
+  std::uint32_t ids[3];
+  ::primitivGetTensorArgmax(x, 0, nullptr, &size);
+  EXPECT_EQ(3u, size);
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivGetTensorArgmax(x, 0, ids, &size));
+  std::uint32_t expected_max[] = {1, 1, 0};
+  EXPECT_TRUE(array_match(expected_max, ids, 3));
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivGetTensorArgmin(x, 0, ids, &size));
+  std::uint32_t expected_min[] = {0, 0, 1};
+  EXPECT_TRUE(array_match(expected_min, ids, 3));
+
+  ::primitivDeleteTensor(x);
+  ::primitivDeleteShape(shape);
+}
+
 TEST_F(CGraphTest, CheckMultipleReturnValues) {
   ::primitivResetStatus();
   ::primitivSetDefaultDevice(dev);
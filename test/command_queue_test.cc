@@ -0,0 +1,66 @@
+#include <primitiv/config.h>
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include <primitiv/command_queue.h>
+
+namespace primitiv {
+
+class CommandQueueTest : public testing::Test {};
+
+TEST_F(CommandQueueTest, CheckOrder) {
+  std::vector<int> results;
+  CommandQueue queue;
+  for (int i = 0; i < 100; ++i) {
+    queue.push([&results, i] { results.emplace_back(i); });
+  }
+  queue.wait();
+  ASSERT_EQ(100u, results.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, results[i]);
+  }
+}
+
+TEST_F(CommandQueueTest, CheckWorkerThread) {
+  CommandQueue queue;
+  EXPECT_FALSE(queue.is_worker_thread());
+  bool in_worker = false;
+  queue.push([&] {
+    in_worker = queue.is_worker_thread();
+    // Does nothing on the worker thread.
+    queue.wait();
+  });
+  queue.wait();
+  EXPECT_TRUE(in_worker);
+}
+
+TEST_F(CommandQueueTest, CheckError) {
+  int count = 0;
+  CommandQueue queue;
+  queue.push([&] { ++count; });
+  queue.push([] { throw std::runtime_error("1st"); });
+  queue.push([] { throw std::runtime_error("2nd"); });
+  queue.push([&] { ++count; });
+  try {
+    queue.wait();
+    FAIL() << "No exceptions thrown.";
+  } catch (const std::runtime_error &e) {
+    EXPECT_STREQ("1st", e.what());
+  }
+  EXPECT_EQ(2, count);
+
+  // The error is reported only once.
+  EXPECT_NO_THROW(queue.wait());
+}
+
+TEST_F(CommandQueueTest, CheckDestruction) {
+  int count = 0;
+  {
+    CommandQueue queue;
+    for (int i = 0; i < 10; ++i) queue.push([&] { ++count; });
+  }
+  EXPECT_EQ(10, count);
+}
+
+}  // namespace primitiv
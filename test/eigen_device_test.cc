@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include <primitiv/eigen_device.h>
 #include <primitiv/error.h>
+#include <primitiv/functions.h>
+#include <primitiv/naive_device.h>
 #include <primitiv/shape.h>
 #include <primitiv/tensor.h>
 #include <test_utils.h>
@@ -80,10 +82,10 @@ TEST_F(EigenDeviceTest, CheckRandomBernoulli) {
 
 TEST_F(EigenDeviceTest, CheckRandomBernoulliWithSeed) {
   const vector<float> expected {
-    0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0,
-    0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0,
+    1, 0, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+    0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
   };
   devices::Eigen dev(12345);
   const Tensor x = dev.random_bernoulli(Shape({4, 4}, 4), 0.3);
@@ -117,8 +119,8 @@ TEST_F(EigenDeviceTest, CheckRandomUniform) {
 
 TEST_F(EigenDeviceTest, CheckRandomUniformWithSeed) {
   const vector<float> expected {
-    7.7330894e+00, 7.0227852e+00, -3.3052402e+00, -6.6472688e+00,
-    -5.6894612e+00, -8.2843294e+00, -5.3179150e+00, 5.8758497e+00,
+    -3.6453762e+00, -2.8291702e-02, -6.0376234e+00, -6.5357161e+00,
+    -1.6798029e+00, 3.4201746e+00, -4.4367599e-01, -2.2292976e+00,
   };
   devices::Eigen dev(12345);
   const Tensor x = dev.random_uniform(Shape({2, 2}, 2), -9, 9);
@@ -151,20 +153,10 @@ TEST_F(EigenDeviceTest, CheckRandomNormal) {
 #endif  // PRIMITIV_BUILD_TESTS_PROBABILISTIC
 
 TEST_F(EigenDeviceTest, CheckRandomNormalWithSeed) {
-#ifdef __GLIBCXX__
   const vector<float> expected {
-    -1.3574908e+00, -1.7222166e-01, 2.5865970e+00, -4.3594337e-01,
-    4.5383353e+00, 8.4703674e+00, 2.5535507e+00, 1.3252910e+00,
+    -3.6713247e+00, 1.0461352e+00, 4.7174034e+00, 5.3196931e+00,
+    -4.8122644e-01, -2.7418165e+00, -1.6057708e+00, 3.5683806e+00,
   };
-#elif defined _LIBCPP_VERSION
-  const vector<float> expected {
-    -1.7222166e-01, -1.3574908e+00, -4.3594337e-01, 2.5865970e+00,
-    8.4703674e+00, 4.5383353e+00, 1.3252910e+00, 2.5535507e+00,
-  };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
   devices::Eigen dev(12345);
   const Tensor x = dev.random_normal(Shape({2, 2}, 2), 1, 3);
 #ifdef PRIMITIV_MAYBE_FPMATH_X87
@@ -200,20 +192,10 @@ TEST_F(EigenDeviceTest, CheckRandomLogNormal) {
 #endif  // PRIMITIV_BUILD_TESTS_PROBABILISTIC
 
 TEST_F(EigenDeviceTest, CheckRandomLogNormalWithSeed) {
-#ifdef __GLIBCXX__
   const vector<float> expected {
-    2.5730559e-01, 8.4179258e-01, 1.3284487e+01, 6.4665437e-01,
-    9.3534966e+01, 4.7712681e+03, 1.2852659e+01, 3.7632804e+00,
+    2.5442744e-02, 2.8466282e+00, 1.1187737e+02, 2.0432117e+02,
+    6.1802495e-01, 6.4453162e-02, 2.0073476e-01, 3.5459126e+01,
   };
-#elif defined _LIBCPP_VERSION
-  const vector<float> expected {
-    8.4179258e-01, 2.5730559e-01, 6.4665437e-01, 1.3284487e+01,
-    4.7712681e+03, 9.3534966e+01, 3.7632804e+00, 1.2852659e+01,
-  };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
   devices::Eigen dev(12345);
   const Tensor x = dev.random_log_normal(Shape({2, 2}, 2), 1, 3);
 #ifdef PRIMITIV_MAYBE_FPMATH_X87
@@ -223,4 +205,18 @@ TEST_F(EigenDeviceTest, CheckRandomLogNormalWithSeed) {
 #endif
 }
 
+TEST_F(EigenDeviceTest, CheckShareWithNaive) {
+  devices::Eigen dev;
+  Tensor y;
+  {
+    // The shared memory is available after the source device is destroyed.
+    devices::Naive dev1;
+    const Tensor x = dev1.new_tensor_by_vector({3}, {1, 2, 3});
+    y = functions::copy(x, dev);
+  }
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, y.to_vector()));
+  y *= 2;
+  EXPECT_TRUE(vector_match(vector<float> {2, 4, 6}, y.to_vector()));
+}
+
 }  // namespace primitiv
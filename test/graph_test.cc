@@ -1,6 +1,9 @@
 #include <primitiv/config.h>
 
+#include <numeric>
 #include <sstream>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/error.h>
@@ -160,6 +163,30 @@ TEST_F(GraphTest, CheckClear) {
   EXPECT_EQ(0u, g.num_operators());
 }
 
+TEST_F(GraphTest, CheckEmplaceOperator) {
+  Device::set_default(dev);
+
+  Graph g;
+  Graph::set_default(g);
+
+  // Operators and nodes in the graph are rebuilt on the same memory after
+  // clear().
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    g.clear();
+    const Node a = g.emplace_operator<operators::Input>(
+        {}, Shape({2}), vector<float> {1, 2}, dev);
+    const Node b = functions::input<Node>({2}, {3, 5});
+    const Node y = g.emplace_operator<operators::Add>({a, b});
+    EXPECT_EQ(3u, g.num_operators());
+    EXPECT_EQ("Add", g.get_operator(y).name());
+    EXPECT_TRUE(vector_match(vector<float> {4, 7}, y.to_vector()));
+    EXPECT_THROW(
+        g.emplace_operator<operators::Add>({a}),
+        Error);
+    EXPECT_EQ(3u, g.num_operators());
+  }
+}
+
 TEST_F(GraphTest, CheckForwardBackward) {
   Device::set_default(dev);
 
@@ -356,6 +383,626 @@ TEST_F(GraphTest, CheckMultipleReturnValues) {
   EXPECT_THROW(functions::split(x, 0, 2), Error);
 }
 
+TEST_F(GraphTest, CheckBackwardCallback) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  Parameter pa({}, {2});
+  Parameter pb({}, {3});
+  Parameter pc({}, {5});
+  pa.reset_gradient();
+  pb.reset_gradient();
+  pc.reset_gradient();
+
+  const Node a1 = functions::parameter<Node>(pa);
+  const Node b = functions::parameter<Node>(pb);
+  const Node c = functions::parameter<Node>(pc);  // Out of the forward path.
+  const Node a2 = functions::parameter<Node>(pa);
+  const Node y = a1 * b + a2;
+  static_cast<void>(c);
+
+  vector<const Parameter *> params;
+  vector<float> grads;
+  g.backward(y, [&](Parameter &p) {
+      params.emplace_back(&p);
+      grads.emplace_back(p.gradient().to_float());
+  });
+
+  const vector<const Parameter *> expected_params {&pc, &pb, &pa};
+  EXPECT_EQ(expected_params, params);
+  EXPECT_TRUE(vector_match(vector<float> {0, 2, 4}, grads));
+  EXPECT_FLOAT_EQ(4, pa.gradient().to_float());
+  EXPECT_FLOAT_EQ(2, pb.gradient().to_float());
+  EXPECT_FLOAT_EQ(0, pc.gradient().to_float());
+}
+
+TEST_F(GraphTest, CheckBackwardWithGradient) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  Parameter pw({2}, {2, 3});
+  pw.reset_gradient();
+
+  const Node x = functions::input<Node>(Shape({2}, 2), {1, 2, 3, 4});
+  const Node w = functions::parameter<Node>(pw);
+  const Node y = w * x;
+
+  // dy/dw is weighted by the given gradient.
+  const Tensor gy = functions::input<Tensor>(
+      Shape({2}, 2), {1, 10, 100, 1000});
+  g.backward(y, gy);
+  EXPECT_TRUE(vector_match(
+        vector<float> {1 * 1 + 3 * 100, 2 * 10 + 4 * 1000},
+        pw.gradient().to_vector()));
+}
+
+TEST_F(GraphTest, CheckInvalidBackwardWithGradient) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  const Node x = functions::input<Node>(Shape({2}, 2), {1, 2, 3, 4});
+  const Node y = 2 * x;
+  EXPECT_THROW(
+      g.backward(y, functions::ones<Tensor>(Shape({2}))), Error);
+  EXPECT_THROW(
+      g.backward(y, functions::ones<Tensor>(Shape({3}, 2))), Error);
+  EXPECT_THROW(
+      g.backward(y, functions::ones<Tensor>(Shape({2}, 2), dev2)), Error);
+  EXPECT_NO_THROW(g.backward(y, functions::ones<Tensor>(Shape({2}, 2))));
+}
+
+TEST_F(GraphTest, CheckRetainGradient) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  const Node x = functions::input<Node>(Shape({2}, 2), {1, 2, 3, 4});
+  const Node h = x * x;
+  const Node y = 3 * h;
+
+  // Gradients are not available before calling retain_gradient().
+  g.backward(y);
+  EXPECT_THROW(g.get_gradient(x), Error);
+  EXPECT_THROW(g.get_gradient(h), Error);
+
+  g.retain_gradient(x);
+  g.retain_gradient(h);
+  g.backward(y);
+  EXPECT_TRUE(vector_match(
+        vector<float> {6, 12, 18, 24}, g.get_gradient(x).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 3, 3, 3}, g.get_gradient(h).to_vector()));
+
+  // Retained gradients are not accumulated over multiple backpropagations.
+  g.backward(y, functions::input<Tensor>(Shape({2}, 2), {1, 0, 0, 2}));
+  EXPECT_TRUE(vector_match(
+        vector<float> {6, 0, 0, 48}, g.get_gradient(x).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 0, 0, 6}, g.get_gradient(h).to_vector()));
+}
+
+TEST_F(GraphTest, CheckGradientOverwriting) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  const Node x = functions::input<Node>(Shape({2}, 2), {1, 2, 3, 4});
+  const Node h1 = 2 * x;  // Overwrites the gradient of `x` at last.
+  const Node h2 = h1 + x;  // Shares `gy` with `h1` and `x`.
+  const Node h3 = h2 - h1;
+  const Node s = functions::stop_gradient(h3);
+  const Node y = functions::sum(3 * h2 + h3 + s, 0);
+
+  g.retain_gradient(x);
+  g.retain_gradient(h1);
+  g.retain_gradient(h2);
+  g.retain_gradient(h3);
+  g.retain_gradient(y);
+  g.backward(y, functions::input<Tensor>(Shape({}, 2), {1, 2}));
+
+  // The gradient given by the user should not be modified.
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 2}, g.get_gradient(y).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 1, 2, 2}, g.get_gradient(h3).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {4, 4, 8, 8}, g.get_gradient(h2).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 3, 6, 6}, g.get_gradient(h1).to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {10, 10, 20, 20}, g.get_gradient(x).to_vector()));
+}
+
+TEST_F(GraphTest, CheckRequiresGradient) {
+  Device::set_default(dev);
+
+  const vector<float> x_data {1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12};
+  const vector<float> w_data {1, 2, 3, 4};
+  Parameter pw({2, 2}, w_data);
+
+  auto calc = [&](bool retain, vector<float> &gw_val) {
+    Graph g;
+    Graph::set_default(g);
+    pw.reset_gradient();
+
+    const Node x = functions::input<Node>(Shape({2, 2}, 3), x_data);
+    const Node w = functions::parameter<Node>(pw);
+    const Node xx = x * x + 1;  // Not required unless `x` is retained.
+    const Node h1 = functions::matmul(w, xx);
+    const Node h2 = functions::matmul(functions::transpose(w), xx);
+    const Node h3 = functions::matmul(functions::transpose(xx), w);
+    const Node h4 = functions::matmul(xx, functions::transpose(w));
+    const Node h5 = functions::stop_gradient(w * 2) * x;
+    const Node y = functions::batch::sum(
+        functions::sum(functions::sum(h1 + h2 + h3 + h4 + h5, 0), 1));
+    if (retain) g.retain_gradient(x);
+
+    g.backward(y);
+    gw_val = pw.gradient().to_vector();
+
+    if (retain) {
+      EXPECT_NO_THROW(g.get_gradient(x));
+    } else {
+      EXPECT_THROW(g.get_gradient(x), Error);
+    }
+  };
+
+  vector<float> gw_expected, gw_observed;
+  calc(true, gw_expected);
+  calc(false, gw_observed);
+  EXPECT_TRUE(vector_match(gw_expected, gw_observed));
+}
+
+TEST_F(GraphTest, CheckBufferDonation) {
+  Device::set_default(dev);
+
+  const vector<float> x_data {1, -2, 3, -4};
+  const vector<float> w_data {2, 1};
+  const vector<float> c_data {3, -1};
+  Parameter pw({2}, w_data);
+
+  auto calc = [&](bool donation, vector<float> &y_val, vector<float> &gw_val) {
+    Graph g;
+    Graph::set_default(g);
+    EXPECT_FALSE(g.get_buffer_donation());
+    g.set_buffer_donation(donation);
+    EXPECT_EQ(donation, g.get_buffer_donation());
+    pw.reset_gradient();
+
+    const Node x = functions::input<Node>(Shape({2}, 2), x_data);
+    const Node w = functions::parameter<Node>(pw);
+    const Node h1 = x * w;  // Multiply requires `x` and `w`.
+    const Node h2 = h1 + 1;  // Overwrites `h1`.
+    const Node h3 = functions::relu(h2);  // Overwrites `h2`.
+    const Node h4 = functions::tanh(h3);  // `h3` is required by ReLU.
+    const Node h5 = h4 + h4;  // `h4` is used twice.
+    const Node c = functions::input<Node>({2}, c_data);
+    const Node h6 = w + 1;
+    const Node h7 = h6 * c;  // Overwrites `h6` because `c` needs no gradient.
+    const Node h8 = w - 1;
+    const Node h9 = h8 * w;  // `h8` is required by the gradient of `w`.
+    const Node y = functions::batch::sum(functions::sum(h5 + h7 + h9, 0));
+
+    y_val = g.forward(y).to_vector();
+    g.backward(y);
+    gw_val = pw.gradient().to_vector();
+
+    if (donation) {
+      EXPECT_THROW(g.forward(h1), Error);
+      EXPECT_THROW(g.forward(h2), Error);
+      EXPECT_THROW(g.forward(h6), Error);
+    } else {
+      EXPECT_NO_THROW(g.forward(h1));
+      EXPECT_NO_THROW(g.forward(h2));
+      EXPECT_NO_THROW(g.forward(h6));
+    }
+    EXPECT_NO_THROW(g.forward(x));
+    EXPECT_NO_THROW(g.forward(h3));
+    EXPECT_NO_THROW(g.forward(h4));
+    EXPECT_NO_THROW(g.forward(h8));
+  };
+
+  vector<float> y_expected, gw_expected, y_observed, gw_observed;
+  calc(false, y_expected, gw_expected);
+  calc(true, y_observed, gw_observed);
+  EXPECT_TRUE(vector_match(y_expected, y_observed));
+  EXPECT_TRUE(vector_match(gw_expected, gw_observed));
+
+  // Values shared with their operators (e.g., inputs) are never donated.
+  {
+    Graph g;
+    Graph::set_default(g);
+    g.set_buffer_donation(true);
+    const Node x = functions::input<Node>({2}, c_data);
+    const Node y = x * 2;
+    EXPECT_TRUE(vector_match(vector<float> {6, -2}, y.to_vector()));
+    EXPECT_NO_THROW(g.forward(x));
+    EXPECT_TRUE(vector_match(c_data, x.to_vector()));
+  }
+
+  // The donated value is required by gradients requested after the donation.
+  Graph g;
+  Graph::set_default(g);
+  g.set_buffer_donation(true);
+  const Node a = functions::input<Node>({2}, c_data) + 1;
+  const Node b = functions::input<Node>({2}, c_data);
+  const Node y = functions::sum(a * b, 0);
+  EXPECT_TRUE(vector_match(vector<float> {12}, y.to_vector()));
+  g.retain_gradient(b);
+  EXPECT_THROW(g.backward(y), Error);
+}
+
+TEST_F(GraphTest, CheckInferenceMode) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  EXPECT_FALSE(g.get_inference_mode());
+  g.set_inference_mode(true);
+  EXPECT_TRUE(g.get_inference_mode());
+
+  Parameter pw({2, 2}, {1, 0, 0, 1});
+  const Node w = functions::parameter<Node>(pw);
+  const Node x = functions::input<Node>({2}, {1, 2});
+
+  // Decoding loop: each step refers only the previous state.
+  vector<Node> hs {x};
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    hs.emplace_back(functions::matmul(w, hs.back()) + 1);
+    EXPECT_NO_THROW(g.forward(hs.back()));
+  }
+  EXPECT_TRUE(vector_match(vector<float> {5, 6}, hs.back().to_vector()));
+
+  // Values of all intermediate nodes are already released.
+  for (std::uint32_t i = 0; i + 1 < hs.size(); ++i) {
+    EXPECT_THROW(g.forward(hs[i]), Error);
+  }
+  EXPECT_NO_THROW(g.forward(w));
+
+  // A node used twice is released at the next forward() after both users
+  // are calculated.
+  const Node h = hs.back() * 2;
+  const Node y1 = h + 1;
+  const Node y2 = h - 1;
+  EXPECT_TRUE(vector_match(vector<float> {11, 13}, y1.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {10, 12}, h.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {9, 11}, y2.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {10, 12}, h.to_vector()));
+  EXPECT_NO_THROW(g.forward(y1));
+  EXPECT_THROW(g.forward(h), Error);
+
+  EXPECT_THROW(g.backward(y1), Error);
+}
+
+TEST_F(GraphTest, CheckInferenceModeWithOutputs) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  g.set_inference_mode(true);
+
+  Parameter pw({2, 2}, {1, 0, 0, 1});
+  const Node w = functions::parameter<Node>(pw);
+  const Node x = functions::input<Node>({2}, {1, 2});
+
+  // Decoding loop: each step calculates an output from the current state,
+  // and the next step refers the state after the output is calculated.
+  vector<Node> hs {x};
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    hs.emplace_back(functions::matmul(w, hs.back()) + 1);
+    const Node y = hs.back() * 2;
+    const float h0 = i + 2;
+    EXPECT_TRUE(vector_match(
+          vector<float> {2 * h0, 2 * h0 + 2}, y.to_vector()));
+  }
+
+  // The last state is kept until the next forward().
+  EXPECT_TRUE(vector_match(vector<float> {5, 6}, hs.back().to_vector()));
+  const Node z = hs.back() + 1;
+  EXPECT_TRUE(vector_match(vector<float> {6, 7}, z.to_vector()));
+
+  // Older states are already released.
+  for (std::uint32_t i = 0; i + 1 < hs.size(); ++i) {
+    EXPECT_THROW(g.forward(hs[i]), Error);
+  }
+}
+
+namespace {
+
+// Tanh which counts the number of its calculations.
+class CountingTanh : public operators::Tanh {
+public:
+  explicit CountingTanh(std::uint32_t &count) : count_(count) {}
+  void forward(
+      const vector<const Tensor *> &args,
+      const vector<Tensor *> &rets) const override {
+    ++count_;
+    operators::Tanh::forward(args, rets);
+  }
+  void forward_inplace(
+      const vector<const Tensor *> &args, Tensor &ret) const override {
+    ++count_;
+    operators::Tanh::forward_inplace(args, ret);
+  }
+private:
+  std::uint32_t &count_;
+};
+
+}  // namespace
+
+TEST_F(GraphTest, CheckCheckpointing) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  EXPECT_FALSE(g.get_checkpointing());
+  EXPECT_EQ(0u, g.get_checkpoint_budget());
+
+  Parameter pw({2, 2}, {1, -1, 2, 1});
+  Parameter pb({2}, {.5, -.5});
+
+  // Builds a deep tanh network with the given settings. Each value has 16
+  // bytes, and the 4th tanh is a checkpoint.
+  std::uint32_t num_tanh = 0;
+  vector<Node> hs;
+  auto build = [&](bool checkpointing, std::size_t budget) {
+    g.clear();
+    g.set_checkpointing(checkpointing);
+    g.set_checkpoint_budget(budget);
+    num_tanh = 0;
+    hs.clear();
+    const Node w = functions::parameter<Node>(pw);
+    const Node b = functions::parameter<Node>(pb);
+    Node h = functions::input<Node>(Shape({2}, 2), {1, 2, -1, .5});
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      h = g.emplace_operator<CountingTanh>(
+          {functions::matmul(w, h) + b}, num_tanh);
+      hs.emplace_back(h);
+      if (i == 3) g.checkpoint(h);
+    }
+    return functions::batch::sum(functions::sum(h * h, 0));
+  };
+
+  // Calculates gradients of the network with the given settings.
+  std::uint32_t num_tanh_forward = 0;
+  auto calculate = [&](bool checkpointing, std::size_t budget) {
+    pw.reset_gradient();
+    pb.reset_gradient();
+    const Node y = build(checkpointing, budget);
+    const vector<float> y_val = y.to_vector();
+    num_tanh_forward = num_tanh;
+    g.backward(y);
+    return std::make_tuple(
+        y_val, pw.gradient().to_vector(), pb.gradient().to_vector());
+  };
+
+  const auto expected = calculate(false, 0);
+  EXPECT_EQ(8u, num_tanh_forward);
+  EXPECT_EQ(8u, num_tanh);
+
+  struct TestCase {
+    std::size_t budget;
+    // Total number of tanh calculations including recalculations.
+    std::uint32_t num_tanh;
+    // Whether the value of each tanh is discarded by forward() or not.
+    vector<bool> discarded;
+  };
+  const vector<TestCase> test_cases {
+    // All values except the checkpoint are discarded without the budget.
+    {0, 15, {true, true, true, false, true, true, true, true}},
+    // Every value exceeds the budget and becomes a checkpoint.
+    {8, 8, {false, false, false, false, false, false, false, false}},
+    // Every third value becomes a checkpoint.
+    {32, 12, {false, false, false, false, true, true, true, true}},
+    // All values fit in the budget.
+    {1024, 15, {true, true, true, false, true, true, true, true}},
+  };
+  for (const TestCase &tc : test_cases) {
+    const auto observed = calculate(true, tc.budget);
+    EXPECT_TRUE(g.get_checkpointing());
+    EXPECT_EQ(tc.budget, g.get_checkpoint_budget());
+    EXPECT_TRUE(vector_match(std::get<0>(expected), std::get<0>(observed)));
+    EXPECT_TRUE(vector_match(std::get<1>(expected), std::get<1>(observed)));
+    EXPECT_TRUE(vector_match(std::get<2>(expected), std::get<2>(observed)));
+
+    // Discarded values are recalculated only once in backward().
+    EXPECT_EQ(8u, num_tanh_forward);
+    EXPECT_EQ(tc.num_tanh, num_tanh);
+
+    // Each discarded value is recalculated from the previous one, which is
+    // kept as the requested node of the previous forward().
+    const Node y = build(true, tc.budget);
+    y.to_vector();
+    for (std::uint32_t i = 0; i < hs.size(); ++i) {
+      const std::uint32_t prev = num_tanh;
+      g.forward(hs[i]);
+      EXPECT_EQ(tc.discarded[i] ? 1u : 0u, num_tanh - prev) << "i=" << i;
+    }
+  }
+  g.set_checkpointing(false);
+  g.set_checkpoint_budget(0);
+}
+
+TEST_F(GraphTest, CheckAutobatching) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  EXPECT_FALSE(g.get_autobatching());
+
+  Parameter pw({2, 2}, {1, -1, 2, 1});
+  Parameter pb({2}, {.5, -.5});
+
+  // Calculates gradients of independent RNNs with the given setting.
+  std::uint32_t num_tanh = 0;
+  auto calculate = [&](bool autobatching) {
+    num_tanh = 0;
+    g.clear();
+    g.set_autobatching(autobatching);
+    pw.reset_gradient();
+    pb.reset_gradient();
+    const Node w = functions::parameter<Node>(pw);
+    const Node b = functions::parameter<Node>(pb);
+    const vector<Node> xs {
+      functions::input<Node>({2}, {1, 2}),
+      functions::input<Node>(Shape({2}, 2), {-1, .5, 0, 1}),
+      functions::input<Node>({2}, {.5, .5}),
+      functions::input<Node>({3}, {1, 2, 3}),
+    };
+    vector<Node> losses;
+    for (std::uint32_t i = 0; i < 3; ++i) {
+      Node h = xs[i];
+      for (std::uint32_t j = 0; j <= i; ++j) {
+        h = g.emplace_operator<CountingTanh>(
+            {functions::matmul(w, h) + b}, num_tanh);
+      }
+      losses.emplace_back(functions::batch::sum(functions::sum(h * h, 0)));
+    }
+    losses.emplace_back(functions::sum(xs[3] * xs[3], 0));
+    const Node y = functions::sum(losses);
+    const vector<float> y_val = y.to_vector();
+    g.backward(y);
+    return std::make_tuple(
+        y_val, pw.gradient().to_vector(), pb.gradient().to_vector());
+  };
+
+  // Tanh is calculated for each step of each RNN without the autobatching,
+  // and once for each step with the autobatching.
+  const auto expected = calculate(false);
+  EXPECT_EQ(6u, num_tanh);
+  const auto observed = calculate(true);
+  EXPECT_EQ(3u, num_tanh);
+  EXPECT_TRUE(g.get_autobatching());
+  EXPECT_TRUE(vector_match(std::get<0>(expected), std::get<0>(observed)));
+  EXPECT_TRUE(vector_match(std::get<1>(expected), std::get<1>(observed)));
+  EXPECT_TRUE(vector_match(std::get<2>(expected), std::get<2>(observed)));
+
+  // Operators added after the previous forward() are also batched.
+  num_tanh = 0;
+  const Node x1 = functions::input<Node>({2}, {0, 0});
+  const Node x2 = functions::input<Node>({2}, {0, 0});
+  const Node y1 = g.emplace_operator<CountingTanh>({x1}, num_tanh);
+  const Node y2 = g.emplace_operator<CountingTanh>({x2}, num_tanh);
+  EXPECT_TRUE(vector_match(vector<float> {0, 0}, (y1 + y2).to_vector()));
+  EXPECT_EQ(1u, num_tanh);
+  g.set_autobatching(false);
+}
+
+TEST_F(GraphTest, CheckSimplification) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  EXPECT_FALSE(g.get_simplification());
+
+  Parameter pw({2, 2}, {1, 2, 3, 4});
+  Parameter pv({2, 2}, {1, 2, 3, 4});
+
+  // Without the simplification, all operators are added as is.
+  {
+    const Node w1 = functions::parameter<Node>(pw);
+    const Node w2 = functions::parameter<Node>(pw);
+    EXPECT_NE(w1.operator_id(), w2.operator_id());
+    const Node x = w1 + 0;
+    EXPECT_NE(w1.operator_id(), x.operator_id());
+    EXPECT_EQ(3u, g.num_operators());
+  }
+
+  g.clear();
+  g.set_simplification(true);
+  EXPECT_TRUE(g.get_simplification());
+
+  // Common subexpressions.
+  const Node w1 = functions::parameter<Node>(pw);
+  const Node w2 = functions::parameter<Node>(pw);
+  const Node v = functions::parameter<Node>(pv);
+  EXPECT_EQ(w1.operator_id(), w2.operator_id());
+  EXPECT_NE(w1.operator_id(), v.operator_id());
+  EXPECT_EQ(2u, g.num_operators());
+
+  const Node a1 = functions::tanh(w1 + v);
+  const Node a2 = functions::tanh(w2 + v);
+  EXPECT_EQ(a1.operator_id(), a2.operator_id());
+  EXPECT_NE(a1.operator_id(), functions::tanh(v + w1).operator_id());
+  EXPECT_EQ(
+      (w1 * 2).operator_id(), (w1 * 2).operator_id());
+  EXPECT_NE(
+      (w1 * 2).operator_id(), (w1 * 3).operator_id());
+
+  const Node z1 = functions::zeros<Node>({2});
+  const Node z2 = functions::zeros<Node>({2});
+  const Node z3 = functions::zeros<Node>({3});
+  EXPECT_EQ(z1.operator_id(), z2.operator_id());
+  EXPECT_NE(z1.operator_id(), z3.operator_id());
+
+  // Inputs and random values are never merged.
+  EXPECT_NE(
+      functions::input<Node>({2}, {1, 2}).operator_id(),
+      functions::input<Node>({2}, {1, 2}).operator_id());
+  EXPECT_NE(
+      functions::random::normal<Node>({2}, 0, 1).operator_id(),
+      functions::random::normal<Node>({2}, 0, 1).operator_id());
+
+  // Trivial operations.
+  EXPECT_EQ(w1.operator_id(), (w1 + 0).operator_id());
+  EXPECT_EQ(w1.operator_id(), (0 + w1).operator_id());
+  EXPECT_EQ(w1.operator_id(), (w1 - 0).operator_id());
+  EXPECT_EQ(w1.operator_id(), (w1 * 1).operator_id());
+  EXPECT_EQ(w1.operator_id(), (1 * w1).operator_id());
+  EXPECT_EQ(w1.operator_id(), (w1 / 1).operator_id());
+  EXPECT_EQ(w1.operator_id(), functions::pown(w1, 1).operator_id());
+  EXPECT_EQ(
+      w1.operator_id(),
+      functions::transpose(functions::transpose(w1)).operator_id());
+  EXPECT_EQ(
+      w1.operator_id(),
+      functions::reshape(functions::flatten(w1), {2, 2}).operator_id());
+  const Node r = functions::reshape(functions::reshape(w1, {2, 2, 1}), {4});
+  EXPECT_EQ("Reshape([4]x1)", g.get_operator(r).name());
+  EXPECT_EQ(w1.operator_id(), g.get_arguments(r)[0].operator_id());
+
+  // Results and gradients are not changed.
+  pw.reset_gradient();
+  pv.reset_gradient();
+  const Node y =
+    functions::sum(functions::flatten(a1 + a2 * 1) + r, 0);
+  EXPECT_NO_THROW(g.backward(y));
+  const Tensor wt = functions::parameter<Tensor>(pw);
+  const Tensor vt = functions::parameter<Tensor>(pv);
+  const Tensor gt = 1 - functions::tanh(wt + vt) * functions::tanh(wt + vt);
+  const vector<float> ga = (2 * gt).to_vector();
+  const vector<float> gw = (2 * gt + 1).to_vector();
+  EXPECT_TRUE(vector_match(gw, pw.gradient().to_vector()));
+  EXPECT_TRUE(vector_match(ga, pv.gradient().to_vector()));
+}
+
+TEST_F(GraphTest, CheckLazyTranspose) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  Parameter pa({3, 2}, {1, 2, 3, 4, 5, 6});
+  Parameter pb({3, 2}, {1, 0, -1, 2, 0, -2});
+  pa.reset_gradient();
+  pb.reset_gradient();
+
+  const Node a = functions::parameter<Node>(pa);
+  const Node b = functions::parameter<Node>(pb);
+  const Node at = functions::transpose(a);
+  const Node y = functions::matmul(at, b);
+  EXPECT_EQ("TransposedMatrixMultiply(1,0)", g.get_operator(y).name());
+  EXPECT_EQ(Shape({2, 2}), y.shape());
+  EXPECT_TRUE(vector_match(vector<float> {-2, -2, -4, -4}, y.to_vector()));
+
+  g.backward(y);
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 0, -3, 3, 0, -3}, pa.gradient().to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {5, 7, 9, 5, 7, 9}, pb.gradient().to_vector()));
+
+  // The transposed node is still available.
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 4, 2, 5, 3, 6}, at.to_vector()));
+}
+
 TEST_F(GraphTest, CheckXor) {
   Device::set_default(dev);
 
@@ -431,6 +1078,46 @@ TEST_F(GraphTest, CheckXor) {
   // TODO(odashi): add gradient checking.
 }
 
+TEST_F(GraphTest, CheckConcurrentInference) {
+  // Multiple threads share the same device and parameters, and each thread
+  // has its own default graph.
+  Parameter w1({2, 2}, {1, -1, 1, -1}, dev);
+  Parameter b1({2}, {-1, -1}, dev);
+  Parameter w2({1, 2}, {1, 1}, dev);
+  Parameter b2({}, {1}, dev);
+
+  const vector<float> inputs {1, 1, 1, -1, -1, 1, -1, -1};
+  const float h5 = .76653940;  // 1 + tanh(1) - tanh(3)
+  const float h6 = -.52318831;  // 1 - 2 * tanh(1)
+  const vector<float> expected {h5, h6, h6, h5};
+
+  const std::uint32_t NUM_THREADS = 4;
+  vector<vector<float>> results(NUM_THREADS);
+  vector<std::thread> threads;
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      Device::set_default(dev);
+      Graph g;
+      Graph::set_default(g);
+      for (std::uint32_t i = 0; i < 10; ++i) {
+        g.clear();
+        const Node x = functions::input<Node>(Shape({2}, 4), inputs);
+        const Node h = functions::tanh(
+            functions::matmul(functions::parameter<Node>(w1), x)
+            + functions::parameter<Node>(b1));
+        const Node y = functions::matmul(functions::parameter<Node>(w2), h)
+          + functions::parameter<Node>(b2);
+        results[t] = y.to_vector();
+      }
+    });
+  }
+  for (std::thread &th : threads) th.join();
+
+  for (const vector<float> &result : results) {
+    EXPECT_TRUE(vector_match(expected, result));
+  }
+}
+
 TEST_F(GraphTest, CheckLSTM) {
   Device::set_default(dev);
 
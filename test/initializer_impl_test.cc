@@ -283,5 +283,31 @@ TEST_F(InitializerImplTest, CheckInvalidXavierNormalConv2D) {
   }
 }
 
+TEST_F(InitializerImplTest, CheckInplaceRandom) {
+  const Uniform uniform(-1, 1);
+  const Normal normal(0, 1);
+  const XavierUniform xavier_uniform;
+  const XavierNormal xavier_normal;
+  const XavierUniformConv2D xavier_uniform_conv2d;
+  const XavierNormalConv2D xavier_normal_conv2d;
+  const vector<const Initializer *> inits {
+    &uniform, &normal,
+    &xavier_uniform, &xavier_normal,
+    &xavier_uniform_conv2d, &xavier_normal_conv2d,
+  };
+  for (const Initializer *init : inits) {
+    Tensor x = dev.new_tensor_by_constant({16, 16}, 0);
+    init->apply(x);
+    EXPECT_EQ(Shape({16, 16}), x.shape());
+
+    // Values of other tensors sharing the memory are not overwritten.
+    const Tensor y = x;
+    const vector<float> y_val = y.to_vector();
+    init->apply(x);
+    EXPECT_EQ(y_val, y.to_vector());
+    EXPECT_NE(y_val, x.to_vector());
+  }
+}
+
 }  // namespace initializers
 }  // namespace primitiv
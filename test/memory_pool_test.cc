@@ -0,0 +1,140 @@
+#include <primitiv/config.h>
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <primitiv/error.h>
+#include <primitiv/memory_pool.h>
+
+namespace primitiv {
+
+class MemoryPoolTest : public testing::Test {
+protected:
+  static void *allocator(std::size_t size) {
+    void *ptr = std::malloc(size);
+    if (!ptr) PRIMITIV_THROW_ERROR("Failed to allocate memory.");
+    return ptr;
+  }
+
+  static void deleter(void *ptr) {
+    std::free(ptr);
+  }
+};
+
+TEST_F(MemoryPoolTest, CheckEmptyAllocation) {
+  MemoryPool pool(allocator, deleter);
+  const auto sp1 = pool.allocate(0u);
+  const auto sp2 = pool.allocate(0u);
+  EXPECT_EQ(nullptr, sp1.get());
+  EXPECT_EQ(nullptr, sp2.get());
+}
+
+TEST_F(MemoryPoolTest, CheckAllocate) {
+  MemoryPool pool(allocator, deleter);
+  void *p1, *p2;
+  {
+    const auto sp1 = pool.allocate(1llu);
+    const auto sp2 = pool.allocate(1llu << 8);
+    p1 = sp1.get();
+    p2 = sp2.get();
+  }
+  {
+    // Released pointers are reused.
+    const auto sp1 = pool.allocate(1llu);
+    const auto sp2 = pool.allocate(1llu << 8);
+    EXPECT_EQ(p1, sp1.get());
+    EXPECT_EQ(p2, sp2.get());
+    // Allocates other pointers.
+    const auto sp11 = pool.allocate(1llu);
+    const auto sp22 = pool.allocate(1llu << 8);
+    EXPECT_NE(p1, sp11.get());
+    EXPECT_NE(p2, sp22.get());
+  }
+}
+
+TEST_F(MemoryPoolTest, CheckInvalidAllocate) {
+  MemoryPool pool(allocator, deleter);
+  EXPECT_THROW(pool.allocate((1llu << 63) + 1), Error);
+}
+
+TEST_F(MemoryPoolTest, CheckPoolOutlivedByHandles) {
+  std::shared_ptr<void> sp1, sp2;
+  {
+    MemoryPool pool(allocator, deleter);
+    sp1 = pool.allocate(1llu << 4);
+    sp2 = sp1;
+  }  // pool is destroyed at the end of scope.
+  // Releasing handles after the pool has gone does nothing.
+  EXPECT_NO_THROW(sp1.reset());
+  EXPECT_NO_THROW(sp2.reset());
+}
+
+TEST_F(MemoryPoolTest, CheckMultiplePools) {
+  MemoryPool pool1(allocator, deleter);
+  void *p;
+  {
+    MemoryPool pool2(allocator, deleter);
+    const auto sp1 = pool1.allocate(1llu << 4);
+    const auto sp2 = pool2.allocate(1llu << 4);
+    p = sp1.get();
+  }
+  // Each handle is returned to its own pool.
+  const auto sp = pool1.allocate(1llu << 4);
+  EXPECT_EQ(p, sp.get());
+}
+
+TEST_F(MemoryPoolTest, CheckConcurrentAllocate) {
+  MemoryPool pool(allocator, deleter);
+  const std::size_t NUM_THREADS = 4;
+  const std::size_t NUM_ITERATIONS = 1000;
+  const std::size_t NUM_LIVE = 32;
+  std::vector<std::vector<std::shared_ptr<void>>> handles(NUM_THREADS);
+  std::vector<int> ok(NUM_THREADS, 1);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<std::shared_ptr<void>> live;
+      for (std::size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        live.emplace_back(pool.allocate(1llu << (i % 8)));
+        if (live.size() == NUM_LIVE) {
+          std::set<void *> ptrs;
+          for (const auto &sp : live) ptrs.emplace(sp.get());
+          if (ptrs.size() != NUM_LIVE) ok[t] = 0;
+          live.erase(live.begin(), live.begin() + NUM_LIVE / 2);
+        }
+      }
+      // Remaining handles are released by another thread.
+      handles[t] = std::move(live);
+    });
+  }
+  for (auto &th : threads) th.join();
+  for (std::size_t t = 0; t < NUM_THREADS; ++t) EXPECT_TRUE(ok[t]);
+
+  // All handles alive at the same time have distinct addresses.
+  std::set<void *> ptrs;
+  std::size_t num_handles = 0;
+  for (const auto &hs : handles) {
+    for (const auto &sp : hs) ptrs.emplace(sp.get());
+    num_handles += hs.size();
+  }
+  EXPECT_EQ(num_handles, ptrs.size());
+
+  // A block with the size not used above is also released by another thread.
+  std::thread([&] {
+    handles[0].emplace_back(pool.allocate(1llu << 10));
+  }).join();
+  void *released = handles[0].back().get();
+
+  std::thread releaser([&] { handles.clear(); });
+  releaser.join();
+
+  // Blocks released by other threads are reused.
+  const auto sp = pool.allocate(1llu << 10);
+  EXPECT_EQ(released, sp.get());
+}
+
+}  // namespace primitiv
@@ -1,5 +1,6 @@
 #include <primitiv/config.h>
 
+#include <thread>
 #include <gtest/gtest.h>
 #include <primitiv/mixins.h>
 
@@ -76,5 +77,46 @@ TEST_F(MixinsTest, CheckDefaultSettable) {
   EXPECT_EQ(&obj0, &TestClass::get_reference_or_default(&obj0));
 }
 
+TEST_F(MixinsTest, CheckDefaultSettableMultipleThreads) {
+  class TestClass : public DefaultSettable<TestClass> {};
+
+  TestClass obj0;
+  TestClass::set_default(obj0);
+
+  bool thrown = false;
+  bool registered = false;
+  std::thread th([&] {
+    // Other threads do not share the default object.
+    try {
+      TestClass::get_default();
+    } catch (const Error &) {
+      thrown = true;
+    }
+    TestClass obj1;
+    TestClass::set_default(obj1);
+    registered = &obj1 == &TestClass::get_default();
+  });
+  th.join();
+  EXPECT_TRUE(thrown);
+  EXPECT_TRUE(registered);
+  EXPECT_EQ(&obj0, &TestClass::get_default());
+
+  // Destroying the default object unregisters it from all threads.
+  TestClass *obj2 = new TestClass();
+  bool unregistered = false;
+  std::thread th2([&] {
+    TestClass::set_default(*obj2);
+    std::thread([&] { delete obj2; }).join();
+    try {
+      TestClass::get_default();
+    } catch (const Error &) {
+      unregistered = true;
+    }
+  });
+  th2.join();
+  EXPECT_TRUE(unregistered);
+  EXPECT_EQ(&obj0, &TestClass::get_default());
+}
+
 }  // namespace mixins
 }  // namespace primitiv
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
+#include <primitiv/file_format.h>
 #include <primitiv/model.h>
 #include <primitiv/naive_device.h>
 #include <primitiv/parameter.h>
@@ -363,6 +364,79 @@ TEST_F(ModelTest, CheckSaveLoad_Same) {
   }
 }
 
+TEST_F(ModelTest, CheckSaveLoad_ReducedPrecision) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {.5, -.25, 8, -1024};
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveLoad_ReducedPrecision.data";
+
+  for (const auto precision : {
+      FileFormat::Precision::FLOAT16, FileFormat::Precision::BFLOAT16}) {
+    {
+      Model m1, m2;
+      Parameter p1(shape, values1), p2(shape, values2);
+      m1.add("p", p1);
+      m2.add("p", p2);
+      m1.add("sm", m2);
+
+      ASSERT_NO_THROW(m1.save(path, true, precision));
+    }
+
+    {
+      Model m1, m2;
+      Parameter p1, p2;
+      m1.add("p", p1);
+      m2.add("p", p2);
+      m1.add("sm", m2);
+
+      EXPECT_NO_THROW(m1.load(path));
+      std::remove(path.c_str());
+
+      ASSERT_TRUE(p1.valid());
+      ASSERT_TRUE(p2.valid());
+      EXPECT_EQ(shape, p1.shape());
+      EXPECT_EQ(shape, p2.shape());
+      EXPECT_TRUE(vector_match(values1, p1.value().to_vector()));
+      EXPECT_TRUE(vector_match(values2, p2.value().to_vector()));
+    }
+  }
+}
+
+TEST_F(ModelTest, CheckSaveLoad_SeparateStatsPrecision) {
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  // Not representable in reduced precisions.
+  const vector<float> stats {.1, -.2, .3, -1e-6};
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveLoad_SeparateStatsPrecision.data";
+
+  for (const auto precision : {
+      FileFormat::Precision::FLOAT16, FileFormat::Precision::BFLOAT16}) {
+    {
+      Model m;
+      Parameter p(shape, values);
+      p.add_stats("a", shape);
+      p.stats("a").reset_by_vector(stats);
+      m.add("p", p);
+
+      ASSERT_NO_THROW(m.save(path, true, precision));
+    }
+
+    {
+      Model m;
+      Parameter p;
+      m.add("p", p);
+
+      EXPECT_NO_THROW(m.load(path));
+      std::remove(path.c_str());
+
+      ASSERT_TRUE(p.valid());
+      EXPECT_TRUE(vector_match(values, p.value().to_vector()));
+      ASSERT_TRUE(p.has_stats("a"));
+      EXPECT_TRUE(vector_match(stats, p.stats("a").to_vector()));
+    }
+  }
+}
+
 TEST_F(ModelTest, CheckSaveLoad_Insufficient) {
   const Shape shape {2, 2};
   const vector<float> values1 {1, 2, 3, 4};
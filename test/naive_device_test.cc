@@ -1,11 +1,15 @@
 #include <primitiv/config.h>
 
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/error.h>
+#include <primitiv/functions.h>
+#include <primitiv/graph.h>
 #include <primitiv/naive_device.h>
+#include <primitiv/parameter.h>
 #include <primitiv/shape.h>
 #include <primitiv/tensor.h>
 #include <test_utils.h>
@@ -80,10 +84,10 @@ TEST_F(NaiveDeviceTest, CheckRandomBernoulli) {
 
 TEST_F(NaiveDeviceTest, CheckRandomBernoulliWithSeed) {
   const vector<float> expected {
-    0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0,
-    0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0,
+    1, 0, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+    0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
   };
   devices::Naive dev(12345);
   const Tensor x = dev.random_bernoulli(Shape({4, 4}, 4), 0.3);
@@ -117,8 +121,8 @@ TEST_F(NaiveDeviceTest, CheckRandomUniform) {
 
 TEST_F(NaiveDeviceTest, CheckRandomUniformWithSeed) {
   const vector<float> expected {
-    7.7330894e+00, 7.0227852e+00, -3.3052402e+00, -6.6472688e+00,
-    -5.6894612e+00, -8.2843294e+00, -5.3179150e+00, 5.8758497e+00,
+    -3.6453762e+00, -2.8291702e-02, -6.0376234e+00, -6.5357161e+00,
+    -1.6798029e+00, 3.4201746e+00, -4.4367599e-01, -2.2292976e+00,
   };
   devices::Naive dev(12345);
   const Tensor x = dev.random_uniform(Shape({2, 2}, 2), -9, 9);
@@ -151,20 +155,10 @@ TEST_F(NaiveDeviceTest, CheckRandomNormal) {
 #endif  // PRIMITIV_BUILD_TESTS_PROBABILISTIC
 
 TEST_F(NaiveDeviceTest, CheckRandomNormalWithSeed) {
-#ifdef __GLIBCXX__
   const vector<float> expected {
-    -1.3574908e+00, -1.7222166e-01, 2.5865970e+00, -4.3594337e-01,
-    4.5383353e+00, 8.4703674e+00, 2.5535507e+00, 1.3252910e+00,
+    -3.6713247e+00, 1.0461352e+00, 4.7174034e+00, 5.3196931e+00,
+    -4.8122644e-01, -2.7418165e+00, -1.6057708e+00, 3.5683806e+00,
   };
-#elif defined _LIBCPP_VERSION
-  const vector<float> expected {
-    -1.7222166e-01, -1.3574908e+00, -4.3594337e-01, 2.5865970e+00,
-    8.4703674e+00, 4.5383353e+00, 1.3252910e+00, 2.5535507e+00,
-  };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
   devices::Naive dev(12345);
   const Tensor x = dev.random_normal(Shape({2, 2}, 2), 1, 3);
 #ifdef PRIMITIV_MAYBE_FPMATH_X87
@@ -200,20 +194,10 @@ TEST_F(NaiveDeviceTest, CheckRandomLogNormal) {
 #endif  // PRIMITIV_BUILD_TESTS_PROBABILISTIC
 
 TEST_F(NaiveDeviceTest, CheckRandomLogNormalWithSeed) {
-#ifdef __GLIBCXX__
   const vector<float> expected {
-    2.5730559e-01, 8.4179258e-01, 1.3284487e+01, 6.4665437e-01,
-    9.3534966e+01, 4.7712681e+03, 1.2852659e+01, 3.7632804e+00,
+    2.5442744e-02, 2.8466282e+00, 1.1187737e+02, 2.0432117e+02,
+    6.1802495e-01, 6.4453162e-02, 2.0073476e-01, 3.5459126e+01,
   };
-#elif defined _LIBCPP_VERSION
-  const vector<float> expected {
-    8.4179258e-01, 2.5730559e-01, 6.4665437e-01, 1.3284487e+01,
-    4.7712681e+03, 9.3534966e+01, 3.7632804e+00, 1.2852659e+01,
-  };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
   devices::Naive dev(12345);
   const Tensor x = dev.random_log_normal(Shape({2, 2}, 2), 1, 3);
 #ifdef PRIMITIV_MAYBE_FPMATH_X87
@@ -223,4 +207,120 @@ TEST_F(NaiveDeviceTest, CheckRandomLogNormalWithSeed) {
 #endif
 }
 
+TEST_F(NaiveDeviceTest, CheckAsync) {
+  devices::Naive dev;
+  EXPECT_FALSE(dev.is_async());
+  dev.set_async(true);
+  EXPECT_TRUE(dev.is_async());
+  EXPECT_NO_THROW(dev.set_async(true));
+
+  vector<float> data {1, 2, 3, 4};
+  const Tensor a = dev.new_tensor_by_vector({2, 2}, data);
+  // Values are copied before returning.
+  data.assign(4, 0);
+  Tensor b = functions::matmul(a, a) + a;
+  EXPECT_TRUE(vector_match(vector<float> {8, 12, 18, 26}, b.to_vector()));
+  EXPECT_FLOAT_EQ(44, functions::sum(b, 0).to_vector()[1]);
+  EXPECT_EQ((vector<std::uint32_t> {1, 1}), b.argmax(0));
+
+  // Memories of temporary values are kept while kernels use them.
+  Tensor c = a;
+  for (int i = 0; i < 100; ++i) {
+    c = functions::exp(
+        functions::log(c) + functions::zeros<Tensor>({2, 2}, dev));
+  }
+  EXPECT_TRUE(vector_near(vector<float> {1, 2, 3, 4}, c.to_vector(), 1e-4));
+
+  dev.set_async(false);
+  EXPECT_FALSE(dev.is_async());
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3, 4}, a.to_vector()));
+}
+
+TEST_F(NaiveDeviceTest, CheckAsyncCopyOnWrite) {
+  devices::Naive dev;
+  // Tensors allocated before enabling the asynchronous mode.
+  const Tensor x = dev.new_tensor_by_vector({2}, {1, 2});
+  Tensor y = dev.new_tensor_by_vector({2}, {10, 20});
+  dev.set_async(true);
+
+  Tensor z = y;
+  z.inplace_add(x);
+  z.inplace_multiply_const(2);
+  y.inplace_subtract(x);
+  EXPECT_TRUE(vector_match(vector<float> {22, 44}, z.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {9, 18}, y.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {1, 2}, x.to_vector()));
+
+  // In-place operations.
+  Tensor w = functions::copy(x, dev);
+  Tensor v = w;
+  w = functions::tanh(std::move(w));
+  EXPECT_TRUE(vector_match(vector<float> {1, 2}, v.to_vector()));
+  EXPECT_TRUE(vector_near(
+        vector<float> {std::tanh(1.f), std::tanh(2.f)}, w.to_vector(), 1e-6));
+}
+
+TEST_F(NaiveDeviceTest, CheckAsyncCopyAcrossDevices) {
+  devices::Naive dev1, dev2;
+  dev1.set_async(true);
+  dev2.set_async(true);
+  Tensor x = dev1.new_tensor_by_vector({3}, {1, 2, 3});
+  x = functions::exp(functions::log(x));
+  Tensor y = functions::copy(x, dev2);
+  x.inplace_multiply_const(0);
+  EXPECT_TRUE(vector_near(vector<float> {1, 2, 3}, y.to_vector(), 1e-6));
+  EXPECT_TRUE(vector_match(vector<float> {0, 0, 0}, x.to_vector()));
+}
+
+TEST_F(NaiveDeviceTest, CheckShareAcrossDevices) {
+  devices::Naive dev2;
+  Tensor y;
+  {
+    // The shared memory is available after the source device is destroyed.
+    devices::Naive dev1;
+    const Tensor x = dev1.new_tensor_by_vector({3}, {1, 2, 3});
+    y = functions::copy(x, dev2);
+  }
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, y.to_vector()));
+  y *= 2;
+  EXPECT_TRUE(vector_match(vector<float> {2, 4, 6}, y.to_vector()));
+}
+
+TEST_F(NaiveDeviceTest, CheckAsyncShareAcrossDevices) {
+  devices::Naive dev2;
+  Tensor y;
+  {
+    // Memories allocated in the asynchronous mode are not shared, and the
+    // result does not depend on the source device.
+    devices::Naive dev1;
+    dev1.set_async(true);
+    const Tensor x = dev1.new_tensor_by_vector({3}, {1, 2, 3});
+    y = dev2.share_tensor(x);
+  }
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, y.to_vector()));
+}
+
+TEST_F(NaiveDeviceTest, CheckAsyncGraph) {
+  vector<float> results[2];
+  for (const bool async : {false, true}) {
+    devices::Naive dev;
+    Device::set_default(dev);
+    Parameter w({2, 2}, {1, -1, 2, -2});
+    dev.set_async(async);
+    Graph g;
+    Graph::set_default(g);
+    const Node x = functions::input<Node>({2}, {3, 4});
+    const Node y = functions::tanh(
+        functions::matmul(functions::parameter<Node>(w), x));
+    const Node loss = functions::sum(y * y, 0);
+    w.reset_gradient();
+    loss.backward();
+    results[async] = y.to_vector();
+    for (const float v : w.gradient().to_vector()) {
+      results[async].emplace_back(v);
+    }
+  }
+  EXPECT_TRUE(vector_match(results[0], results[1]));
+}
+
 }  // namespace primitiv
@@ -1,6 +1,8 @@
 #include <primitiv/config.h>
 
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/numeric_utils.h>
@@ -28,5 +30,72 @@ TEST_F(NumericUtilsTest, CheckCalculateShifts) {
   EXPECT_EQ(64ull, calculate_shifts(0xffffffffffffffffull));
 }
 
+TEST_F(NumericUtilsTest, CheckFloat16Conversion) {
+  struct TestCase { float f; std::uint16_t h; };
+  const std::vector<TestCase> test_cases {
+    {0.f, 0x0000}, {-0.f, 0x8000},
+    {1.f, 0x3c00}, {-2.f, 0xc000}, {.5f, 0x3800}, {65504.f, 0x7bff},
+    {6.103515625e-5f, 0x0400},  // Minimum normal
+    {5.9604644775390625e-8f, 0x0001},  // Minimum subnormal
+    {std::numeric_limits<float>::infinity(), 0x7c00},
+    {-std::numeric_limits<float>::infinity(), 0xfc00},
+  };
+  for (const TestCase &tc : test_cases) {
+    EXPECT_EQ(tc.h, float_to_float16(tc.f));
+    EXPECT_EQ(tc.f, float16_to_float(tc.h));
+  }
+
+  // Overflow, underflow and rounding to nearest even.
+  EXPECT_EQ(0x7c00, float_to_float16(1e6f));
+  EXPECT_EQ(0x0000, float_to_float16(1e-10f));
+  EXPECT_EQ(0x3c00, float_to_float16(1.f + 1.f / 2048));
+  EXPECT_EQ(0x3c02, float_to_float16(1.f + 3.f / 2048));
+  EXPECT_TRUE(std::isnan(float16_to_float(
+          float_to_float16(std::numeric_limits<float>::quiet_NaN()))));
+
+  // Array conversion should be consistent with the scalar conversion.
+  std::vector<float> src(37);
+  for (std::size_t i = 0; i < src.size(); ++i) src[i] = .1f * i - 1.7f;
+  std::vector<std::uint16_t> h(src.size());
+  std::vector<float> dest(src.size());
+  float_to_float16(src.size(), src.data(), h.data());
+  float16_to_float(h.size(), h.data(), dest.data());
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    EXPECT_EQ(float_to_float16(src[i]), h[i]);
+    EXPECT_EQ(float16_to_float(h[i]), dest[i]);
+  }
+}
+
+TEST_F(NumericUtilsTest, CheckBFloat16Conversion) {
+  struct TestCase { float f; std::uint16_t h; };
+  const std::vector<TestCase> test_cases {
+    {0.f, 0x0000}, {-0.f, 0x8000},
+    {1.f, 0x3f80}, {-2.f, 0xc000}, {.5f, 0x3f00},
+    {std::numeric_limits<float>::infinity(), 0x7f80},
+    {-std::numeric_limits<float>::infinity(), 0xff80},
+  };
+  for (const TestCase &tc : test_cases) {
+    EXPECT_EQ(tc.h, float_to_bfloat16(tc.f));
+    EXPECT_EQ(tc.f, bfloat16_to_float(tc.h));
+  }
+
+  // Rounding to nearest even.
+  EXPECT_EQ(0x3f80, float_to_bfloat16(1.f + 1.f / 256));
+  EXPECT_EQ(0x3f82, float_to_bfloat16(1.f + 3.f / 256));
+  EXPECT_TRUE(std::isnan(bfloat16_to_float(
+          float_to_bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+  std::vector<float> src(37);
+  for (std::size_t i = 0; i < src.size(); ++i) src[i] = .1f * i - 1.7f;
+  std::vector<std::uint16_t> h(src.size());
+  std::vector<float> dest(src.size());
+  float_to_bfloat16(src.size(), src.data(), h.data());
+  bfloat16_to_float(h.size(), h.data(), dest.data());
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    EXPECT_EQ(float_to_bfloat16(src[i]), h[i]);
+    EXPECT_EQ(bfloat16_to_float(h[i]), dest[i]);
+  }
+}
+
 }  // namespace numeric_utils
 }  // namespace primitiv
@@ -228,6 +228,25 @@ TEST_F(OperatorImplTest, CheckInput) {
   EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
 }
 
+TEST_F(OperatorImplTest, CheckBorrowedInput) {
+  const Shape ret_shape({2, 2}, 3);
+  const vector<float> ret_data {1, 2, 3, 4, 0, 0, 0, 0, -1, -2, -3, -4};
+  Input node(ret_shape, ret_data.data(), *dev);
+  Shape cur_shape;
+  Tensor cur_value;
+  node.forward_shape(arg_shapes, { &cur_shape });
+  node.forward(arg_values, { &cur_value });
+  EXPECT_EQ("Input", node.name());
+  EXPECT_EQ(ret_shape, cur_shape);
+  EXPECT_EQ(dev, node.get_device());
+  EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
+
+  // Updating the result does not affect subsequent results.
+  cur_value.inplace_multiply_const(2);
+  node.forward(arg_values, { &cur_value });
+  EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
+}
+
 TEST_F(OperatorImplTest, CheckParameter) {
   const Shape ret_shape {2, 2};
   const initializers::Constant init(42);
@@ -341,7 +360,7 @@ TEST_F(OperatorImplTest, CheckRandomBernoulli) {
   };
   const vector<TestCase> test_cases {
     {Shape({2, 2}, 3), 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
-    {Shape({2, 2}, 3), 0.5, {1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0}},
+    {Shape({2, 2}, 3), 0.5, {0, 1, 1, 0, 0, 1, 1, 1, 1, 1, 0, 1}},
     {Shape({2, 2}, 3), 1, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
   };
   for (const TestCase &tc : test_cases) {
@@ -369,17 +388,17 @@ TEST_F(OperatorImplTest, CheckRandomUniform) {
   };
   const vector<TestCase> test_cases {
     {Shape({2, 2}, 3), -2, -1,
-      {-1.07038391, -1.10984528, -1.68362451, -1.86929274,
-        -1.81608117, -1.96024048, -1.79543972, -1.17356396,
-        -1.43227506, -1.46792209, -1.40445530, -1.04368997}},
+      {-1.70252085, -1.50157177, -1.83542347, -1.86309528,
+        -1.5933224, -1.30999029, -1.52464867, -1.62384987,
+        -1.60913444, -1.96730757, -1.22802472, -1.5401212}},
     {Shape({2, 2}, 3), -1, 1,
-      {0.92902899, -0.07614738, 0.30635417, 0.84747636,
-        0.49781322, -0.25215763, 0.30713975, -0.69005328,
-        0.49542964, 0.78468740, 0.92261350, -0.94642055}},
+      {0.350922227, -0.00638389587, -0.661282063, 0.392053008,
+        0.159985542, -0.666331172, -0.426229358, -0.379952788,
+        -0.933828354, -0.817057252, 0.504452825, -0.950701475}},
     {Shape({2, 2}, 3), 1, 2,
-      {1.00838828, 1.29150236, 1.10644436, 1.39874411,
-        1.29870367, 1.80728865, 1.65641117, 1.62709427,
-        1.80981255, 1.90792489, 1.87217593, 1.55639732}},
+      {1.77027845, 1.76800191, 1.5503161, 1.41195905,
+        1.29827189, 1.78900194, 1.8082521, 1.97763276,
+        1.12410355, 1.48141086, 1.65421748, 1.33848059}},
   };
   for (const TestCase &tc : test_cases) {
     RandomUniform node(tc.shape, tc.lower, tc.upper, *dev);
@@ -406,44 +425,20 @@ TEST_F(OperatorImplTest, CheckRandomNormal) {
     float mean, sd;
     vector<float> data;
   };
-#ifdef __GLIBCXX__
   const vector<TestCase> test_cases {
     {Shape({2, 2}, 3), -2, 2,
-      {-3.57166052, -2.78148127, -0.94226873, -2.95729542,
-        0.35889030, 2.98024511, -0.96429956, -1.78313935,
-        -2.08661819, -0.94322312, -0.78637350, -1.56128621}},
+      {-5.1142168, -1.96924329, 0.4782691, 0.879795313,
+        -2.98748446, -4.49454403, -3.73718071, -0.28774631,
+        0.683742523, -1.44083977, -3.39341736, -1.64109957}},
     {Shape({2, 2}, 3), 0, 1,
-      {-0.69024169, 1.36268508, -0.96791244, 0.43081367,
-        0.46228078, 0.29187113, -0.22691579, -0.88196278,
-        0.92891538, -0.60850668, 1.20224774, 1.47957015}},
+      {-0.885665715, 0.017765224, -0.626914203, -1.77720237,
+        0.520937979, 0.904490411, -0.581964374, 1.46923888,
+        2.19150949, 1.41936159, 0.745577574, 0.116403908}},
     {Shape({2, 2}, 3), 2, .5,
-      {2.07982802, 2.52679920, 2.56787491, 2.26420283,
-        2.16808653, 2.08484149, 0.90178788, 1.73830211,
-        2.59950328, 1.45240283, 1.47200286, 1.91403091}},
-  };
-#elif defined _LIBCPP_VERSION
-  const vector<TestCase> test_cases {
-    {Shape({2, 2}, 3), -2, 2,
-      {-2.78148127, -3.57166052, -2.95729542, -0.94226873,
-        2.98024511,  0.35889030, -1.78313935, -0.96429944,
-       -0.94322312, -2.08661819, -1.56128621, -0.78637350}},
-    {Shape({2, 2}, 3), 0, 1,
-      { 1.36268508, -0.69024169,  0.43081367, -0.96791244,
-        0.29187110,  0.46228072, -0.88196278, -0.22691579,
-       -0.60850668,  0.92891538,  1.47957015,  1.20224774}},
-    {Shape({2, 2}, 3), 2, .5,
-      {2.52679920, 2.07982802, 2.26420283, 2.56787491,
-       2.08484149, 2.16808653, 1.73830211, 0.90178788,
-       1.45240283, 2.59950328, 1.91403091, 1.47200286}},
-  };
-#else
-  const vector<TestCase> test_cases {
-    {Shape({2, 2}, 3), -2, 2, {}},
-    {Shape({2, 2}, 3), 0, 1, {}},
-    {Shape({2, 2}, 3), 2, .5, {}},
+      {2.04077363, 1.64105844, 1.53502965, 2.28711271,
+        2.18868709, 1.24549866, 2.32303572, 1.95429993,
+        0.985529304, 2.11903119, 1.75691915, 2.39124084}},
   };
-  std::cerr << "... Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
   for (const TestCase &tc : test_cases) {
     RandomNormal node(tc.shape, tc.mean, tc.sd, *dev);
     Shape cur_shape;
@@ -473,46 +468,20 @@ TEST_F(OperatorImplTest, CheckRandomLogNormal) {
     float mean, sd;
     vector<float> data;
   };
-#ifdef __GLIBCXX__
   const vector<TestCase> test_cases {
     {Shape({2, 2}, 3), -2, 2,
-      {0.02810914, 0.06194668, 0.38974261, 0.05195925,
-        1.43173969, 19.69264221, 0.38125014, 0.16810957,
-        0.12410613, 0.38937083, 0.45549366, 0.20986597}},
+      {0.00601068372, 0.139562428, 1.61327958, 2.41040635,
+        0.0504140966, 0.0111697726, 0.0238211676, 0.749951839,
+        1.9812789, 0.236728877, 0.0335936807, 0.193766862}},
     {Shape({2, 2}, 3), 0, 1,
-      {0.50145483, 3.90666890, 0.37987521, 1.53850889,
-        1.58769107, 1.33893049, 0.79698789, 0.41396958,
-        2.53176165, 0.54416287, 3.32758808, 4.39105797}},
+      {0.412439525, 1.01792395, 0.534237802, 0.169110596,
+        1.68360615, 2.47067261, 0.558799624, 4.34592628,
+        8.94871044, 4.13448, 2.10765839, 1.12344956}},
     {Shape({2, 2}, 3), 2, .5,
-      {8.00309277, 12.51338959, 13.03808784, 9.62345028,
-        8.74154091, 8.04331684, 2.46400452, 5.68767834,
-        13.45705223, 4.27337027, 4.35795498, 6.78036499}},
+      {7.69656134, 5.1606288, 4.64146328, 9.84646702,
+        8.92348957, 3.47466707, 10.2066116, 7.0589757,
+        2.67922974, 8.32307053, 5.79455757, 10.9270439}},
   };
-#elif defined _LIBCPP_VERSION
-  const vector<TestCase> test_cases {
-    {Shape({2, 2}, 3), -2, 2,
-      { 0.06194668, 0.02810914, 0.05195925, 0.38974261,
-       19.69264221, 1.43173969, 0.16810957, 0.38125020,
-        0.38937083, 0.12410613, 0.20986597, 0.45549366}},
-    {Shape({2, 2}, 3), 0, 1,
-      {3.90666890, 0.50145483, 1.53850889, 0.37987521,
-       1.33893037, 1.58769095, 0.41396958, 0.79698789,
-       0.54416287, 2.53176165, 4.39105797, 3.32758808}},
-    {Shape({2, 2}, 3), 2, .5,
-      {12.51338959,  8.00309277, 9.62345028, 13.03808784,
-        8.04331684,  8.74154091, 5.68767834,  2.46400452,
-        4.27337027, 13.45705223, 6.78036499,  4.35795498}},
-  };
-#else
-  const vector<TestCase> test_cases {
-    {Shape({2, 2}, 3), -2, 2, {}},
-    {Shape({2, 2}, 3), 0, 1, {}},
-    {Shape({2, 2}, 3), 2, .5, {}},
-  };
-  std::cerr
-    << "... Unknown C++ library. Expected results can't be defined."
-    << std::endl;
-#endif
   for (const TestCase &tc : test_cases) {
     RandomLogNormal node(tc.shape, tc.mean, tc.sd, *dev);
     Shape cur_shape;
@@ -1353,6 +1322,38 @@ TEST_F(OperatorImplTest, CheckELU) {
   TEST_1ARG_K_NEAR(ELU, 1, 1e-6);
 }
 
+TEST_F(OperatorImplTest, CheckDropout) {
+  // y = 2 * x * mask
+  // dy/dx = 2 * mask
+  setup_1arg_nonzero();
+  const Shape ret_shape({2, 2}, 3);
+  const vector<float> ret_data {
+    2, 4, 6, 8,
+    2, 0, 2, -2,
+    -2, -4, 0, -8,
+  };
+  const vector<float> bw_grad {
+    2, 2, 2, 2,
+    2, 0, 2, 2,
+    2, 2, 0, 2,
+  };
+  Dropout node(.5);
+  EXPECT_EQ("Dropout(" + std::to_string(.5f) + ')', node.name());
+  EXPECT_FALSE(node.equals(Dropout(.5)));
+  Shape cur_shape;
+  Tensor cur_value;
+  node.forward_shape(arg_shapes, { &cur_shape });
+  EXPECT_EQ(ret_shape, cur_shape);
+  node.forward(arg_values, { &cur_value });
+  EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
+  // The same mask is used in the recalculation.
+  node.forward(arg_values, { &cur_value });
+  EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
+  const Tensor cur_grad = functions::ones<Tensor>(ret_shape, *dev);
+  node.backward(arg_values, { &cur_value }, { &cur_grad }, arg_grads);
+  EXPECT_TRUE(vector_match(bw_grad, arg_grads[0]->to_vector()));
+}
+
 TEST_F(OperatorImplTest, CheckSum) {
   // y = sum(x, dim)
   // dy/dx = broadcast(1, dim, x.shape[dim])
@@ -2026,5 +2027,36 @@ TEST_F(OperatorImplTest, CheckStopGradient) {
   TEST_1ARG(StopGradient);
 }
 
+TEST_F(OperatorImplTest, CheckEquals) {
+  devices::Naive dev2;
+  primitiv::Parameter param1({2}, {1, 2}, *dev);
+  primitiv::Parameter param2({2}, {1, 2}, *dev);
+
+  EXPECT_TRUE(Tanh().equals(Tanh()));
+  EXPECT_FALSE(Tanh().equals(Sigmoid()));
+  EXPECT_TRUE(AddConst(1).equals(AddConst(1)));
+  EXPECT_FALSE(AddConst(1).equals(AddConst(2)));
+  EXPECT_FALSE(AddConst(0).equals(AddConst(-0.f)));
+  EXPECT_FALSE(AddConst(1).equals(SubtractConstR(1)));
+  EXPECT_TRUE(Slice(0, 1, 2).equals(Slice(0, 1, 2)));
+  EXPECT_FALSE(Slice(0, 1, 2).equals(Slice(0, 1, 3)));
+  EXPECT_TRUE(Pick({0, 1}, 0).equals(Pick({0, 1}, 0)));
+  EXPECT_FALSE(Pick({0, 1}, 0).equals(Pick({1, 0}, 0)));
+  EXPECT_TRUE(Constant({2}, 1, *dev).equals(Constant({2}, 1, *dev)));
+  EXPECT_FALSE(Constant({2}, 1, *dev).equals(Constant({2}, 1, dev2)));
+  EXPECT_FALSE(Constant({2}, 1, *dev).equals(Constant({3}, 1, *dev)));
+  EXPECT_TRUE(Parameter(param1).equals(Parameter(param1)));
+  EXPECT_FALSE(Parameter(param1).equals(Parameter(param2)));
+  EXPECT_TRUE(Convolution2D(0, 0, 1, 1, 1, 1).equals(
+        Convolution2D(0, 0, 1, 1, 1, 1)));
+  EXPECT_FALSE(Convolution2D(0, 0, 1, 1, 1, 1).equals(
+        Convolution2D(0, 0, 1, 1, 1, 2)));
+
+  // Operators with data or random numbers are never equal.
+  EXPECT_FALSE(Input({2}, {1, 2}, *dev).equals(Input({2}, {1, 2}, *dev)));
+  EXPECT_FALSE(
+      RandomNormal({2}, 0, 1, *dev).equals(RandomNormal({2}, 0, 1, *dev)));
+}
+
 }  // namespace operators
 }  // namespace primitiv
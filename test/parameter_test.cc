@@ -1,16 +1,21 @@
 #include <primitiv/config.h>
 
 #include <cstdio>
+#include <fstream>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/error.h>
+#include <primitiv/file_format.h>
 #include <primitiv/initializer_impl.h>
 #include <primitiv/naive_device.h>
+#include <primitiv/optimizer_impl.h>
 #include <primitiv/parameter.h>
 #include <test_utils.h>
 
 using std::vector;
 using test_utils::vector_match;
+using test_utils::vector_near;
 
 namespace primitiv {
 
@@ -317,6 +322,80 @@ TEST_F(ParameterTest, CheckSaveLoadWithStats) {
   EXPECT_TRUE(vector_match(values, p2.stats("a").to_vector()));
 }
 
+TEST_F(ParameterTest, CheckSaveLoadWithReducedPrecision) {
+  Device::set_default(dev);
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  const vector<float> stats {.5, -.25, 8, -1024};
+  Parameter p1(shape, values);
+  p1.add_stats("a", {2, 2});
+  p1.stats("a").reset_by_vector(stats);
+
+  const std::string path32 = "/tmp/primitiv_ParameterTest_CheckSaveLoadWithReducedPrecision_32.data";
+  p1.save(path32, true, FileFormat::Precision::FLOAT32);
+  std::ifstream ifs32(path32, std::ios::binary | std::ios::ate);
+  const std::streamoff size32 = ifs32.tellg();
+  ifs32.close();
+  std::remove(path32.c_str());
+
+  for (const auto precision : {
+      FileFormat::Precision::FLOAT16, FileFormat::Precision::BFLOAT16}) {
+    const std::string path = "/tmp/primitiv_ParameterTest_CheckSaveLoadWithReducedPrecision.data";
+    p1.save(path, true, precision);
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    EXPECT_GT(size32, static_cast<std::streamoff>(ifs.tellg()));
+    ifs.close();
+
+    Parameter p2;
+    p2.load(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(shape, p2.shape());
+    EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+    EXPECT_TRUE(vector_match({0, 0, 0, 0}, p2.gradient().to_vector()));
+    ASSERT_TRUE(p2.has_stats("a"));
+    EXPECT_TRUE(vector_match(stats, p2.stats("a").to_vector()));
+  }
+}
+
+TEST_F(ParameterTest, CheckSaveLoadWithSeparateStatsPrecision) {
+  Device::set_default(dev);
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  // Not representable in reduced precisions.
+  const vector<float> stats {.1, -.2, .3, -1e-6};
+  Parameter p1(shape, values);
+  p1.add_stats("a", {2, 2});
+  p1.stats("a").reset_by_vector(stats);
+
+  const std::string path = "/tmp/primitiv_ParameterTest_CheckSaveLoadWithSeparateStatsPrecision.data";
+  for (const auto precision : {
+      FileFormat::Precision::FLOAT16, FileFormat::Precision::BFLOAT16}) {
+    {
+      // Statistics are stored in single-precision by default.
+      p1.save(path, true, precision);
+      Parameter p2;
+      p2.load(path);
+      std::remove(path.c_str());
+
+      EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+      ASSERT_TRUE(p2.has_stats("a"));
+      EXPECT_TRUE(vector_match(stats, p2.stats("a").to_vector()));
+    }
+    {
+      p1.save(path, true, precision, precision);
+      Parameter p2;
+      p2.load(path);
+      std::remove(path.c_str());
+
+      EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+      ASSERT_TRUE(p2.has_stats("a"));
+      EXPECT_FALSE(vector_match(stats, p2.stats("a").to_vector()));
+      EXPECT_TRUE(vector_near(stats, p2.stats("a").to_vector(), 1e-2));
+    }
+  }
+}
+
 TEST_F(ParameterTest, CheckSaveWithoutStats) {
   Device::set_default(dev);
   const Shape shape {2, 2};
@@ -364,4 +443,83 @@ TEST_F(ParameterTest, CheckInvalidSave) {
   EXPECT_THROW(invalid.save("/tmp/not_generated"), Error);
 }
 
+TEST_F(ParameterTest, CheckLocalGradients) {
+  Device::set_default(dev);
+  const Shape shape {2, 2};
+  Parameter p1(shape, {1, 2, 3, 4});
+  Parameter p2(shape, {5, 6, 7, 8});
+  p1.gradient().reset_by_vector({1, 1, 1, 1});
+  p2.gradient().reset_by_vector({2, 2, 2, 2});
+
+  {
+    LocalGradients lg;
+    lg.add(p1);
+
+    // Only registered parameters use local gradients.
+    EXPECT_TRUE(vector_match({0, 0, 0, 0}, p1.gradient().to_vector()));
+    EXPECT_TRUE(vector_match({2, 2, 2, 2}, p2.gradient().to_vector()));
+    p1.gradient().reset_by_vector({3, 3, 3, 3});
+    EXPECT_TRUE(vector_match({3, 3, 3, 3}, p1.gradient().to_vector()));
+
+    // Other threads use the shared gradient.
+    vector<float> shared;
+    std::thread th([&] { shared = p1.gradient().to_vector(); });
+    th.join();
+    EXPECT_TRUE(vector_match({1, 1, 1, 1}, shared));
+
+    {
+      // Nested object.
+      LocalGradients lg2;
+      lg2.add(p2);
+      EXPECT_TRUE(vector_match({3, 3, 3, 3}, p1.gradient().to_vector()));
+      EXPECT_TRUE(vector_match({0, 0, 0, 0}, p2.gradient().to_vector()));
+    }
+    EXPECT_TRUE(vector_match({2, 2, 2, 2}, p2.gradient().to_vector()));
+
+    p1.reset_gradient();
+    EXPECT_TRUE(vector_match({0, 0, 0, 0}, p1.gradient().to_vector()));
+  }
+
+  EXPECT_TRUE(vector_match({1, 1, 1, 1}, p1.gradient().to_vector()));
+  EXPECT_TRUE(vector_match({2, 2, 2, 2}, p2.gradient().to_vector()));
+}
+
+TEST_F(ParameterTest, CheckLocalStats) {
+  Device::set_default(dev);
+  const Shape shape {2, 2};
+  Parameter p(shape, {1, 2, 3, 4});
+  p.add_stats("shared", shape);
+  p.stats("shared").reset(1);
+
+  // Each thread optimizes the parameter with its own statistics.
+  auto train = [&](float lr, vector<float> &m) {
+    LocalGradients lg;
+    lg.add(p);
+    EXPECT_FALSE(p.has_stats("shared"));
+    optimizers::MomentumSGD opt(lr, .5);
+    opt.add(p);
+    EXPECT_TRUE(p.has_stats("MomentumSGD.m"));
+    p.gradient().reset(1);
+    opt.update();
+    m = p.stats("MomentumSGD.m").to_vector();
+  };
+  vector<float> m1, m2;
+  std::thread th1([&] { train(.1, m1); });
+  th1.join();
+  std::thread th2([&] { train(.2, m2); });
+  th2.join();
+  EXPECT_TRUE(vector_match(vector<float>(4, -.1), m1));
+  EXPECT_TRUE(vector_match(vector<float>(4, -.2), m2));
+
+  // Local statistics are discarded with the LocalGradients object.
+  EXPECT_FALSE(p.has_stats("MomentumSGD.m"));
+  EXPECT_TRUE(vector_match(vector<float>(4, 1), p.stats("shared").to_vector()));
+}
+
+TEST_F(ParameterTest, CheckInvalidLocalGradients) {
+  Parameter invalid;
+  LocalGradients lg;
+  EXPECT_THROW(lg.add(invalid), Error);
+}
+
 }  // namespace primitiv
@@ -1,5 +1,7 @@
 #include <primitiv/config.h>
 
+#include <cstdint>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/random.h>
@@ -18,12 +20,88 @@ protected:
   DefaultRandomizerTest() : randomizer_(12345) {}
 };
 
+TEST_F(DefaultRandomizerTest, CheckPhilox) {
+  struct TestCase {
+    vector<std::uint32_t> key, counter, expected;
+  };
+  // Known-answer tests of Random123.
+  const vector<TestCase> test_cases {
+    {{0, 0}, {0, 0, 0, 0},
+      {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+    {{0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+      {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+    {{0xa4093822, 0x299f31d0}, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+      {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+  };
+  for (const TestCase &tc : test_cases) {
+    vector<std::uint32_t> observed(4);
+    DefaultRandomizer::philox(
+        tc.key.data(), tc.counter.data(), observed.data());
+    EXPECT_EQ(tc.expected, observed);
+  }
+}
+
+TEST_F(DefaultRandomizerTest, CheckNumThreads) {
+  EXPECT_LE(1u, randomizer_.get_num_threads());
+  randomizer_.set_num_threads(3);
+  EXPECT_EQ(3u, randomizer_.get_num_threads());
+  randomizer_.set_num_threads(0);
+  EXPECT_EQ(1u, randomizer_.get_num_threads());
+}
+
+TEST_F(DefaultRandomizerTest, CheckThreadIndependence) {
+  // Enough to use multiple threads, and not a multiple of 4.
+  const std::size_t size = (1 << 20) + 3;
+  vector<float> expected(size, -1e10);
+  vector<float> observed(size, -1e10);
+  for (const std::uint32_t num_threads : {2u, 3u, 8u}) {
+    DefaultRandomizer serial(12345), parallel(12345);
+    serial.set_num_threads(1);
+    parallel.set_num_threads(num_threads);
+    for (std::uint32_t i = 0; i < 2; ++i) {
+      serial.fill_normal(1, 3, size, expected.data());
+      parallel.fill_normal(1, 3, size, observed.data());
+      EXPECT_TRUE(vector_match(expected, observed));
+      serial.fill_uniform(-9, 9, size, expected.data());
+      parallel.fill_uniform(-9, 9, size, observed.data());
+      EXPECT_TRUE(vector_match(expected, observed));
+    }
+  }
+}
+
+TEST_F(DefaultRandomizerTest, CheckConcurrentFill) {
+  // Worker threads are shared by concurrent calls.
+  const std::size_t size = (1 << 20) + 3;
+  vector<float> expected1(size), expected2(size);
+  DefaultRandomizer serial(12345);
+  serial.set_num_threads(1);
+  serial.fill_uniform(-9, 9, size, expected1.data());
+  serial.fill_uniform(-9, 9, size, expected2.data());
+
+  DefaultRandomizer parallel(12345);
+  parallel.set_num_threads(4);
+  vector<float> observed1(size), observed2(size);
+  std::thread th([&] {
+    parallel.fill_uniform(-9, 9, size, observed1.data());
+  });
+  parallel.fill_uniform(-9, 9, size, observed2.data());
+  th.join();
+
+  // Each call obtains either of two ranges of counters.
+  if (observed1 == expected1) {
+    EXPECT_TRUE(vector_match(expected2, observed2));
+  } else {
+    EXPECT_TRUE(vector_match(expected2, observed1));
+    EXPECT_TRUE(vector_match(expected1, observed2));
+  }
+}
+
 TEST_F(DefaultRandomizerTest, CheckFillBernoulli) {
   const vector<float> expected {
-    0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0,
-    0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0,
+    1, 0, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+    0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
   };
 
   const std::size_t size = expected.size();
@@ -32,10 +110,23 @@ TEST_F(DefaultRandomizerTest, CheckFillBernoulli) {
   EXPECT_TRUE(vector_match(expected, observed));
 }
 
+TEST_F(DefaultRandomizerTest, CheckFillBernoulliBits) {
+  const std::size_t size = 70;
+  vector<float> expected(size, -1e10);
+  DefaultRandomizer(12345).fill_bernoulli(0.3, size, expected.data());
+
+  vector<std::uint32_t> observed(3, 0xffffffff);
+  randomizer_.fill_bernoulli_bits(0.3, size, observed.data());
+  for (std::size_t i = 0; i < size; ++i) {
+    EXPECT_EQ(expected[i], (observed[i / 32] >> (i % 32)) & 1);
+  }
+  EXPECT_EQ(0u, observed[2] >> (size % 32));
+}
+
 TEST_F(DefaultRandomizerTest, CheckFillUniform) {
   const vector<float> expected {
-    7.7330894e+00, 7.0227852e+00, -3.3052402e+00, -6.6472688e+00,
-    -5.6894612e+00, -8.2843294e+00, -5.3179150e+00, 5.8758497e+00,
+    -3.6453762e+00, -2.8291702e-02, -6.0376234e+00, -6.5357161e+00,
+    -1.6798029e+00, 3.4201746e+00, -4.4367599e-01, -2.2292976e+00,
   };
 
   const std::size_t size = expected.size();
@@ -45,20 +136,10 @@ TEST_F(DefaultRandomizerTest, CheckFillUniform) {
 }
 
 TEST_F(DefaultRandomizerTest, CheckFillNormal) {
-#ifdef __GLIBCXX__
-  const vector<float> expected {
-    -1.3574908e+00, -1.7222166e-01, 2.5865970e+00, -4.3594337e-01,
-    4.5383353e+00, 8.4703674e+00, 2.5535507e+00, 1.3252910e+00,
-  };
-#elif defined _LIBCPP_VERSION
   const vector<float> expected {
-    -1.7222166e-01, -1.3574908e+00, -4.3594337e-01, 2.5865970e+00,
-    8.4703674e+00, 4.5383353e+00, 1.3252910e+00, 2.5535507e+00,
+    -3.6713247e+00, 1.0461352e+00, 4.7174034e+00, 5.3196931e+00,
+    -4.8122644e-01, -2.7418165e+00, -1.6057708e+00, 3.5683806e+00,
   };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
 
   const std::size_t size = expected.size();
   vector<float> observed(size, -1e10);
@@ -71,20 +152,10 @@ TEST_F(DefaultRandomizerTest, CheckFillNormal) {
 }
 
 TEST_F(DefaultRandomizerTest, CheckFillLogNormal) {
-#ifdef __GLIBCXX__
-  const vector<float> expected {
-    2.5730559e-01, 8.4179258e-01, 1.3284487e+01, 6.4665437e-01,
-    9.3534966e+01, 4.7712681e+03, 1.2852659e+01, 3.7632804e+00,
-  };
-#elif defined _LIBCPP_VERSION
   const vector<float> expected {
-    8.4179258e-01, 2.5730559e-01, 6.4665437e-01, 1.3284487e+01,
-    4.7712681e+03, 9.3534966e+01, 3.7632804e+00, 1.2852659e+01,
+    2.5442744e-02, 2.8466282e+00, 1.1187737e+02, 2.0432117e+02,
+    6.1802495e-01, 6.4453162e-02, 2.0073476e-01, 3.5459126e+01,
   };
-#else
-  const vector<float> expected {};
-  std::cerr << "Unknown C++ library. Expected results can't be defined." << std::endl;
-#endif
 
   const std::size_t size = expected.size();
   vector<float> observed(size, -1e10);
@@ -125,6 +125,14 @@ TEST_F(ShapeOpsTest, CheckElementwise) {
     {{1, 2, 3}, Shape({1, 2, 3}, 4), Shape({1, 2, 3}, 4)},
     {Shape({}, 4), {}, Shape({}, 4)},
     {Shape({1, 2, 3}, 4), {1, 2, 3}, Shape({1, 2, 3}, 4)},
+    {{}, {1, 2, 3}, {1, 2, 3}},
+    {Shape({}, 4), {1, 2, 3}, Shape({1, 2, 3}, 4)},
+    {{}, Shape({1, 2, 3}, 4), Shape({1, 2, 3}, 4)},
+    {{2, 3}, {2}, {2, 3}},
+    {{2}, {2, 3}, {2, 3}},
+    {{1, 3}, {2}, {2, 3}},
+    {Shape({2, 1, 4}, 5), {1, 3}, Shape({2, 3, 4}, 5)},
+    {{2, 3}, Shape({1, 1, 4}, 5), Shape({2, 3, 4}, 5)},
   };
   for (const TestCase &tc : test_cases) {
     EXPECT_EQ(tc.expected, elementwise(tc.a, tc.b));
@@ -134,10 +142,10 @@ TEST_F(ShapeOpsTest, CheckElementwise) {
 TEST_F(ShapeOpsTest, CheckInvalidElementwise) {
   struct TestCase { Shape a, b; };
   const vector<TestCase> test_cases {
-    {{}, {1, 2, 3}},
-    {Shape({}, 4), {1, 2, 3}},
-    {{}, Shape({1, 2, 3}, 4)},
-    {Shape({}, 4), Shape({1, 2, 3}, 4)},
+    {{2}, {3}},
+    {{2, 3}, {3}},
+    {Shape({2}, 4), {3, 3}},
+    {Shape({}, 4), Shape({1, 2, 3}, 5)},
     {Shape({}, 4), Shape({}, 5)},
     {Shape({1, 2, 3}, 4), Shape({1, 2, 3}, 5)},
   };
@@ -324,6 +332,17 @@ TEST_F(ShapeOpsTest, CheckMatMul) {
   }
 }
 
+TEST_F(ShapeOpsTest, CheckMatMulTransposed) {
+  EXPECT_EQ(Shape({20, 30}), matmul({20, 10}, {10, 30}, false, false));
+  EXPECT_EQ(Shape({20, 30}), matmul({10, 20}, {10, 30}, true, false));
+  EXPECT_EQ(Shape({20, 30}), matmul({20, 10}, {30, 10}, false, true));
+  EXPECT_EQ(
+      Shape({20, 30}, 3), matmul(Shape({10, 20}, 3), {30, 10}, true, true));
+  EXPECT_THROW(matmul({20, 10}, {10, 30}, true, false), Error);
+  EXPECT_THROW(matmul({20, 10}, {10, 30}, false, true), Error);
+  EXPECT_THROW(matmul({10, 20, 2}, {10, 30}, true, false), Error);
+}
+
 TEST_F(ShapeOpsTest, CheckInvalidMatMul) {
   EXPECT_THROW(matmul({1, 1, 2}, {2}), Error);
   EXPECT_THROW(matmul({}, {1, 1, 2}), Error);
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <random>
 #include <vector>
 #include <gtest/gtest.h>
 #include <primitiv/error.h>
@@ -754,6 +756,36 @@ TEST_F(TensorBackwardTest, CheckELU) {
   }
 }
 
+TEST_F(TensorBackwardTest, CheckDropout) {
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_constant(Shape({7, 5}, 2), 1);
+    const Tensor gy = dev->new_tensor_by_vector(
+        x.shape(), make_iota_vector(70, 1));
+    Tensor mask;
+    const Tensor y = dev->dropout_fw(x, .5, mask);
+    const vector<float> y_val = y.to_vector();
+    const vector<float> gy_val = gy.to_vector();
+    vector<float> gx_val(70);
+    for (std::size_t i = 0; i < 70; ++i) {
+      gx_val[i] = y_val[i] * gy_val[i];
+    }
+
+    // Overwrites the invalid gradient.
+    Tensor gx1;
+    dev->dropout_bw(gy, mask, .5, gx1);
+    EXPECT_TRUE(vector_match(gx_val, gx1.to_vector()));
+
+    // Accumulates to the valid gradient.
+    Tensor gx2 = dev->new_tensor_by_constant(x.shape(), 1);
+    dev->dropout_bw(gy, mask, .5, gx2);
+    for (float &v : gx_val) v += 1;
+    EXPECT_TRUE(vector_match(gx_val, gx2.to_vector()));
+
+    Tensor gx3 = dev->new_tensor_by_constant({7, 5}, 0);
+    EXPECT_THROW(dev->dropout_bw(gy, mask, .5, gx3), Error);
+  }
+}
+
 TEST_F(TensorBackwardTest, CheckMaxDims) {
   const vector<float> x_data = {
     0, 1, 2, 6, 7, 8, 3, 4, 5, -3, -4, -5, 0, -1, -2, -6, -7, -8,
@@ -1389,6 +1421,58 @@ TEST_F(TensorBackwardTest, CheckPowN1) {
   }
 }
 
+TEST_F(TensorBackwardTest, CheckArithmeticDimsBroadcast) {
+  struct TestCase { Shape a, b, y; };
+  const vector<TestCase> test_cases {
+    {{2, 3}, {2}, {2, 3}},
+    {{1, 3}, Shape({2}, 2), Shape({2, 3}, 2)},
+    {Shape({2, 1, 4}, 3), {1, 3}, Shape({2, 3, 4}, 3)},
+    {{}, Shape({2, 3}, 2), Shape({2, 3}, 2)},
+  };
+  for (Device *dev : devices) {
+    // Gradients of broadcasted operands are summed up in different orders.
+    const std::uint32_t ulps
+      = dev->type() == Device::DeviceType::CUDA16 ? 8192 : 64;
+    for (const TestCase &tc : test_cases) {
+      const Tensor a = dev->new_tensor_by_vector(
+          tc.a, make_iota_vector(tc.a.size(), 1));
+      const Tensor b = dev->new_tensor_by_vector(
+          tc.b, make_iota_vector(tc.b.size(), 2));
+      Tensor ea = a, eb = b;
+      for (std::uint32_t d = 0; d < tc.y.depth(); ++d) {
+        if (ea.shape()[d] != tc.y[d]) ea = dev->broadcast_fw(ea, d, tc.y[d]);
+        if (eb.shape()[d] != tc.y[d]) eb = dev->broadcast_fw(eb, d, tc.y[d]);
+      }
+      const Tensor gy = dev->new_tensor_by_vector(
+          tc.y, make_iota_vector(tc.y.size(), 1));
+
+#define TEST_BW(name) { \
+  const Tensor y = dev->name##_fw(a, b); \
+  Tensor ga = dev->new_tensor_by_constant(a.shape(), 1); \
+  Tensor gb = dev->new_tensor_by_constant(b.shape(), 1); \
+  dev->name##_bw(a, b, y, gy, ga, gb); \
+  Tensor ega = dev->new_tensor_by_constant(ea.shape(), 0); \
+  Tensor egb = dev->new_tensor_by_constant(eb.shape(), 0); \
+  dev->name##_bw(ea, eb, y, gy, ega, egb); \
+  for (std::uint32_t d = 0; d < tc.y.depth(); ++d) { \
+    if (a.shape()[d] != tc.y[d]) ega = dev->sum_fw(ega, d); \
+    if (b.shape()[d] != tc.y[d]) egb = dev->sum_fw(egb, d); \
+  } \
+  ega = dev->add_const_fw(ega, 1); \
+  egb = dev->add_const_fw(egb, 1); \
+  EXPECT_TRUE(vector_match_ulps(ega.to_vector(), ga.to_vector(), ulps)); \
+  EXPECT_TRUE(vector_match_ulps(egb.to_vector(), gb.to_vector(), ulps)); \
+}
+      TEST_BW(add);
+      TEST_BW(subtract);
+      TEST_BW(multiply);
+      TEST_BW(divide);
+      TEST_BW(pow);
+#undef TEST_BW
+    }
+  }
+}
+
 TEST_F(TensorBackwardTest, CheckMatMul11) {
   for (Device *dev : devices) {
     const Tensor a = dev->new_tensor_by_vector({2, 2}, {1, 2, 3, 4});
@@ -1460,6 +1544,54 @@ TEST_F(TensorBackwardTest, CheckMatMulN1) {
   }
 }
 
+TEST_F(TensorBackwardTest, CheckMatMulTransposed) {
+  struct TestCase {
+    Shape a_shape, b_shape;
+    bool transpose_a, transpose_b;
+  };
+  const vector<TestCase> test_cases {
+    {{4, 3}, {4, 5}, true, false},
+    {{3, 4}, {5, 4}, false, true},
+    {{4, 3}, {5, 4}, true, true},
+    {Shape({4, 3}, 2), {4, 5}, true, false},
+    {{3, 4}, Shape({5, 4}, 2), false, true},
+    {Shape({4, 3}, 2), Shape({5, 4}, 2), true, true},
+  };
+  for (Device *dev : devices) {
+    for (const TestCase &tc : test_cases) {
+      vector<float> a_data(tc.a_shape.size()), b_data(tc.b_shape.size());
+      for (std::uint32_t i = 0; i < a_data.size(); ++i) a_data[i] = i % 7 - 3;
+      for (std::uint32_t i = 0; i < b_data.size(); ++i) b_data[i] = i % 5 - 2;
+      const Tensor a = dev->new_tensor_by_vector(tc.a_shape, a_data);
+      const Tensor b = dev->new_tensor_by_vector(tc.b_shape, b_data);
+      const Tensor y = dev->matmul_fw(a, b, tc.transpose_a, tc.transpose_b);
+      vector<float> gy_data(y.shape().size());
+      for (std::uint32_t i = 0; i < gy_data.size(); ++i) gy_data[i] = i % 3 - 1;
+      const Tensor gy = dev->new_tensor_by_vector(y.shape(), gy_data);
+      Tensor ga = dev->new_tensor_by_constant(a.shape(), 1);
+      Tensor gb = dev->new_tensor_by_constant(b.shape(), 1);
+      dev->matmul_bw(
+          a, b, y, gy, tc.transpose_a, tc.transpose_b, ga, gb);
+
+      // Calculates expected gradients with explicit transpositions.
+      const Tensor at = tc.transpose_a ? dev->transpose_fw(a) : a;
+      const Tensor bt = tc.transpose_b ? dev->transpose_fw(b) : b;
+      Tensor gat = dev->new_tensor_by_constant(at.shape(), 0);
+      Tensor gbt = dev->new_tensor_by_constant(bt.shape(), 0);
+      dev->matmul_bw(at, bt, y, gy, gat, gbt);
+      Tensor ga_expected = dev->new_tensor_by_constant(a.shape(), 1);
+      Tensor gb_expected = dev->new_tensor_by_constant(b.shape(), 1);
+      if (tc.transpose_a) dev->transpose_bw(a, at, gat, ga_expected);
+      else ga_expected += gat;
+      if (tc.transpose_b) dev->transpose_bw(b, bt, gbt, gb_expected);
+      else gb_expected += gbt;
+
+      EXPECT_TRUE(vector_match(ga_expected.to_vector(), ga.to_vector()));
+      EXPECT_TRUE(vector_match(gb_expected.to_vector(), gb.to_vector()));
+    }
+  }
+}
+
 TEST_F(TensorBackwardTest, CheckBatchPickNN) {
   const vector<float> a_data {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
   struct TestCase {
@@ -2740,4 +2872,72 @@ TEST_F(TensorBackwardTest, CheckMaxPool2D_VGG16ThirdLayer) {
   } IGNORE_NOT_IMPLEMENTED
 }
 
+TEST_F(TensorBackwardTest, CheckOverwriteGradients) {
+  const Shape sx({2, 2}, 3);
+  const Shape sw({2, 2});
+  const vector<float> x_data {1, 2, 3, 4, -1, -2, -3, -4, .5, 1, 1.5, 2};
+  const vector<float> w_data {1, -1, 2, -2};
+  const vector<float> gy_data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) try {
+    const Tensor x = dev->new_tensor_by_vector(sx, x_data);
+    const Tensor w = dev->new_tensor_by_vector(sw, w_data);
+    const Tensor gy = dev->new_tensor_by_vector(sx, gy_data);
+
+    // Invalid gradients should be treated as 0.
+    {
+      const Tensor y = dev->tanh_fw(x);
+      Tensor gx0 = dev->new_tensor_by_constant(sx, 0);
+      Tensor gx1;
+      dev->tanh_bw(x, y, gy, gx0);
+      dev->tanh_bw(x, y, gy, gx1);
+      ASSERT_TRUE(gx1.valid());
+      EXPECT_EQ(sx, gx1.shape());
+      EXPECT_TRUE(vector_match(gx0.to_vector(), gx1.to_vector()));
+    }
+    {
+      const Tensor y = dev->elu_fw(x, .5);
+      Tensor gx0 = dev->new_tensor_by_constant(sx, 0);
+      Tensor gx1;
+      dev->elu_bw(x, y, gy, .5, gx0);
+      dev->elu_bw(x, y, gy, .5, gx1);
+      ASSERT_TRUE(gx1.valid());
+      EXPECT_EQ(sx, gx1.shape());
+      EXPECT_TRUE(vector_match(gx0.to_vector(), gx1.to_vector()));
+    }
+    {
+      const Tensor y = dev->multiply_fw(x, w);
+      Tensor gx0 = dev->new_tensor_by_constant(sx, 0);
+      Tensor gw0 = dev->new_tensor_by_constant(sw, 0);
+      Tensor gx1, gw1;
+      dev->multiply_bw(x, w, y, gy, gx0, gw0);
+      dev->multiply_bw(x, w, y, gy, gx1, gw1);
+      ASSERT_TRUE(gx1.valid());
+      ASSERT_TRUE(gw1.valid());
+      EXPECT_EQ(sx, gx1.shape());
+      EXPECT_EQ(sw, gw1.shape());
+      EXPECT_TRUE(vector_match(gx0.to_vector(), gx1.to_vector()));
+      EXPECT_TRUE(vector_match(gw0.to_vector(), gw1.to_vector()));
+    }
+    {
+      const Tensor y = dev->matmul_fw(w, x);
+      Tensor gw0 = dev->new_tensor_by_constant(sw, 0);
+      Tensor gx0 = dev->new_tensor_by_constant(sx, 0);
+      Tensor gw1, gx1;
+      dev->matmul_bw(w, x, y, gy, gw0, gx0);
+      dev->matmul_bw(w, x, y, gy, gw1, gx1);
+      ASSERT_TRUE(gw1.valid());
+      ASSERT_TRUE(gx1.valid());
+      EXPECT_TRUE(vector_match(gw0.to_vector(), gw1.to_vector()));
+      EXPECT_TRUE(vector_match(gx0.to_vector(), gx1.to_vector()));
+    }
+
+    // Functions without argument values require valid gradients.
+    {
+      Tensor gx;
+      EXPECT_THROW(dev->slice_bw(gy, 0, 0, gx), Error);
+      EXPECT_THROW(dev->batch_slice_bw(gy, 0, gx), Error);
+    }
+  } IGNORE_NOT_IMPLEMENTED
+}
+
 }  // namespace primitiv
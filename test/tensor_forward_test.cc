@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <random>
 #include <utility>
 #include <vector>
 #include <gtest/gtest.h>
@@ -50,6 +51,28 @@ TEST_F(TensorForwardTest, CheckInputByVector) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckInputByMovedVector) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    vector<float> moved = data;
+    const Tensor y = input<Tensor>(Shape({2, 2}, 3), std::move(moved), *dev);
+    EXPECT_EQ(Shape({2, 2}, 3), y.shape());
+    EXPECT_EQ(dev, &y.device());
+    EXPECT_TRUE(vector_match(data, y.to_vector()));
+  }
+}
+
+TEST_F(TensorForwardTest, CheckInputByBorrowedArray) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    const Tensor y = borrowed_input<Tensor>(
+        Shape({2, 2}, 3), data.data(), *dev);
+    EXPECT_EQ(Shape({2, 2}, 3), y.shape());
+    EXPECT_EQ(dev, &y.device());
+    EXPECT_TRUE(vector_match(data, y.to_vector()));
+  }
+}
+
 TEST_F(TensorForwardTest, CheckInputByParameter) {
   vector<float> data {1, 2, 3, 4};
   for (Device *dev : devices) {
@@ -1524,6 +1547,97 @@ TEST_F(TensorForwardTest, CheckInvalidArithmeticOps) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckArithmeticDimsBroadcast) {
+  const vector<float> a_data {1, 2, 3, 4, 5, 6};
+  const vector<float> b_data {10, 20};
+  const vector<float> y_data {11, 22, 13, 24, 15, 26};
+  for (Device *dev : devices) {
+    const Tensor a = dev->new_tensor_by_vector({2, 3}, a_data);
+    const Tensor b = dev->new_tensor_by_vector({2}, b_data);
+    const Tensor y1 = a + b;
+    EXPECT_EQ(Shape({2, 3}), y1.shape());
+    EXPECT_TRUE(vector_match(y_data, y1.to_vector()));
+    const Tensor y2 = b + a;
+    EXPECT_EQ(Shape({2, 3}), y2.shape());
+    EXPECT_TRUE(vector_match(y_data, y2.to_vector()));
+  }
+}
+
+TEST_F(TensorForwardTest, CheckArithmeticDimsBroadcastMatchesExplicit) {
+  struct TestCase { Shape a, b, y; };
+  const vector<TestCase> test_cases {
+    {{2, 3}, {2}, {2, 3}},
+    {{1, 3}, Shape({2}, 2), Shape({2, 3}, 2)},
+    {Shape({2, 1, 4}, 3), {1, 3}, Shape({2, 3, 4}, 3)},
+    {{}, Shape({2, 3}, 2), Shape({2, 3}, 2)},
+  };
+  for (Device *dev : devices) {
+    for (const TestCase &tc : test_cases) {
+      const Tensor a = dev->new_tensor_by_vector(
+          tc.a, make_iota_vector(tc.a.size(), 1));
+      const Tensor b = dev->new_tensor_by_vector(
+          tc.b, make_iota_vector(tc.b.size(), 2));
+      Tensor ea = a, eb = b;
+      for (std::uint32_t d = 0; d < tc.y.depth(); ++d) {
+        if (ea.shape()[d] != tc.y[d]) ea = dev->broadcast_fw(ea, d, tc.y[d]);
+        if (eb.shape()[d] != tc.y[d]) eb = dev->broadcast_fw(eb, d, tc.y[d]);
+      }
+      const std::uint32_t ulps = get_default_ulps(*dev);
+      const Tensor ys[] {
+        dev->add_fw(a, b), dev->subtract_fw(a, b), dev->multiply_fw(a, b),
+        dev->divide_fw(a, b), dev->pow_fw(a, b),
+      };
+      const Tensor expected[] {
+        dev->add_fw(ea, eb), dev->subtract_fw(ea, eb),
+        dev->multiply_fw(ea, eb), dev->divide_fw(ea, eb), dev->pow_fw(ea, eb),
+      };
+      for (std::uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(tc.y, ys[i].shape());
+        EXPECT_TRUE(vector_match_ulps(
+              expected[i].to_vector(), ys[i].to_vector(), ulps));
+      }
+    }
+  }
+}
+
+TEST_F(TensorForwardTest, CheckInplaceElementwise) {
+  const vector<float> x_data {1, 2, 3, 4};
+  const vector<float> b_data {10, 20};
+  for (Device *dev : devices) {
+    const std::uint32_t ulps = get_default_ulps(*dev);
+    const Tensor x = dev->new_tensor_by_vector(Shape({2}, 2), x_data);
+    const Tensor b = dev->new_tensor_by_vector({2}, b_data);
+    const vector<float> tanh_data = dev->tanh_fw(x).to_vector();
+    const vector<float> add_const_data = dev->add_const_fw(x, 3).to_vector();
+    const vector<float> add_data = dev->add_fw(x, b).to_vector();
+    {
+      Tensor y = dev->copy_tensor(x);
+      y = dev->tanh_fw(std::move(y));
+      EXPECT_TRUE(vector_match_ulps(tanh_data, y.to_vector(), ulps));
+      y = dev->copy_tensor(x);
+      y = dev->add_const_fw(std::move(y), 3);
+      EXPECT_TRUE(vector_match_ulps(add_const_data, y.to_vector(), ulps));
+      y = dev->copy_tensor(x);
+      y = dev->add_fw(std::move(y), b);
+      EXPECT_TRUE(vector_match_ulps(add_data, y.to_vector(), ulps));
+    }
+    {
+      // Shared tensors are not overwritten.
+      Tensor y = x;
+      y = dev->tanh_fw(std::move(y));
+      EXPECT_TRUE(vector_match(x_data, x.to_vector()));
+      EXPECT_TRUE(vector_match_ulps(tanh_data, y.to_vector(), ulps));
+    }
+    {
+      // Tensors with a different shape from the result are not overwritten.
+      Tensor y = dev->copy_tensor(b);
+      y = dev->add_fw(std::move(y), x);
+      EXPECT_EQ(Shape({2}, 2), y.shape());
+      EXPECT_TRUE(vector_match_ulps(add_data, y.to_vector(), ulps));
+    }
+  }
+}
+
 TEST_F(TensorForwardTest, CheckTranspose11) {
   for (Device *dev : devices) {
     const vector<float> x_data {42};
@@ -1695,6 +1809,37 @@ TEST_F(TensorForwardTest, CheckMatMulLarge) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckMatMulTransposed) {
+  struct TestCase {
+    Shape a_shape, b_shape;
+    bool transpose_a, transpose_b;
+  };
+  const vector<TestCase> test_cases {
+    {{3, 4}, {4, 5}, false, false},
+    {{4, 3}, {4, 5}, true, false},
+    {{3, 4}, {5, 4}, false, true},
+    {{4, 3}, {5, 4}, true, true},
+    {Shape({4, 3}, 2), {4, 5}, true, false},
+    {{3, 4}, Shape({5, 4}, 2), false, true},
+    {Shape({4, 3}, 2), Shape({5, 4}, 2), true, true},
+  };
+  for (Device *dev : devices) {
+    for (const TestCase &tc : test_cases) {
+      vector<float> a_data(tc.a_shape.size()), b_data(tc.b_shape.size());
+      for (std::uint32_t i = 0; i < a_data.size(); ++i) a_data[i] = i % 7 - 3;
+      for (std::uint32_t i = 0; i < b_data.size(); ++i) b_data[i] = i % 5 - 2;
+      const Tensor a = dev->new_tensor_by_vector(tc.a_shape, a_data);
+      const Tensor b = dev->new_tensor_by_vector(tc.b_shape, b_data);
+      const Tensor y = dev->matmul_fw(a, b, tc.transpose_a, tc.transpose_b);
+      const Tensor expected = matmul(
+          tc.transpose_a ? transpose(a) : a,
+          tc.transpose_b ? transpose(b) : b);
+      EXPECT_EQ(expected.shape(), y.shape());
+      EXPECT_TRUE(vector_match(expected.to_vector(), y.to_vector()));
+    }
+  }
+}
+
 TEST_F(TensorForwardTest, CheckInvalidMatMul) {
   struct TestCase {
     Shape a_shape, b_shape;
@@ -2076,6 +2221,52 @@ TEST_F(TensorForwardTest, CheckELU) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckDropout) {
+  const vector<float> x_data = make_iota_vector(70, 1);
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({7, 5}, 2), x_data);
+    for (const float rate : {0., .25, .5, .75, 1.}) {
+      Tensor mask;
+      const Tensor y = dev->dropout_fw(x, rate, mask);
+      EXPECT_EQ(x.shape(), y.shape());
+      EXPECT_TRUE(mask.valid());
+      const vector<float> y_val = y.to_vector();
+      const float k = rate < 1 ? 1 / (1 - rate) : 0;
+      for (std::size_t i = 0; i < x_data.size(); ++i) {
+        if (rate == 0) {
+          EXPECT_FLOAT_EQ(x_data[i], y_val[i]);
+        } else if (y_val[i] != 0) {
+          EXPECT_FLOAT_EQ(k * x_data[i], y_val[i]);
+        }
+      }
+      // Applies the same mask again.
+      const Tensor mask_copy = mask;
+      const Tensor y2 = dev->dropout_fw(x, rate, mask);
+      EXPECT_TRUE(vector_match(y_val, y2.to_vector()));
+      EXPECT_TRUE(vector_match(mask_copy.to_vector(), mask.to_vector()));
+    }
+    if (dev->type() == Device::DeviceType::NAIVE ||
+        dev->type() == Device::DeviceType::EIGEN) {
+      // Masks are stored as bits.
+      Tensor mask;
+      dev->dropout_fw(x, .5, mask);
+      EXPECT_EQ(Shape({3}), mask.shape());
+    }
+    for (const float rate : {-.1f, 1.1f}) {
+      Tensor mask;
+      EXPECT_THROW(dev->dropout_fw(x, rate, mask), Error);
+    }
+    {
+      Tensor mask = dev->new_tensor_by_constant({1}, 0);
+      EXPECT_THROW(dev->dropout_fw(x, .5, mask), Error);
+    }
+    EXPECT_TRUE(vector_match(x_data, dropout(x, .5, false).to_vector()));
+    EXPECT_TRUE(vector_match(x_data, dropout(x, 0, true).to_vector()));
+    EXPECT_TRUE(vector_match(
+          vector<float>(70, 0), dropout(x, 1, true).to_vector()));
+  }
+}
+
 TEST_F(TensorForwardTest, CheckMaxDims) {
   struct TestCase {
     std::uint32_t dim;
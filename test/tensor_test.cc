@@ -90,6 +90,78 @@ TEST_F(TensorTest, CheckNewMatrixMinibatchWithData) {
   }
 }
 
+TEST_F(TensorTest, CheckNewMatrixWithMovedData) {
+  for (Device *dev : devices) {
+    const vector<float> data {1, 2, 3, 4, 5, 6};
+    vector<float> moved = data;
+    const Tensor x = dev->new_tensor_by_vector({2, 3}, std::move(moved));
+    EXPECT_TRUE(x.valid());
+    EXPECT_EQ(dev, &x.device());
+    EXPECT_EQ(Shape({2, 3}), x.shape());
+    EXPECT_TRUE(vector_match(data, x.to_vector()));
+    EXPECT_THROW(
+        dev->new_tensor_by_vector({2, 3}, vector<float> {1, 2, 3}), Error);
+  }
+}
+
+TEST_F(TensorTest, CheckNewMatrixWithBorrowedData) {
+  for (Device *dev : devices) {
+    const vector<float> data {1, 2, 3, 4, 5, 6};
+    const Tensor x = dev->new_tensor_by_borrowed_array({2, 3}, data.data());
+    EXPECT_TRUE(x.valid());
+    EXPECT_EQ(dev, &x.device());
+    EXPECT_EQ(Shape({2, 3}), x.shape());
+    EXPECT_TRUE(vector_match(data, x.to_vector()));
+  }
+}
+
+TEST_F(TensorTest, CheckBorrowedDataAndInplaceOps) {
+  for (Device *dev : devices) {
+    const vector<float> data {1, 2, 3, 4, 5, 6};
+    vector<float> borrowed = data;
+    {
+      Tensor x = dev->new_tensor_by_borrowed_array({2, 3}, borrowed.data());
+      x.inplace_multiply_const(2);
+      EXPECT_TRUE(
+          vector_match(vector<float> {2, 4, 6, 8, 10, 12}, x.to_vector()));
+    }
+    {
+      Tensor x = dev->new_tensor_by_borrowed_array({2, 3}, borrowed.data());
+      x.reset(0);
+      EXPECT_TRUE(vector_match(vector<float>(6, 0), x.to_vector()));
+    }
+    {
+      const Tensor x = dev->new_tensor_by_borrowed_array(
+          {2, 3}, borrowed.data());
+      Tensor y = x.reshape({6});
+      y.inplace_add(x.flatten());
+      EXPECT_TRUE(
+          vector_match(vector<float> {2, 4, 6, 8, 10, 12}, y.to_vector()));
+      EXPECT_TRUE(vector_match(data, x.to_vector()));
+    }
+    // The borrowed array is never modified.
+    EXPECT_EQ(data, borrowed);
+  }
+}
+
+TEST_F(TensorTest, CheckIsUnique) {
+  for (Device *dev : devices) {
+    const vector<float> data {1, 2, 3, 4, 5, 6};
+    EXPECT_FALSE(Tensor().is_unique());
+    Tensor x = dev->new_tensor_by_vector({2, 3}, data);
+    EXPECT_TRUE(x.is_unique());
+    {
+      const Tensor copied = x;
+      EXPECT_FALSE(x.is_unique());
+      EXPECT_FALSE(copied.is_unique());
+    }
+    EXPECT_TRUE(x.is_unique());
+    const Tensor borrowed = dev->new_tensor_by_borrowed_array(
+        {2, 3}, data.data());
+    EXPECT_FALSE(borrowed.is_unique());
+  }
+}
+
 TEST_F(TensorTest, CheckMoveValidToNew) {
   for (Device *dev : devices) {
     Tensor tmp = dev->new_tensor_by_vector(Shape({2}, 3), {1, 2, 3, 4, 5, 6});
@@ -649,6 +721,139 @@ TEST_F(TensorTest, CheckInvalidInplaceOps) {
   }
 }
 
+TEST_F(TensorTest, CheckSliceAndInplaceOps) {
+  const vector<float> x_data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const vector<float> y_data {3, 4, 5, 6};
+  const vector<float> y2_data {6, 8, 10, 12};
+  const vector<float> x2_data {2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24};
+
+  for (Device *dev : devices) {
+    {
+      // Slice of the highest axis.
+      Tensor x = dev->new_tensor_by_vector({2, 6}, x_data);
+      Tensor y = dev->slice_fw(x, 1, 1, 3);
+      EXPECT_EQ(Shape({2, 2}), y.shape());
+      EXPECT_TRUE(vector_match(y_data, y.to_vector()));
+
+      y *= 2;
+      EXPECT_TRUE(vector_match(y2_data, y.to_vector()));
+      EXPECT_TRUE(vector_match(x_data, x.to_vector()));
+
+      x *= 2;
+      EXPECT_TRUE(vector_match(x2_data, x.to_vector()));
+      EXPECT_TRUE(vector_match(y2_data, y.to_vector()));
+    }
+    {
+      // Slice of the minibatch.
+      Tensor x = dev->new_tensor_by_vector(Shape({2}, 6), x_data);
+      Tensor y = dev->batch_slice_fw(x, 1, 3);
+      EXPECT_EQ(Shape({2}, 2), y.shape());
+      EXPECT_TRUE(vector_match(y_data, y.to_vector()));
+
+      x *= 2;
+      EXPECT_TRUE(vector_match(x2_data, x.to_vector()));
+      EXPECT_TRUE(vector_match(y_data, y.to_vector()));
+
+      y *= 2;
+      EXPECT_TRUE(vector_match(y2_data, y.to_vector()));
+      EXPECT_TRUE(vector_match(x2_data, x.to_vector()));
+    }
+    {
+      // Slice outlives the original tensor.
+      Tensor y;
+      {
+        const Tensor x = dev->new_tensor_by_vector({2, 6}, x_data);
+        y = dev->slice_fw(x, 1, 1, 3);
+      }
+      EXPECT_TRUE(vector_match(y_data, y.to_vector()));
+      y *= 2;
+      EXPECT_TRUE(vector_match(y2_data, y.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckToArray) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({2, 3}, 2), data);
+    vector<float> values(data.size());
+    x.to_array(values.data());
+    EXPECT_TRUE(vector_match(data, values));
+  }
+}
+
+TEST_F(TensorTest, CheckHostData) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({2, 3}, 2), data);
+    const auto group = static_cast<std::uint32_t>(dev->type())
+      & static_cast<std::uint32_t>(Device::DeviceType::GROUP_FILTER);
+    if (group == static_cast<std::uint32_t>(Device::DeviceType::GROUP_CPU)) {
+      const float *values = x.host_data();
+      EXPECT_TRUE(
+          vector_match(data, vector<float>(values, values + data.size())));
+
+      // The pointer refers to the internal memory.
+      const Tensor y = x.flatten();
+      EXPECT_EQ(values, y.host_data());
+    } else {
+      EXPECT_THROW(x.host_data(), Error);
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckShareTensor) {
+  const vector<float> data {1, 2, 3, 4, 5, 6};
+  const auto on_host = [](const Device &dev) {
+    return (static_cast<std::uint32_t>(dev.type())
+        & static_cast<std::uint32_t>(Device::DeviceType::GROUP_FILTER))
+      == static_cast<std::uint32_t>(Device::DeviceType::GROUP_CPU);
+  };
+  for (Device *dev : devices) {
+    for (Device *dev2 : devices) {
+      const Tensor x = dev->new_tensor_by_vector({2, 3}, data);
+      Tensor y = dev2->share_tensor(x);
+      EXPECT_EQ(dev2, &y.device());
+      EXPECT_EQ(Shape({2, 3}), y.shape());
+      EXPECT_TRUE(vector_match(data, y.to_vector()));
+      if (dev != dev2 && on_host(*dev) && on_host(*dev2)) {
+        EXPECT_EQ(x.host_data(), y.host_data());
+      }
+
+      // Updating the shared tensor does not affect the source.
+      y *= 2;
+      EXPECT_TRUE(
+          vector_match(vector<float> {2, 4, 6, 8, 10, 12}, y.to_vector()));
+      EXPECT_TRUE(vector_match(data, x.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckArgMaxMinToArray) {
+  const vector<float> data = {
+    0, 1, 2, 6, 7, 8, 3, 4, 5, -3, -4, -5, 0, -1, -2, -6, -7, -8,
+  };
+  const vector<vector<std::uint32_t>> expected_max = {
+    {2, 2, 2, 0, 0, 0},
+    {1, 1, 1, 1, 1, 1},
+  };
+  const vector<vector<std::uint32_t>> expected_min = {
+    {0, 0, 0, 2, 2, 2},
+    {0, 0, 0, 2, 2, 2},
+  };
+
+  for (Device *dev : devices) {
+    const Tensor a = dev->new_tensor_by_vector(Shape({3, 3}, 2), data);
+    for (const std::uint32_t i : {0u, 1u}) {
+      vector<std::uint32_t> ids(6);
+      a.argmax(i, ids.data());
+      EXPECT_TRUE(vector_match(expected_max[i], ids));
+      a.argmin(i, ids.data());
+      EXPECT_TRUE(vector_match(expected_min[i], ids));
+    }
+  }
+}
+
 TEST_F(TensorTest, CheckArgMaxDims) {
   const vector<float> data = {
     0, 1, 2, 6, 7, 8, 3, 4, 5, -3, -4, -5, 0, -1, -2, -6, -7, -8,